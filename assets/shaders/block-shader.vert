@@ -1,23 +1,72 @@
 #version 330 core
 
+// outside the vertex input branches: includes are expanded once regardless of #if, so a branch must not be the first to include it
+#include "include/face-directions.glsl"
+
+#if defined(FEATURE_FACE_PULLING)
+#include "include/face-record.glsl" // no vertex attributes, the face is pulled by gl_VertexID
+#elif defined(FEATURE_PACKED_VERTICES)
+layout (location = 0) in uvec2 aPacked;
+
+#include "include/packed-vertex.glsl"
+#else
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
+layout (location = 1) in vec3 aTexCoord; // u, v, texture array layer (0 for two component texcoords)
 layout (location = 2) in vec3 aNormal; //normal vector perpendicular to block face
+#endif
 
-out vec2 TexCoord;
+out vec3 TexCoord;
 
 out vec3 FragPos;
+out vec3 WorldPos;
 out vec3 Normal;
+#ifdef FEATURE_FACE_PULLING
+out float Light; // light of the face record
+#endif
 
+#ifdef FEATURE_INDIRECT_DRAW
+#include "include/draw-data.glsl"
+
+layout (location = 4) in uint aDrawID; // per instance, each command's base instance is the index of its draw
+flat out uint DrawID;
+#else
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+#endif
+
+#include "include/frame-data.glsl"
+
+// bit identical to depth-prepass.vert, the lit pass tests against the pre-pass depth with GL_EQUAL
+invariant gl_Position;
+
+#ifdef FEATURE_TEXTURE_ARRAY
+uniform usamplerBuffer layerFrames; // layer -> layer of its current animation frame
+#endif
 
 void main()
 {
+#if defined(FEATURE_FACE_PULLING)
+  uvec2 record = FetchFaceRecord();
+  vec3 aPos = FacePosition(record);
+  vec3 aTexCoord = FaceTexCoord(record);
+  vec3 aNormal = FaceNormal(record);
+  Light = FaceLight(record);
+#elif defined(FEATURE_PACKED_VERTICES)
+  vec3 aPos = UnpackPosition(aPacked);
+  vec3 aTexCoord = UnpackTexCoord(aPacked);
+  vec3 aNormal = UnpackNormal(aPacked);
+#endif
+#ifdef FEATURE_INDIRECT_DRAW
+  mat4 model = draws[aDrawID].model;
+  DrawID = aDrawID;
+#endif
+
   gl_Position = projection * view * model * vec4(aPos, 1.0);
-  FragPos = vec3(view * model * vec4(aPos, 1.0)); // fragment position in world space
+  FragPos = vec3(view * model * vec4(aPos, 1.0)); // fragment position in view space
+  WorldPos = vec3(model * vec4(aPos, 1.0)); // fragment position in world space, for shadow lookups
   TexCoord = aTexCoord;
+#ifdef FEATURE_TEXTURE_ARRAY
+  TexCoord.z = float(texelFetch(layerFrames, int(aTexCoord.z)).r);
+#endif
 
   // convert the normals to world space using inverse transposed model matrix
   // we can not use the normal model matrix since its a 4x4 and our normals are vec3
@@ -0,0 +1,41 @@
+#version 330 core
+
+// outside the vertex input branches: includes are expanded once regardless of #if, so a branch must not be the first to include it
+#include "include/face-directions.glsl"
+
+#if defined(FEATURE_FACE_PULLING)
+#include "include/face-record.glsl" // no vertex attributes, the face is pulled by gl_VertexID
+#elif defined(FEATURE_PACKED_VERTICES)
+layout (location = 0) in uvec2 aPacked;
+
+#include "include/packed-vertex.glsl"
+#else
+layout (location = 0) in vec3 aPos;
+#endif
+
+#ifdef FEATURE_INDIRECT_DRAW
+#include "include/draw-data.glsl"
+
+layout (location = 4) in uint aDrawID; // per instance, each command's base instance is the index of its draw
+#else
+uniform mat4 model;
+#endif
+
+#include "include/frame-data.glsl"
+
+// the lit pass tests against this depth with GL_EQUAL, so both compute it the same way as block-shader.vert
+invariant gl_Position;
+
+void main()
+{
+#if defined(FEATURE_FACE_PULLING)
+  vec3 aPos = FacePosition(FetchFaceRecord());
+#elif defined(FEATURE_PACKED_VERTICES)
+  vec3 aPos = UnpackPosition(aPacked);
+#endif
+#ifdef FEATURE_INDIRECT_DRAW
+  mat4 model = draws[aDrawID].model;
+#endif
+
+  gl_Position = projection * view * model * vec4(aPos, 1.0);
+}
\ No newline at end of file
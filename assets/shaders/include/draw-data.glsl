@@ -0,0 +1,19 @@
+// per draw data of the indirect path, laid out to match DrawData in IndirectDrawer.h (std430)
+// indexed with the draw id, every multi draw command starts its single instance at the index of its draw
+
+struct DrawData {
+  mat4 model; // camera relative
+  int firstLightIndex;
+  int dirLightCount;
+  int pointLightCount;
+  int spotLightCount;
+};
+
+layout(std430, binding = 0) readonly buffer DrawBuffer {
+  DrawData draws[];
+};
+
+// light indices of all draws, each draw's directional, point and spot lights follow each other from firstLightIndex
+layout(std430, binding = 1) readonly buffer LightIndexBuffer {
+  int lightIndices[];
+};
\ No newline at end of file
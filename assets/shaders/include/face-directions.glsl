@@ -0,0 +1,7 @@
+// face directions in PackedVertex::Direction order: +X, -X, +Y, -Y, +Z, -Z
+
+const vec3 FACE_NORMALS[6] = vec3[6](
+  vec3(1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+  vec3(0.0, 1.0, 0.0), vec3(0.0, -1.0, 0.0),
+  vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0)
+);
\ No newline at end of file
@@ -0,0 +1,54 @@
+// vertex pulling of the 8 byte FaceRecord format, see FaceRecord.h
+//   x: cell x, y, z as 10 bit integers, offset by 512
+//   y: texture array layer in bits 0-11, face direction in bits 12-14, light in bits 16-23
+// every face is drawn as 6 vertices without attributes, gl_VertexID / 6 is the record and gl_VertexID % 6 the corner
+
+// FACE_NORMALS comes from face-directions.glsl, the including shader includes it outside of its #if branches
+
+uniform usamplerBuffer faceRecords; // RG32UI view of the arena page holding the records
+
+// corners relative to the cell center per direction: bottom left, bottom right, top right, top left,
+// wound clockwise seen from outside like the vertex meshes
+const vec3 FACE_CORNERS[24] = vec3[24](
+  vec3(0.5, -0.5, -0.5), vec3(0.5, -0.5, 0.5), vec3(0.5, 0.5, 0.5), vec3(0.5, 0.5, -0.5),          // +X
+  vec3(-0.5, -0.5, 0.5), vec3(-0.5, -0.5, -0.5), vec3(-0.5, 0.5, -0.5), vec3(-0.5, 0.5, 0.5),      // -X
+  vec3(-0.5, 0.5, -0.5), vec3(0.5, 0.5, -0.5), vec3(0.5, 0.5, 0.5), vec3(-0.5, 0.5, 0.5),          // +Y
+  vec3(-0.5, -0.5, 0.5), vec3(0.5, -0.5, 0.5), vec3(0.5, -0.5, -0.5), vec3(-0.5, -0.5, -0.5),      // -Y
+  vec3(0.5, -0.5, 0.5), vec3(-0.5, -0.5, 0.5), vec3(-0.5, 0.5, 0.5), vec3(0.5, 0.5, 0.5),          // +Z
+  vec3(-0.5, -0.5, -0.5), vec3(0.5, -0.5, -0.5), vec3(0.5, 0.5, -0.5), vec3(-0.5, 0.5, -0.5)       // -Z
+);
+
+const vec2 CORNER_UVS[4] = vec2[4](vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(1.0, 0.0), vec2(0.0, 0.0));
+
+// two triangles per face: bottom left, bottom right, top right, top right, top left, bottom left
+const int QUAD_CORNERS[6] = int[6](0, 1, 2, 2, 3, 0);
+
+uvec2 FetchFaceRecord() {
+  return texelFetch(faceRecords, gl_VertexID / 6).rg;
+}
+
+uint FaceDirection(uvec2 record) {
+  return (record.y >> 12u) & 7u;
+}
+
+int FaceCorner() {
+  return QUAD_CORNERS[gl_VertexID % 6];
+}
+
+vec3 FacePosition(uvec2 record) {
+  ivec3 cell = ivec3(uvec3(record.x, record.x >> 10u, record.x >> 20u) & 0x3FFu) - 512;
+  return vec3(cell) + FACE_CORNERS[FaceDirection(record) * 4u + uint(FaceCorner())];
+}
+
+// u, v and the texture array layer
+vec3 FaceTexCoord(uvec2 record) {
+  return vec3(CORNER_UVS[FaceCorner()], float(record.y & 0xFFFu));
+}
+
+vec3 FaceNormal(uvec2 record) {
+  return FACE_NORMALS[FaceDirection(record)];
+}
+
+float FaceLight(uvec2 record) {
+  return float((record.y >> 16u) & 0xFFu) / 255.0;
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+// per frame camera data, laid out to match FrameData in UniformBlocks.h (std140)
+
+layout(std140) uniform FrameData {
+  mat4 view;
+  mat4 projection;
+};
\ No newline at end of file
@@ -0,0 +1,140 @@
+// light structures and the shared LightData block, laid out to match LightData.h (std140)
+// MAX_* limits are injected by the ShaderProvider
+
+struct DirectionalLight {
+  vec3 direction;
+  float padding1;
+  vec3 diffuse;
+  float padding3;
+  vec3 specular;
+  float padding4;
+  vec3 ambient;
+  float padding2;
+};
+
+struct SpotLight {
+  vec3 position;
+  float padding1;
+  vec3 direction;
+  float padding2;
+  float cutOff;
+  float outerCutOff;
+};
+
+struct PointLight {
+  vec3 position;
+  float padding1;
+
+  float constant;
+  float linear;
+  float quadratic;
+  float padding2;
+
+  vec3 diffuse;
+  float padding3;
+  vec3 ambient;
+  float padding4;
+  vec3 specular;
+  float padding5;
+};
+
+layout(std140) uniform LightData {
+  DirectionalLight directionalLights[MAX_DIRECTIONAL_LIGHTS];
+  PointLight pointLights[MAX_POINT_LIGHTS];
+  SpotLight spotLights[MAX_SPOT_LIGHTS];
+  int numDirectionalLights;
+  int numPointLights;
+  int numSpotLights;
+  float padding1;
+};
+
+// the lights reaching the drawn entity, per draw from the storage buffers or per entity from uniforms
+#ifdef FEATURE_INDIRECT_DRAW
+#include "draw-data.glsl"
+
+flat in uint DrawID;
+
+int GetDirLightCount() { return draws[DrawID].dirLightCount; }
+int GetDirLightIndex(int i) { return lightIndices[draws[DrawID].firstLightIndex + i]; }
+
+int GetPointLightCount() { return draws[DrawID].pointLightCount; }
+int GetPointLightIndex(int i) { return lightIndices[draws[DrawID].firstLightIndex + draws[DrawID].dirLightCount + i]; }
+
+int GetSpotLightCount() { return draws[DrawID].spotLightCount; }
+int GetSpotLightIndex(int i) { return lightIndices[draws[DrawID].firstLightIndex + draws[DrawID].dirLightCount + draws[DrawID].pointLightCount + i]; }
+#else
+uniform int dirLightIndices[MAX_DIRECTIONAL_LIGHTS];
+uniform int numApplicableDirLights;
+
+uniform int pointLightIndices[MAX_POINT_LIGHTS];
+uniform int numApplicablePointLights;
+
+uniform int spotLightIndices[MAX_SPOT_LIGHTS];
+uniform int numApplicableSpotLights;
+
+int GetDirLightCount() { return numApplicableDirLights; }
+int GetDirLightIndex(int i) { return dirLightIndices[i]; }
+
+int GetPointLightCount() { return numApplicablePointLights; }
+int GetPointLightIndex(int i) { return pointLightIndices[i]; }
+
+int GetSpotLightCount() { return numApplicableSpotLights; }
+int GetSpotLightIndex(int i) { return spotLightIndices[i]; }
+#endif
+
+float CalculateSpecularFactor(vec3 lightDir, vec3 normal, vec3 viewDir, float shininess) {
+#ifdef LIGHT_MODEL_BLINN_PHONG
+  vec3 halfwayDir = normalize(lightDir + viewDir);
+  return pow(max(dot(normal, halfwayDir), 0.0), shininess);
+#else
+  vec3 reflectDir = reflect(-lightDir, normal);
+  return pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+#endif
+}
+
+vec3 CalculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 diffuseColor, vec3 specularColor, float shininess, float shadow) {
+  vec3 lightDir = normalize(-light.direction); //! directions must be transformed with w = 0!
+
+  // diffuse shading
+  float diff = max(dot(normal, lightDir), 0.0);
+
+  // specular highlight
+  float spec = CalculateSpecularFactor(lightDir, normal, viewDir, shininess);
+
+  vec3 ambient = light.ambient * diffuseColor;
+  vec3 diffuse = light.diffuse * diff * diffuseColor;
+  vec3 specular = light.specular * spec * specularColor;
+
+  return (ambient + shadow * (diffuse + specular));
+}
+
+vec3 CalculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 diffuseColor, vec3 specularColor, float shininess) {
+  // diffuse
+  vec3 lightDir = normalize(light.position - fragPos);
+  float diff = max(dot(normal, lightDir), 0.0);
+
+  // specular
+  float spec = CalculateSpecularFactor(lightDir, normal, viewDir, shininess);
+
+  vec3 ambient = light.ambient * diffuseColor;
+  vec3 diffuse = light.diffuse * diff * diffuseColor;
+  vec3 specular = light.specular * spec * specularColor;
+
+  // attenuation
+  float distance = length(light.position - fragPos);
+  float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+
+  ambient *= attenuation;
+  diffuse *= attenuation;
+  specular *= attenuation;
+
+  return (ambient + diffuse + specular);
+}
+
+float CalculateSpotLightIntensity(SpotLight light, vec3 fragPos) {
+  vec3 lightDir = normalize(light.position - fragPos);
+  float theta = dot(lightDir, normalize(-light.direction));
+  float epsilon = light.cutOff - light.outerCutOff;
+
+  return clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+}
\ No newline at end of file
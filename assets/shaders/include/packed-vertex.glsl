@@ -0,0 +1,21 @@
+// decoding of the 8 byte PackedVertex format, see PackedVertex.h
+//   x: position x, y, z as 10 bit fixed point (1/32 units, offset by -8)
+//   y: u, v as 6 bit fixed point (1/32 units), texture array layer in bits 12-23, face direction in bits 24-26
+
+// FACE_NORMALS comes from face-directions.glsl, the including shader includes it outside of its #if branches
+
+vec3 UnpackPosition(uvec2 packedVertex) {
+  uvec3 raw = uvec3(packedVertex.x, packedVertex.x >> 10u, packedVertex.x >> 20u) & 0x3FFu;
+  return vec3(raw) / 32.0 - 8.0;
+}
+
+// u, v and the texture array layer
+vec3 UnpackTexCoord(uvec2 packedVertex) {
+  uvec2 raw = uvec2(packedVertex.y, packedVertex.y >> 6u) & 0x3Fu;
+  float layer = float((packedVertex.y >> 12u) & 0xFFFu);
+  return vec3(vec2(raw) / 32.0, layer);
+}
+
+vec3 UnpackNormal(uvec2 packedVertex) {
+  return FACE_NORMALS[(packedVertex.y >> 24u) & 7u];
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+// cascaded shadow map of the primary directional light (index 0), see CascadedShadowMap
+// SHADOW_CASCADE_COUNT is injected by the ShaderProvider
+
+uniform sampler2DArrayShadow shadowMap;
+uniform mat4 lightSpaceMatrices[SHADOW_CASCADE_COUNT];
+uniform float cascadeSplits[SHADOW_CASCADE_COUNT];
+uniform bool cascadeValid[SHADOW_CASCADE_COUNT];
+uniform bool shadowsEnabled;
+
+// returns 1 for fully lit and 0 for fully shadowed fragments
+float CalculateShadow(vec3 normal, vec3 lightDir, vec3 viewPos, vec3 worldPos) {
+  if(!shadowsEnabled) {
+    return 1.0;
+  }
+
+  float viewDepth = -viewPos.z;
+
+  int cascade = -1;
+  for(int i = 0; i < SHADOW_CASCADE_COUNT; i++) {
+    if(viewDepth <= cascadeSplits[i]) {
+      cascade = i;
+      break;
+    }
+  }
+
+  if(cascade < 0 || !cascadeValid[cascade]) {
+    return 1.0;
+  }
+
+  vec4 lightSpacePos = lightSpaceMatrices[cascade] * vec4(worldPos, 1.0);
+  vec3 projected = lightSpacePos.xyz / lightSpacePos.w * 0.5 + 0.5;
+
+  // outside of the cached cascade volume, e.g. while the cascade waits for a refresh
+  if(any(lessThan(projected, vec3(0.0))) || any(greaterThan(projected, vec3(1.0)))) {
+    return 1.0;
+  }
+
+  float bias = max(0.0015 * (1.0 - dot(normal, lightDir)), 0.0005);
+  return texture(shadowMap, vec4(projected.xy, float(cascade), projected.z - bias));
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+#version 330 core
+
+void main()
+{
+  // depth only, gl_FragDepth is written implicitly
+}
\ No newline at end of file
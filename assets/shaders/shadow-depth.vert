@@ -0,0 +1,28 @@
+#version 330 core
+
+// outside the vertex input branches: includes are expanded once regardless of #if, so a branch must not be the first to include it
+#include "include/face-directions.glsl"
+
+#if defined(FEATURE_FACE_PULLING)
+#include "include/face-record.glsl" // no vertex attributes, the face is pulled by gl_VertexID
+#elif defined(FEATURE_PACKED_VERTICES)
+layout (location = 0) in uvec2 aPacked;
+
+#include "include/packed-vertex.glsl"
+#else
+layout (location = 0) in vec3 aPos;
+#endif
+
+uniform mat4 lightSpaceMatrix;
+uniform mat4 model;
+
+void main()
+{
+#if defined(FEATURE_FACE_PULLING)
+  vec3 aPos = FacePosition(FetchFaceRecord());
+#elif defined(FEATURE_PACKED_VERTICES)
+  vec3 aPos = UnpackPosition(aPacked);
+#endif
+
+  gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+}
\ No newline at end of file
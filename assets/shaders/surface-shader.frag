@@ -1,83 +1,46 @@
 #version 330 core
 
+#ifdef FEATURE_WEIGHTED_BLEND
+layout (location = 0) out vec4 Accumulation; // rgb: weighted premultiplied color, a: alpha, multiplied into the revealage
+layout (location = 1) out float Weight;      // weighted alpha, summed
+#else
 out vec4 FragColor;
+#endif
 
-in vec2 TexCoord;
+in vec3 TexCoord; // u, v, texture array layer
 in vec3 Normal;
 in vec3 FragPos;
-
-#define MAX_DIRECTIONAL_LIGHTS 32
-#define MAX_POINT_LIGHTS 512
-#define MAX_SPOT_LIGHTS 256
-
-struct DirectionalLight {
-  vec3 direction;
-  float padding1;
-  vec3 diffuse;
-  float padding3;
-  vec3 specular;
-  float padding4;
-  vec3 ambient;
-  float padding2;
-};
-
-struct SpotLight {
-  vec3 position;
-  float padding1;
-  vec3 direction;
-  float padding2;
-  float cutOff;
-  float outerCutOff;
-};
-
-struct PointLight {
-  vec3 position;
-  float padding1;
-
-  float constant;
-  float linear;
-  float quadratic;
-  float padding2;
-
-  vec3 diffuse;
-  float padding3;
-  vec3 ambient;
-  float padding4;
-  vec3 specular;
-  float padding5;
-};
-
-layout(std140) uniform LightData {
-  DirectionalLight directionalLights[MAX_DIRECTIONAL_LIGHTS];
-  PointLight pointLights[MAX_POINT_LIGHTS];
-  SpotLight spotLights[MAX_SPOT_LIGHTS];
-  int numDirectionalLights;
-  int numPointLights;
-  int numSpotLights;
-  float padding1;
-};
-
-uniform int dirLightIndices[MAX_DIRECTIONAL_LIGHTS];
-uniform int numApplicableDirLights;
-
-uniform int pointLightIndices[MAX_POINT_LIGHTS];
-uniform int numApplicablePointLights;
-
-uniform int spotLightIndices[MAX_SPOT_LIGHTS];
-uniform int numApplicableSpotLights;
+in vec3 WorldPos;
+#ifdef FEATURE_FACE_PULLING
+in float Light; // light of the face record, emission stays unlit
+#endif
+
+#include "include/lights.glsl"
+#include "include/shadows.glsl"
+
+// block materials sample parallel texture arrays with the layer of the vertex, everything else plain 2D maps
+#ifdef FEATURE_TEXTURE_ARRAY
+#define MATERIAL_SAMPLER sampler2DArray
+#define MATERIAL_UV TexCoord
+#else
+#define MATERIAL_SAMPLER sampler2D
+#define MATERIAL_UV TexCoord.xy
+#endif
 
 struct Material {
-  sampler2D diffuse;
-  sampler2D specular;
-  sampler2D emissive;
+  MATERIAL_SAMPLER diffuse;
+#ifdef FEATURE_SPECULAR_MAP
+  MATERIAL_SAMPLER specular;
+#endif
+#ifdef FEATURE_EMISSIVE
+  MATERIAL_SAMPLER emissive;
+#endif
   float shininess;
 };
 
 uniform Material material;
 
-vec3 CalculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 diffuseColor, vec3 specularColor);
-vec3 CalculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 diffuseColor, vec3 specularColor);
-float CalculateSpotLightIntensity(SpotLight light, vec3 fragPos, vec3 diffuseColor, vec3 specularColor);
+const float ALPHA_CUTOFF = 0.5; // cutout materials are either fully covered or not at all
 
 void main() {
   vec3 minSpecular = vec3(.2);
@@ -85,77 +48,54 @@ void main() {
   vec3 norm = normalize(Normal);
   vec3 viewDir = normalize(-FragPos);
 
-  vec3 diffuseTexelColor = vec3(texture(material.diffuse, TexCoord));
-  vec3 specularTexelColor = vec3(texture(material.specular, TexCoord)) + minSpecular;
-  vec3 emissionTexelColor = vec3(texture(material.emissive, TexCoord));
+  vec4 diffuseSample = texture(material.diffuse, MATERIAL_UV);
+#ifdef FEATURE_ALPHA_TEST
+  if (diffuseSample.a < ALPHA_CUTOFF)
+    discard;
+#endif
+  vec3 diffuseTexelColor = diffuseSample.rgb;
+
+#ifdef FEATURE_SPECULAR_MAP
+  vec3 specularTexelColor = vec3(texture(material.specular, MATERIAL_UV)) + minSpecular;
+#else
+  vec3 specularTexelColor = minSpecular;
+#endif
 
   vec3 result = vec3(0);
 
-  for(int i = 0; i < numApplicableDirLights; i++) {
-    int currentIndex = dirLightIndices[i];
-    result += CalculateDirectionalLight(directionalLights[currentIndex], norm, viewDir, diffuseTexelColor, specularTexelColor);
+  for(int i = 0; i < GetDirLightCount(); i++) {
+    int currentIndex = GetDirLightIndex(i);
+    float shadow = currentIndex == 0 ? CalculateShadow(norm, normalize(-directionalLights[0].direction), FragPos, WorldPos) : 1.0;
+    result += CalculateDirectionalLight(directionalLights[currentIndex], norm, viewDir, diffuseTexelColor, specularTexelColor, material.shininess, shadow);
   }
 
-  // for(int i = 0; i < numApplicableSpotLights; i++) {
-  //   int currentIndex = spotLightIndices[i];
-  //   result *= CalculateSpotLightIntensity(spotLights[currentIndex], FragPos, diffuseTexelColor, specularTexelColor);
+  // for(int i = 0; i < GetSpotLightCount(); i++) {
+  //   int currentIndex = GetSpotLightIndex(i);
+  //   result *= CalculateSpotLightIntensity(spotLights[currentIndex], FragPos);
   // }
 
-  for(int i = 0; i < numApplicablePointLights; i++) {
-    int currentIndex = pointLightIndices[i];
-    result += CalculatePointLight(pointLights[currentIndex], norm, FragPos, viewDir, diffuseTexelColor, specularTexelColor);
+  for(int i = 0; i < GetPointLightCount(); i++) {
+    int currentIndex = GetPointLightIndex(i);
+    result += CalculatePointLight(pointLights[currentIndex], norm, FragPos, viewDir, diffuseTexelColor, specularTexelColor, material.shininess);
   }
 
-  result += emissionTexelColor;
-
+#ifdef FEATURE_FACE_PULLING
+  result *= Light;
+#endif
+
+#ifdef FEATURE_EMISSIVE
+  result += vec3(texture(material.emissive, MATERIAL_UV));
+#endif
+
+#if defined(FEATURE_WEIGHTED_BLEND)
+  // weight falls off with depth so close layers dominate, clamped to stay within half float range
+  float alpha = diffuseSample.a;
+  float weight = clamp(alpha * max(1e-2, 3e3 * pow(1.0 - gl_FragCoord.z, 3.0)), 1e-2, 3e3);
+  Accumulation = vec4(result * alpha * weight, alpha);
+  Weight = alpha * weight;
+#elif defined(FEATURE_ALPHA_BLEND)
+  FragColor = vec4(result, diffuseSample.a);
+#else
   FragColor = vec4(result, 1);
-}
-
-vec3 CalculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 diffuseColor, vec3 specularColor) {
-  vec3 lightDir = normalize(-light.direction); //! directions must be transformed with w = 0!
-
-  // diffuse shading
-  float diff = max(dot(normal, lightDir), 0.0);
-
-  // specular highlight
-  vec3 reflectDir = reflect(-lightDir, normal);
-  float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-
-  vec3 ambient = light.ambient * diffuseColor;
-  vec3 diffuse = light.diffuse * diff * diffuseColor;
-  vec3 specular = light.specular * spec * specularColor;
-
-  return (ambient + diffuse + specular);
-}
-
-vec3 CalculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 diffuseColor, vec3 specularColor) {
-  // diffuse
-  vec3 lightDir = normalize(light.position - fragPos);
-  float diff = max(dot(normal, lightDir), 0.0);
-
-  // specular
-  vec3 reflectDir = reflect(-lightDir, normal);
-  float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-
-  vec3 ambient = light.ambient * diffuseColor;
-  vec3 diffuse = light.diffuse * diff * diffuseColor;
-  vec3 specular = light.specular * spec * specularColor;
-
-  // attenuation
-  float distance = length(light.position - fragPos);
-  float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
-
-  ambient *= attenuation;
-  diffuse *= attenuation;
-  specular *= attenuation;
-
-  return (ambient + diffuse + specular);
-}
-
-float CalculateSpotLightIntensity(SpotLight light, vec3 fragPos, vec3 diffuseColor, vec3 specularColor) {
-  vec3 lightDir = normalize(light.position - fragPos);
-  float theta = dot(lightDir, normalize(-light.direction));
-  float epsilon = light.cutOff - light.outerCutOff;
-
-  return clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
-}
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#version 330 core
+
+out vec4 FragColor;
+
+uniform sampler2D accumulation; // rgb: sum of weighted premultiplied colors, a: revealage
+uniform sampler2D weights;      // r: sum of weighted alphas
+uniform ivec2 viewportOrigin;   // the targets start at the viewport, the window at 0
+
+void main()
+{
+  ivec2 texel = ivec2(gl_FragCoord.xy) - viewportOrigin;
+  vec4 accumulated = texelFetch(accumulation, texel, 0);
+
+  float revealage = accumulated.a;
+  if (revealage >= 1.0)
+    discard; // no translucent surface covers the pixel
+
+  float weight = texelFetch(weights, texel, 0).r;
+  vec3 averageColor = accumulated.rgb / max(weight, 1e-5);
+
+  // blended with SRC_ALPHA, ONE_MINUS_SRC_ALPHA, the opaque image shows through by the revealage
+  FragColor = vec4(averageColor, 1.0 - revealage);
+}
\ No newline at end of file
@@ -12,6 +12,10 @@
 #include "renderer/shader/ShaderProvider.h"
 #include "renderer/color/Color.h"
 #include "renderer/scene/Scene.h"
+#include "renderer/memory/FrameAllocator.h"
+#include "renderer/memory/UploadRing.h"
+#include "renderer/memory/UploadScheduler.h"
+#include "renderer/mesh/MeshArena.h"
 #include "renderer/light/lights/PointLight.h"
 #include "renderer/light/lights/DirectionalLight.h"
 
@@ -51,6 +55,8 @@ int main()
   camera.SetProjectionMatrix(fov, (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
   renderer.setActiveCamera(&camera);
 
+  // block meshes are built with the registry, so their vertex path (Float, Packed or pulled FaceRecords) is picked first
+  BlockRegistry::setVertexFormat(BlockVertexFormat::Packed);
   BlockRegistry &blockRegistry = BlockRegistry::getInstance();
 
   Scene testScene = Scene();
@@ -60,18 +66,31 @@ int main()
   {
     processInput(window.getWindow());
 
+    blockRegistry.updateAnimations(glfwGetTime());
+
     renderer.initFrame(glm::vec3(0));
 
     renderer.renderScene(&testScene, camera);
 
+    // the upload budgets adapt to the CPU work of the frame, the swap below waits for vsync
+    UploadScheduler::getInstance().endFrame();
+
     window.swapBuffers();
     window.pollEvents();
 
+    // transient render data of this frame is released at once
+    FrameAllocator::getInstance().endFrame();
+    UploadRing::getInstance().endFrame();
+
     float currentFrame = static_cast<float>(glfwGetTime());
     deltaTime = currentFrame - lastFrame;
     lastFrame = currentFrame;
   }
 
+  // GPU resources of the singletons go while the context is current, their destructors run after glfwTerminate
+  MeshArena::getInstance().shutdown();
+  UploadRing::getInstance().shutdown();
+
   return 0;
 }
 
@@ -7,6 +7,8 @@
 
 #include "Renderer.h"
 
+#include <algorithm>
+
 Renderer::Renderer()
 {
 }
@@ -17,13 +19,14 @@ Renderer::~Renderer()
 
 void Renderer::initFrame(glm::vec3 color) const
 {
-  glEnable(GL_BLEND); // enable blending function to allow for transparency
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
   // enables depth testing, openGL will keep a depth buffer (z-buffer) to keep track of what to render on top of what
   // it allows rendering one thing in front of another and hiding the back object
   glEnable(GL_DEPTH_TEST);
 
+  // blending and culling are switched per pass in renderScene, block faces are wound clockwise seen from outside
+  glCullFace(GL_BACK);
+  glFrontFace(GL_CW);
+
   glClearColor(color.x, color.y, color.z, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -53,22 +56,21 @@ void Renderer::renderEntity(RenderEntity &entity) const
   if (!activeCamera)
   {
     std::cerr << "No active camera set!" << std::endl;
+    return;
   }
 
-  Shader shader = entity.getMaterial()->getShader();
-  shader.use();
-
-  setCameraUniforms(shader);
+  if (!entity.getMesh()->isUploaded())
+    return;
 
-  shader.setMat4("model", entity.getTransform().getModelMatrix());
-
-  entity.getMaterial()->bind();
-  entity.getMesh()->bindBuffers();
+  // draws with a simpler permutation while the material's own one is still compiling
+  Shader &shader = ShaderProvider::getInstance().resolve(entity.getMaterial()->getShader());
+  shader.use();
 
-  entity.getMesh()->draw();
+  CameraSnapshot camera(*activeCamera);
+  uploadFrameData(camera);
 
+  drawRenderable(shader, camera, entity.getTransform().getModelMatrix(), *entity.getMesh(), *entity.getMaterial());
   entity.getMesh()->unbindBuffers();
-  entity.getMaterial()->unbind();
 }
 
 void Renderer::renderEntity(RenderEntity *entity) const
@@ -78,32 +80,235 @@ void Renderer::renderEntity(RenderEntity *entity) const
 
 void Renderer::renderScene(Scene *scene, Camera &activeCamera) const
 {
-  scene->getLightManager()->updateUBO(activeCamera);
-  unsigned int surfaceShaderId = ShaderProvider::getInstance().getShader(ShaderType::Surface).ID;
+  // pick up permutations the driver finished in the background
+  ShaderCompileScheduler::getInstance().poll();
+
+  // queued mesh and texture uploads within this frame's budget
+  UploadScheduler::getInstance().update();
+
+  // every transform changed since the last frame in one batch, instead of lazily in the middle of draw submission
+  TransformStore::getInstance().updateMatrices();
+
+  // the cached shadows don't contain the geometry that was just uploaded yet
+  scene->updateShadowCasters();
+
+  // moves mesh allocations, so it has to run before any draw of the frame
+  MeshArena::getInstance().update();
+
+  // matrices and frustum are computed once for the frame, relative to the camera so far away scenes keep their precision
+  CameraSnapshot camera(activeCamera, scene->getOrigin());
+  uploadFrameData(camera);
+
+  renderShadowPass(scene, camera);
+
+  scene->getLightManager()->updateUBO(camera);
+
+  // shadow data only changes once per frame, so it is set on every surface permutation once instead of per entity
+  scene->getShadowMap()->bind(SHADOW_MAP_TEXTURE_UNIT);
+  for (Shader *surfaceShader : ShaderProvider::getInstance().getVariants(ShaderType::Surface, &FrameAllocator::getInstance().getFrameArena()))
+  {
+    scene->getShadowMap()->setUniforms(*surfaceShader, SHADOW_MAP_TEXTURE_UNIT, camera.sceneOffset);
+  }
+
+  auto &transformStore = TransformStore::getInstance();
+  auto *frameArena = &FrameAllocator::getInstance().getFrameArena();
+
+  // visible entities are split by the pass their material is drawn in, archetype arrays are walked row by row
+  std::pmr::vector<VisibleEntity> layers[RENDER_LAYER_COUNT] = {
+      std::pmr::vector<VisibleEntity>(frameArena), std::pmr::vector<VisibleEntity>(frameArena),
+      std::pmr::vector<VisibleEntity>(frameArena)};
+
+  for (const auto &archetype : scene->getEntityStore().getArchetypes())
+  {
+    bool receivesLight = archetype.tags & EntityTag::LightReceiver;
+
+    for (size_t i = 0; i < archetype.size(); ++i)
+    {
+      const glm::mat4 &model = transformStore.getModelMatrix(archetype.transforms[i]);
+      Bounds bounds = archetype.bounds[i].transformed(model);
+      glm::vec3 relativeCenter = bounds.center + camera.sceneOffset;
+
+      if (!archetype.meshes[i]->isUploaded() || !camera.isSphereVisible(relativeCenter, bounds.radius))
+        continue;
+
+      RenderLayer layer = archetype.materials[i]->getRenderLayer();
+      layers[static_cast<size_t>(layer)].push_back({archetype.entities[i], &model, bounds, archetype.meshes[i], archetype.materials[i],
+                                                    receivesLight, glm::dot(relativeCenter, relativeCenter),
+                                                    getFacingDirections(camera, model, *archetype.meshes[i], layer)});
+    }
+  }
+
+  // front to back, so hidden fragments fail the depth test before shading
+  auto frontToBack = [](const VisibleEntity &a, const VisibleEntity &b)
+  { return a.distance < b.distance; };
+  auto &opaque = layers[static_cast<size_t>(RenderLayer::Opaque)];
+  auto &cutout = layers[static_cast<size_t>(RenderLayer::Cutout)];
+  auto &translucent = layers[static_cast<size_t>(RenderLayer::Translucent)];
+  std::sort(opaque.begin(), opaque.end(), frontToBack);
+  std::sort(cutout.begin(), cutout.end(), frontToBack);
+
+  // weighted blended transparency takes the translucent draws in any order, sorting is only needed without it
+  if (transparencyMode != TransparencyMode::Sorted && !weightedBlended)
+    weightedBlended = std::make_unique<WeightedBlendedTransparency>();
+
+  TransparencyMode transparency = transparencyMode;
+  if (transparency != TransparencyMode::Sorted && !weightedBlended->isAvailable())
+    transparency = TransparencyMode::Sorted;
+
+  if (transparency != TransparencyMode::WeightedBlended)
+    orderTranslucent(scene, camera, translucent);
+
+  // on 4.3 contexts the lit world is collected and submitted with a few multi draw indirect calls
+  bool useIndirect = indirectDrawing && IndirectDrawer::isSupported();
+  if (useIndirect && !indirectDrawer)
+    indirectDrawer = std::make_unique<IndirectDrawer>();
 
-  for (auto &entity : scene->getEntities())
+  // the queries of a disabled profiler are released with it
+  if (passProfiling && !passProfiler)
+    passProfiler = std::make_unique<PassProfiler>();
+  else if (!passProfiling && passProfiler)
+    passProfiler.reset();
+
+  // collected once, the depth pre-pass and the lit pass submit the same draws
+  if (useIndirect)
+    queueIndirect(scene, camera, opaque);
+
+  beginPass(RenderLayer::Opaque);
+  if (depthPrepass && !opaque.empty())
   {
-    auto dirLights = scene->getLightManager()->getApplicableDirLights(*entity);
-    auto pointLights = scene->getLightManager()->getApplicablePointLights(*entity);
-    auto spotLights = scene->getLightManager()->getApplicableSpotLights(*entity);
+    profilePass(RenderPass::DepthPrepass);
+    drawDepthPrepass(camera, opaque, useIndirect);
+
+    // only the fragment that wrote the pre-pass depth passes, every pixel is lit once
+    glDepthFunc(GL_EQUAL);
+    glDepthMask(GL_FALSE);
+  }
+
+  profilePass(RenderPass::Opaque);
+  drawPass(scene, camera, opaque, useIndirect);
 
-    // TODO: send light data to shader
-    glUniform1iv(glGetUniformLocation(surfaceShaderId, "dirLightIndices"),
-                 dirLights.size(), dirLights.data());
-    glUniform1iv(glGetUniformLocation(surfaceShaderId, "pointLightIndices"),
-                 pointLights.size(), pointLights.data());
-    glUniform1iv(glGetUniformLocation(surfaceShaderId, "spotLightIndices"),
-                 spotLights.size(), spotLights.data());
+  // alpha tested fragments can't be in the pre-pass, cutout is tested and written as usual
+  beginPass(RenderLayer::Cutout);
+  profilePass(RenderPass::Cutout);
+  if (useIndirect)
+    queueIndirect(scene, camera, cutout);
+  drawPass(scene, camera, cutout, useIndirect);
 
-    glUniform1i(glGetUniformLocation(surfaceShaderId, "numApplicableDirLights"),
-                dirLights.size());
-    glUniform1i(glGetUniformLocation(surfaceShaderId, "numApplicablePointLights"),
-                pointLights.size());
-    glUniform1i(glGetUniformLocation(surfaceShaderId, "numApplicableSpotLights"),
-                spotLights.size());
+  GLint viewport[4];
+  glGetIntegerv(GL_VIEWPORT, viewport);
 
-    renderEntity(*entity);
+  // the comparison splits the screen, so both halves show the same scene and their pass times can be compared
+  bool compare = transparency == TransparencyMode::Compare;
+  GLint halfWidth = viewport[2] / 2;
+
+  if (transparency != TransparencyMode::WeightedBlended)
+  {
+    // blending depends on the exact draw order, batching would reorder it
+    beginPass(RenderLayer::Translucent);
+    profilePass(RenderPass::Translucent);
+    if (compare)
+    {
+      glEnable(GL_SCISSOR_TEST);
+      glScissor(viewport[0], viewport[1], halfWidth, viewport[3]);
+    }
+    drawPass(scene, camera, translucent, false);
   }
+
+  if (transparency != TransparencyMode::Sorted && !translucent.empty())
+  {
+    beginPass(RenderLayer::Translucent);
+    profilePass(RenderPass::WeightedBlended);
+    if (compare)
+      glScissor(viewport[0] + halfWidth, viewport[1], viewport[2] - halfWidth, viewport[3]);
+
+    // order independent, so translucent draws batch like opaque ones
+    if (weightedBlended->begin(viewport))
+    {
+      if (useIndirect)
+        queueIndirect(scene, camera, translucent);
+      drawPass(scene, camera, translucent, useIndirect, ShaderFeature::WeightedBlend);
+
+      weightedBlended->composite();
+    }
+  }
+
+  glDisable(GL_SCISSOR_TEST);
+  endPasses();
+  MeshArena::getInstance().unbind();
+
+  if (passProfiler)
+    passProfiler->endFrame(static_cast<uint64_t>(viewport[2]) * static_cast<uint64_t>(viewport[3]));
+}
+
+/// @brief Refresh the cached shadow cascades of the primary directional light that are out of date.
+/// Does nothing on frames where neither the sun, the snapped cascade origins nor the geometry changed.
+/// @param scene the scene casting shadows
+/// @param camera snapshot of the camera the cascades are fitted to
+void Renderer::renderShadowPass(Scene *scene, const CameraSnapshot &camera) const
+{
+  auto *shadowMap = scene->getShadowMap();
+  auto directionalLights = scene->getLightManager()->getDirectionalLights();
+
+  shadowMap->setHasLight(!directionalLights.empty());
+  if (directionalLights.empty())
+    return;
+
+  auto cascades = shadowMap->prepare(directionalLights.front(), camera, &FrameAllocator::getInstance().getFrameArena());
+  if (cascades.empty())
+    return;
+
+  GLint viewport[4];
+  glGetIntegerv(GL_VIEWPORT, viewport);
+
+  // push depth values back a bit to avoid shadow acne on the lit faces
+  glEnable(GL_POLYGON_OFFSET_FILL);
+  glPolygonOffset(2.0f, 4.0f);
+
+  // one depth permutation per vertex format, picked by the format the entity's material was built for
+  auto &shaderProvider = ShaderProvider::getInstance();
+  auto &transformStore = TransformStore::getInstance();
+  Shader &depthShader = shaderProvider.resolve(shaderProvider.getShader(ShaderType::ShadowDepth));
+  Shader &packedDepthShader = shaderProvider.resolve(shaderProvider.getShader(ShaderType::ShadowDepth, ShaderFeature::PackedVertices));
+  Shader &pulledDepthShader = shaderProvider.resolve(shaderProvider.getShader(ShaderType::ShadowDepth, ShaderFeature::FacePulling));
+
+  for (int cascade : cascades)
+  {
+    shadowMap->beginCascade(cascade);
+    depthShader.setMat4("lightSpaceMatrix", shadowMap->getLightSpaceMatrix(cascade));
+    packedDepthShader.setMat4("lightSpaceMatrix", shadowMap->getLightSpaceMatrix(cascade));
+    pulledDepthShader.setMat4("lightSpaceMatrix", shadowMap->getLightSpaceMatrix(cascade));
+
+    for (const auto &archetype : scene->getEntityStore().getArchetypes())
+    {
+      if (!(archetype.tags & EntityTag::ShadowCaster))
+        continue;
+
+      for (size_t i = 0; i < archetype.size(); ++i)
+      {
+        const glm::mat4 &model = transformStore.getModelMatrix(archetype.transforms[i]);
+        Bounds bounds = archetype.bounds[i].transformed(model);
+
+        if (!archetype.meshes[i]->isUploaded() || !shadowMap->cascadeContains(cascade, bounds.center, bounds.radius))
+          continue;
+
+        ShaderFeatures vertexInput = archetype.materials[i]->getShader().getFeatures() & VERTEX_INPUT_FEATURES;
+        Shader &shader = vertexInput == ShaderFeature::PackedVertices ? packedDepthShader
+                         : vertexInput == ShaderFeature::FacePulling  ? pulledDepthShader
+                                                                      : depthShader;
+        shader.setMat4("model", model);
+
+        archetype.meshes[i]->bindBuffers();
+        archetype.meshes[i]->draw();
+      }
+    }
+  }
+
+  MeshArena::getInstance().unbind();
+
+  shadowMap->endPass();
+
+  glDisable(GL_POLYGON_OFFSET_FILL);
+  glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
 }
 
 void Renderer::setActiveCamera(Camera *camera)
@@ -135,6 +340,33 @@ void Renderer::setWireframeRendering(bool enabled)
   }
 }
 
+/// @brief Toggle multi draw indirect submission, it is only used where the context supports it
+void Renderer::setIndirectDrawing(bool enabled)
+{
+  indirectDrawing = enabled;
+}
+
+/// @brief Pick how translucent surfaces are blended. Falls back to sorted blending if the weighted blended targets
+/// can't be created.
+void Renderer::setTransparencyMode(TransparencyMode mode)
+{
+  transparencyMode = mode;
+}
+
+/// @brief Toggle the depth-only pre-pass of opaque geometry. It pays off when the lit pass is expensive (many lights)
+/// and the scene has a lot of overdraw, compare the pass times and overdraw of getPassProfiler() with it on and off while setPassProfiling is enabled.
+void Renderer::setDepthPrepass(bool enabled)
+{
+  depthPrepass = enabled;
+}
+
+/// @brief Toggle the GPU timer and samples passed queries around the scene passes. Off by default, the queries
+/// are only worth their cost while the passes are being measured.
+void Renderer::setPassProfiling(bool enabled)
+{
+  passProfiling = enabled;
+}
+
 Camera *Renderer::getActiveCamera() const
 {
   return activeCamera;
@@ -145,17 +377,10 @@ size_t Renderer::getCameraCount() const
   return cameras.size();
 }
 
-/// @brief Set Camera uniforms on a shader program
-/// @param shader The shader to set the camera transform uniforms on
-void Renderer::setCameraUniforms(Shader &shader) const
+/// @return GPU times and overdraw of the scene passes, nullptr while profiling is off or before the first profiled frame
+const PassProfiler *Renderer::getPassProfiler() const
 {
-  if (!activeCamera)
-  {
-    std::cerr << "No active camera set!" << std::endl;
-  }
-
-  shader.setMat4("view", activeCamera->GetViewMatrix());
-  shader.setMat4("projection", activeCamera->GetProjectionMatrix());
+  return passProfiler.get();
 }
 
 void Renderer::listCameras() const
@@ -165,4 +390,252 @@ void Renderer::listCameras() const
   {
     std::cout << i << ": Camera at " << cameras[i] << std::endl;
   }
+}
+
+// ------- private ------- //
+
+/// @brief Upload the camera matrices of the frame and bind them to the FrameData block all programs share,
+/// instead of setting them on every program per draw
+void Renderer::uploadFrameData(const CameraSnapshot &camera) const
+{
+  FrameData frameData{camera.view, camera.projection};
+
+  auto &uploadRing = UploadRing::getInstance();
+  auto allocation = uploadRing.upload(&frameData, sizeof(FrameData), uploadRing.getUniformAlignment());
+  glBindBufferRange(GL_UNIFORM_BUFFER, UniformBlockBinding::FrameDataBinding, allocation.buffer, allocation.offset, sizeof(FrameData));
+}
+
+/// @brief Set the blend, cull and depth state of a pass once, instead of per draw
+void Renderer::beginPass(RenderLayer layer) const
+{
+  glDepthFunc(GL_LESS); // the depth pre-pass switches the opaque pass to GL_EQUAL
+
+  switch (layer)
+  {
+  case RenderLayer::Opaque:
+    glDisable(GL_BLEND);
+    glEnable(GL_CULL_FACE);
+    glDepthMask(GL_TRUE);
+    break;
+  case RenderLayer::Cutout:
+    glDisable(GL_BLEND);
+    glDisable(GL_CULL_FACE); // cutout surfaces like foliage are seen from both sides
+    glDepthMask(GL_TRUE);
+    break;
+  case RenderLayer::Translucent:
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_CULL_FACE);
+    glDepthMask(GL_FALSE); // translucent surfaces behind each other all have to show
+    break;
+  }
+}
+
+/// @brief Back to the default state, glClear only clears depth with the depth mask set
+void Renderer::endPasses() const
+{
+  glDepthFunc(GL_LESS);
+  glDisable(GL_BLEND);
+  glDisable(GL_CULL_FACE);
+  glDepthMask(GL_TRUE);
+}
+
+/// @brief Start measuring a scene pass if pass profiling is enabled, ends the measurement of the previous pass
+void Renderer::profilePass(RenderPass pass) const
+{
+  if (passProfiler)
+    passProfiler->beginPass(pass);
+}
+
+/// @brief Hand the light receivers of a pass to the indirect drawer, light sources keep their per entity uniforms
+void Renderer::queueIndirect(Scene *scene, const CameraSnapshot &camera, std::span<const VisibleEntity> entities) const
+{
+  auto *frameArena = &FrameAllocator::getInstance().getFrameArena();
+  const auto &lightManager = *scene->getLightManager();
+
+  indirectDrawer->begin();
+
+  std::array<MeshRange, FACE_DIRECTION_COUNT> ranges;
+  for (const auto &visible : entities)
+  {
+    if (!visible.receivesLight)
+      continue;
+
+    indirectDrawer->add(*visible.material, visible.mesh->getHandle(), visible.mesh->getRanges(visible.directions, ranges),
+                        camera.getRelativeModel(*visible.model),
+                        lightManager.getApplicableDirLights(visible.bounds, frameArena),
+                        lightManager.getApplicablePointLights(visible.bounds, frameArena),
+                        lightManager.getApplicableSpotLights(visible.bounds, frameArena));
+  }
+}
+
+/// @brief Write the depth of the opaque entities with a position only program and no color writes, so the lit
+/// pass can run with GL_EQUAL and shade every pixel exactly once
+/// @param useIndirect the light receivers were queued in the indirect drawer
+void Renderer::drawDepthPrepass(const CameraSnapshot &camera, std::span<const VisibleEntity> entities, bool useIndirect) const
+{
+  auto &shaderProvider = ShaderProvider::getInstance();
+  Shader &depthShader = shaderProvider.resolve(shaderProvider.getShader(ShaderType::DepthPrepass));
+  Shader &packedDepthShader = shaderProvider.resolve(shaderProvider.getShader(ShaderType::DepthPrepass, ShaderFeature::PackedVertices));
+  Shader &pulledDepthShader = shaderProvider.resolve(shaderProvider.getShader(ShaderType::DepthPrepass, ShaderFeature::FacePulling));
+
+  glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+  for (const auto &visible : entities)
+  {
+    if (useIndirect && visible.receivesLight)
+      continue;
+
+    ShaderFeatures vertexInput = visible.material->getShader().getFeatures() & VERTEX_INPUT_FEATURES;
+    Shader &shader = vertexInput == ShaderFeature::PackedVertices ? packedDepthShader
+                     : vertexInput == ShaderFeature::FacePulling  ? pulledDepthShader
+                                                                  : depthShader;
+    shader.setMat4("model", camera.getRelativeModel(*visible.model));
+
+    visible.mesh->bindBuffers();
+    visible.mesh->draw(visible.directions);
+  }
+
+  if (useIndirect)
+    indirectDrawer->submitDepth(ShaderType::DepthPrepass);
+
+  glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+/// @brief Draw the entities of one pass in the given order
+/// @param useIndirect light receivers were queued in the indirect drawer and are submitted with it
+/// @param addedFeatures drawn with this permutation of the material shaders, e.g. WeightedBlend
+void Renderer::drawPass(Scene *scene, const CameraSnapshot &camera, std::span<const VisibleEntity> entities, bool useIndirect,
+                        ShaderFeatures addedFeatures) const
+{
+  if (entities.empty())
+    return;
+
+  auto &shaderProvider = ShaderProvider::getInstance();
+  const auto &lightManager = *scene->getLightManager();
+
+  for (const auto &visible : entities)
+  {
+    if (useIndirect && visible.receivesLight)
+      continue;
+
+    Shader &requested = visible.material->getShader();
+    Shader &shader = shaderProvider.resolve(addedFeatures ? shaderProvider.getPermutation(requested, addedFeatures) : requested);
+    shader.use();
+
+    // light indices are per entity and go to the program the entity is drawn with
+    if (visible.receivesLight)
+      setLightUniforms(shader, lightManager, visible.bounds);
+
+    drawRenderable(shader, camera, *visible.model, *visible.mesh, *visible.material, visible.directions);
+  }
+
+  if (useIndirect)
+    indirectDrawer->submit(addedFeatures);
+}
+
+/// @brief Put the translucent entities in back to front order. They are only sorted again once the camera moved
+/// further than TRANSLUCENT_RESORT_DISTANCE or the visible set changed, otherwise the last order is reused, so
+/// small camera motion neither costs a sort nor makes overlapping surfaces flicker between orders.
+/// @param entities visible translucent entities, reordered in place
+void Renderer::orderTranslucent(Scene *scene, const CameraSnapshot &camera, std::pmr::vector<VisibleEntity> &entities) const
+{
+  // order independent, so the set can be compared without sorting it first
+  uint64_t setHash = 0;
+  for (const auto &visible : entities)
+  {
+    uint64_t key = (static_cast<uint64_t>(visible.entity.index) << 32) | visible.entity.generation;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+    setHash += key ^ (key >> 31);
+  }
+
+  bool moved = glm::distance(camera.worldPosition, translucentSortPosition) > TRANSLUCENT_RESORT_DISTANCE;
+  if (!translucentOrderValid || moved || setHash != translucentSetHash || entities.size() != translucentOrder.size())
+  {
+    std::sort(entities.begin(), entities.end(), [](const VisibleEntity &a, const VisibleEntity &b)
+              { return a.distance > b.distance; });
+
+    translucentOrder.clear();
+    for (const auto &visible : entities)
+      translucentOrder.push_back(visible.entity);
+
+    translucentSortPosition = camera.worldPosition;
+    translucentSetHash = setHash;
+    translucentOrderValid = true;
+    return;
+  }
+
+  // same set as last frame, drawn in the cached order with this frame's components
+  auto &entityStore = scene->getEntityStore();
+  auto &transformStore = TransformStore::getInstance();
+  for (size_t i = 0; i < translucentOrder.size(); ++i)
+  {
+    EntityHandle handle = translucentOrder[i];
+    const glm::mat4 &model = transformStore.getModelMatrix(entityStore.getTransform(handle));
+
+    Mesh *mesh = entityStore.getMesh(handle);
+    entities[i] = {handle, &model, entityStore.getBounds(handle).transformed(model), mesh, entityStore.getMaterial(handle),
+                   (entityStore.getTags(handle) & EntityTag::LightReceiver) != 0, 0.0f,
+                   getFacingDirections(camera, model, *mesh, RenderLayer::Translucent)};
+  }
+}
+
+/// @brief The face directions of a mesh worth drawing. Meshes grouped into face buckets skip the directions that
+/// face away from the camera as a whole, which GL_CULL_FACE would only reject after transforming their vertices.
+/// @param model model matrix in scene space
+/// @param layer cutout surfaces are double sided, they keep all directions
+FaceDirections Renderer::getFacingDirections(const CameraSnapshot &camera, const glm::mat4 &model, const Mesh &mesh, RenderLayer layer) const
+{
+  if (!mesh.hasFaceBuckets() || layer == RenderLayer::Cutout)
+    return ALL_FACE_DIRECTIONS;
+
+  // the camera in mesh space, facing is decided against the face planes there
+  glm::vec3 viewer = glm::vec3(glm::inverse(model) * glm::vec4(camera.scenePosition, 1.0f));
+  return mesh.getFaceBuckets().getFacingDirections(viewer);
+}
+
+/// @brief Set model and material state on an already bound shader and draw the mesh
+/// @param model model matrix in scene space, moved camera relative here
+/// @param directions face buckets to draw, see getFacingDirections()
+void Renderer::drawRenderable(Shader &shader, const CameraSnapshot &camera, const glm::mat4 &model, Mesh &mesh, Material &material,
+                              FaceDirections directions) const
+{
+  shader.setMat4("model", camera.getRelativeModel(model));
+
+  material.bind(shader);
+  mesh.bindBuffers();
+
+  mesh.draw(directions);
+
+  material.unbind();
+}
+
+/// @brief Upload the indices of the lights that reach an entity
+/// @param shader the bound program the entity is drawn with
+/// @param lightManager lights of the scene
+/// @param worldBounds bounding sphere of the entity in world space
+void Renderer::setLightUniforms(Shader &shader, const LightManager &lightManager, const Bounds &worldBounds) const
+{
+  // freed with the rest of the frame, not per entity
+  auto *frameArena = &FrameAllocator::getInstance().getFrameArena();
+  auto dirLights = lightManager.getApplicableDirLights(worldBounds, frameArena);
+  auto pointLights = lightManager.getApplicablePointLights(worldBounds, frameArena);
+  auto spotLights = lightManager.getApplicableSpotLights(worldBounds, frameArena);
+
+  unsigned int shaderId = shader.ID;
+
+  glUniform1iv(glGetUniformLocation(shaderId, "dirLightIndices"),
+               dirLights.size(), dirLights.data());
+  glUniform1iv(glGetUniformLocation(shaderId, "pointLightIndices"),
+               pointLights.size(), pointLights.data());
+  glUniform1iv(glGetUniformLocation(shaderId, "spotLightIndices"),
+               spotLights.size(), spotLights.data());
+
+  glUniform1i(glGetUniformLocation(shaderId, "numApplicableDirLights"),
+              dirLights.size());
+  glUniform1i(glGetUniformLocation(shaderId, "numApplicablePointLights"),
+              pointLights.size());
+  glUniform1i(glGetUniformLocation(shaderId, "numApplicableSpotLights"),
+              spotLights.size());
 }
\ No newline at end of file
@@ -8,15 +8,26 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <vector>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
 #include "renderer/camera/Camera.h"
+#include "renderer/camera/CameraSnapshot.h"
 #include "renderer/scene/Scene.h"
 #include "renderer/shader/Shader.h"
 #include "renderer/render_entity/RenderEntity.h"
 #include "renderer/shader/ShaderProvider.h"
+#include "renderer/transform/TransformStore.h"
+#include "renderer/memory/FrameAllocator.h"
+#include "renderer/memory/UploadRing.h"
+#include "renderer/memory/UploadScheduler.h"
+#include "renderer/indirect/IndirectDrawer.h"
+#include "renderer/profiling/PassProfiler.h"
+#include "renderer/transparency/WeightedBlendedTransparency.h"
 
 class Renderer
 {
@@ -33,6 +44,7 @@ public:
   void renderEntity(RenderEntity *entity) const;
 
   void renderScene(Scene *scene, Camera &activeCamera) const;
+  void renderShadowPass(Scene *scene, const CameraSnapshot &camera) const;
 
   // --- debug ---
   void listCameras() const;
@@ -42,14 +54,63 @@ public:
   void setActiveCamera(size_t index);
 
   void setWireframeRendering(bool enabled = true);
+  void setIndirectDrawing(bool enabled = true);
+  void setDepthPrepass(bool enabled = true);
+  void setPassProfiling(bool enabled = true);
+  void setTransparencyMode(TransparencyMode mode);
 
   // --- getters ---
   Camera *getActiveCamera() const;
   size_t getCameraCount() const;
-
-  void setCameraUniforms(Shader &shader) const;
+  const PassProfiler *getPassProfiler() const;
 
 private:
+  // texture unit the shadow map is bound to, after the material diffuse, specular and emissive units
+  static constexpr unsigned int SHADOW_MAP_TEXTURE_UNIT = 3;
+  // world units the camera moves before the translucent draws are sorted again
+  static constexpr double TRANSLUCENT_RESORT_DISTANCE = 1.0;
+
+  /// @brief An entity that passed culling this frame, with everything its pass draws it with
+  struct VisibleEntity
+  {
+    EntityHandle entity;
+    const glm::mat4 *model;
+    Bounds bounds; // scene space
+    Mesh *mesh;
+    Material *material;
+    bool receivesLight;
+    float distance;            // squared, to the camera
+    FaceDirections directions; // face buckets of the mesh that can face the camera
+  };
+
   Camera *activeCamera = nullptr;
   std::vector<Camera *> cameras;
+
+  bool indirectDrawing = true;
+  mutable std::unique_ptr<IndirectDrawer> indirectDrawer; // created with the first frame, the context has to exist
+  bool depthPrepass = false;
+  bool passProfiling = false;
+  mutable std::unique_ptr<PassProfiler> passProfiler; // created with the first profiled frame
+  TransparencyMode transparencyMode = TransparencyMode::Sorted;
+  mutable std::unique_ptr<WeightedBlendedTransparency> weightedBlended; // created with the first frame that uses it
+
+  // back to front order of the translucent entities, kept while the camera stays close to where it was sorted
+  mutable std::vector<EntityHandle> translucentOrder;
+  mutable glm::dvec3 translucentSortPosition = glm::dvec3(0.0);
+  mutable uint64_t translucentSetHash = 0;
+  mutable bool translucentOrderValid = false;
+
+  void uploadFrameData(const CameraSnapshot &camera) const;
+  void beginPass(RenderLayer layer) const;
+  void endPasses() const;
+  void profilePass(RenderPass pass) const;
+  void queueIndirect(Scene *scene, const CameraSnapshot &camera, std::span<const VisibleEntity> entities) const;
+  void drawDepthPrepass(const CameraSnapshot &camera, std::span<const VisibleEntity> entities, bool useIndirect) const;
+  void drawPass(Scene *scene, const CameraSnapshot &camera, std::span<const VisibleEntity> entities, bool useIndirect,
+                ShaderFeatures addedFeatures = ShaderFeature::None) const;
+  void orderTranslucent(Scene *scene, const CameraSnapshot &camera, std::pmr::vector<VisibleEntity> &entities) const;
+  FaceDirections getFacingDirections(const CameraSnapshot &camera, const glm::mat4 &model, const Mesh &mesh, RenderLayer layer) const;
+  void drawRenderable(Shader &shader, const CameraSnapshot &camera, const glm::mat4 &model, Mesh &mesh, Material &material,
+                      FaceDirections directions = ALL_FACE_DIRECTIONS) const;
+  void setLightUniforms(Shader &shader, const LightManager &lightManager, const Bounds &worldBounds) const;
 };
\ No newline at end of file
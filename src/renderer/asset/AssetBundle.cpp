@@ -0,0 +1,277 @@
+/*
+  File: AssetBundle.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "AssetBundle.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+AssetBundle::AssetBundle()
+{
+  if (std::getenv("X0V_LOOSE_ASSETS"))
+  {
+    std::cout << "[AssetBundle] X0V_LOOSE_ASSETS is set, loading loose files" << std::endl;
+    return;
+  }
+
+  if (!open(DEFAULT_PATH))
+    std::cout << "[AssetBundle] No usable bundle at " << DEFAULT_PATH << ", loading loose files" << std::endl;
+}
+
+/// @brief Map a bundle and parse its tables. Texture and shader data is not copied, it is read from the mapping on upload.
+/// @param path the bundle file
+/// @return true if the bundle is valid and open, on failure the bundle stays closed
+bool AssetBundle::open(const std::string &path)
+{
+  close();
+
+  if (!file.open(path))
+    return false;
+
+  BundleFormat::Reader reader{file.getData(), file.getSize()};
+  auto header = reader.read<BundleFormat::Header>();
+
+  if (!reader.ok || header.magic != BundleFormat::MAGIC || header.version != BundleFormat::VERSION)
+  {
+    std::cerr << "[AssetBundle] " << path << " is not a bundle of version " << BundleFormat::VERSION << ", rebuild it with the bundler" << std::endl;
+    close();
+    return false;
+  }
+
+  bool valid = true;
+  for (uint32_t i = 0; i < header.sectionCount && valid; ++i)
+  {
+    auto section = reader.read<BundleFormat::Section>();
+
+    // written so a huge offset or size can not wrap around
+    if (!reader.ok || section.size > file.getSize() || section.offset > file.getSize() - section.size)
+    {
+      valid = false;
+      break;
+    }
+
+    BundleFormat::Reader sectionReader{file.getData() + section.offset, static_cast<size_t>(section.size)};
+
+    switch (section.type)
+    {
+    case BundleFormat::BlockTable:
+      valid = parseBlockTable(sectionReader);
+      break;
+    case BundleFormat::LayerTable:
+      valid = parseLayerTable(sectionReader);
+      break;
+    case BundleFormat::TextureSet:
+      valid = parseTextureSet(sectionReader);
+      break;
+    case BundleFormat::ShaderTable:
+      valid = parseShaderTable(sectionReader);
+      break;
+    case BundleFormat::AnimationTable:
+      valid = parseAnimationTable(sectionReader);
+      break;
+    default:
+      std::cout << "[AssetBundle] Skipping unknown section type " << section.type << std::endl;
+      break;
+    }
+  }
+
+  // texture sets are uploaded with one image per layer name, sections may come in any order so this is checked last
+  for (const auto &[kind, set] : textureSets)
+    valid = valid && static_cast<size_t>(set.layerCount) == layerNames.size();
+
+  if (!valid)
+  {
+    std::cerr << "[AssetBundle] " << path << " is truncated or corrupt" << std::endl;
+    close();
+    return false;
+  }
+
+  std::cout << "[AssetBundle] Mapped " << path << " (" << file.getSize() / 1024 << " KiB, " << blocks.size() << " blocks, "
+            << layerNames.size() << " texture layers, " << shaders.size() << " shader sources)" << std::endl;
+  return true;
+}
+
+void AssetBundle::close()
+{
+  blocks.clear();
+  layerNames.clear();
+  animations.clear();
+  textureSets.clear();
+  shaders.clear();
+  file.close();
+}
+
+/// @brief Get a shader source from the bundle
+/// @param path the normalized path the source had in the assets folder, e.g. ../assets/shaders/block-shader.vert
+/// @param source receives the source
+/// @return false if the bundle is not open, does not contain the path or the content hash does not match
+bool AssetBundle::getShaderSource(const std::string &path, std::string &source) const
+{
+  auto entry = shaders.find(path);
+  if (entry == shaders.end())
+    return false;
+
+  if (BundleFormat::hash(entry->second.data, entry->second.size) != entry->second.hash)
+  {
+    std::cerr << "[AssetBundle] Content hash mismatch for " << path << ", using the loose file" << std::endl;
+    return false;
+  }
+
+  source.assign(entry->second.data, entry->second.size);
+  return true;
+}
+
+// getters
+bool AssetBundle::isOpen() const
+{
+  return file.isOpen();
+}
+
+const std::vector<std::pair<std::string, BlockType>> &AssetBundle::getBlocks() const
+{
+  return blocks;
+}
+
+const std::vector<std::string> &AssetBundle::getLayerNames() const
+{
+  return layerNames;
+}
+
+const std::vector<std::pair<std::string, TextureAnimation>> &AssetBundle::getAnimations() const
+{
+  return animations;
+}
+
+/// @return the texture set, nullptr if the bundle is not open or has no set of that kind
+const BundleTextureSet *AssetBundle::getTextureSet(BundleFormat::TextureKind kind) const
+{
+  auto set = textureSets.find(kind);
+  return set != textureSets.end() ? &set->second : nullptr;
+}
+
+// ------- private ------- //
+
+bool AssetBundle::parseBlockTable(BundleFormat::Reader reader)
+{
+  uint32_t count = reader.read<uint32_t>();
+
+  for (uint32_t i = 0; i < count && reader.ok; ++i)
+  {
+    std::string id = reader.readString();
+    std::string top = reader.readString(), bottom = reader.readString();
+    std::string north = reader.readString(), east = reader.readString();
+    std::string south = reader.readString(), west = reader.readString();
+    uint32_t shaderType = reader.read<uint32_t>();
+
+    // block materials are built from surface or light block shaders, anything else would throw in the ShaderProvider
+    if (shaderType != ShaderType::Surface && shaderType != ShaderType::LightBlock)
+      return false;
+
+    BlockType blockType(top, bottom, north, east, south, west, static_cast<ShaderType>(shaderType));
+    blockType.emit = reader.read<uint32_t>() != 0;
+    uint32_t renderLayer = reader.read<uint32_t>();
+
+    // the renderer indexes its per-layer lists with it, a corrupt or newer bundle must not get past here
+    if (renderLayer >= RENDER_LAYER_COUNT)
+      return false;
+    blockType.renderLayer = static_cast<RenderLayer>(renderLayer);
+
+    blocks.emplace_back(std::move(id), std::move(blockType));
+  }
+
+  return reader.ok;
+}
+
+bool AssetBundle::parseLayerTable(BundleFormat::Reader reader)
+{
+  uint32_t count = reader.read<uint32_t>();
+
+  for (uint32_t i = 0; i < count && reader.ok; ++i)
+    layerNames.push_back(reader.readString());
+
+  return reader.ok;
+}
+
+bool AssetBundle::parseTextureSet(BundleFormat::Reader reader)
+{
+  auto header = reader.read<BundleFormat::TextureSetHeader>();
+
+  BundleTextureSet set;
+  set.textureSize = static_cast<int>(header.textureSize);
+  set.layerCount = static_cast<int>(header.layerCount);
+  set.encoding = static_cast<TextureEncoding>(header.encoding);
+
+  if (!reader.ok || header.encoding > static_cast<uint32_t>(TextureEncoding::BC7) || header.textureSize == 0 || header.layerCount == 0 ||
+      header.textureSize > static_cast<uint32_t>(std::numeric_limits<int>::max()) || header.layerCount > static_cast<uint32_t>(std::numeric_limits<int>::max()))
+    return false;
+
+  // at least the base level and at most a full chain, larger counts would shift the size by 32 bits or more
+  uint32_t maxMipLevels = static_cast<uint32_t>(std::bit_width(header.textureSize));
+  if (header.mipLevels < 1 || header.mipLevels > maxMipLevels)
+    return false;
+
+  for (uint32_t level = 0; level < header.mipLevels && reader.ok; ++level)
+  {
+    uint64_t offset = reader.read<uint64_t>();
+    uint64_t size = reader.read<uint64_t>();
+
+    int levelSize = std::max(1, set.textureSize >> level);
+    if (size != TextureCompressor::getEncodedSize(set.encoding, levelSize, levelSize) * header.layerCount || size > reader.size || offset > reader.size - size)
+      return false;
+
+    set.mipLevels.push_back(reader.data + offset);
+  }
+
+  if (!reader.ok)
+    return false;
+
+  textureSets[header.kind] = std::move(set);
+  return true;
+}
+
+bool AssetBundle::parseShaderTable(BundleFormat::Reader reader)
+{
+  uint32_t count = reader.read<uint32_t>();
+
+  for (uint32_t i = 0; i < count && reader.ok; ++i)
+  {
+    std::string path = reader.readString();
+    uint64_t hash = reader.read<uint64_t>();
+    uint64_t offset = reader.read<uint64_t>();
+    uint64_t size = reader.read<uint64_t>();
+
+    if (size > reader.size || offset > reader.size - size)
+      return false;
+
+    shaders[path] = ShaderEntry{hash, reinterpret_cast<const char *>(reader.data + offset), static_cast<size_t>(size)};
+  }
+
+  return reader.ok;
+}
+
+bool AssetBundle::parseAnimationTable(BundleFormat::Reader reader)
+{
+  uint32_t count = reader.read<uint32_t>();
+
+  for (uint32_t i = 0; i < count && reader.ok; ++i)
+  {
+    std::string name = reader.readString();
+    TextureAnimation animation;
+    animation.frameTime = reader.read<float>();
+
+    uint32_t frameCount = reader.read<uint32_t>();
+    for (uint32_t frame = 0; frame < frameCount && reader.ok; ++frame)
+      animation.frames.push_back(reader.readString());
+
+    animations.emplace_back(std::move(name), std::move(animation));
+  }
+
+  return reader.ok;
+}
\ No newline at end of file
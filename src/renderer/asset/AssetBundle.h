@@ -0,0 +1,82 @@
+/*
+  File: AssetBundle.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "renderer/asset/BundleFormat.h"
+#include "renderer/asset/MappedFile.h"
+#include "renderer/block/BlockType.h"
+#include "renderer/texture/TextureAnimator.h"
+#include "renderer/texture/TextureCompressor.h"
+
+/// @brief Pre-mipmapped texture layers of one texture kind, pointing into the mapped bundle
+struct BundleTextureSet
+{
+  int textureSize = 0;
+  int layerCount = 0;
+  TextureEncoding encoding = TextureEncoding::RGBA8;
+  std::vector<const unsigned char *> mipLevels; // all layers of a level back to back
+};
+
+/// @brief Memory mapped asset bundle written by the bundler tool (tools/bundler).
+/// Holds the block table, pre-baked texture arrays and shader sources, so startup needs neither image decoding
+/// nor loose file reads. Without a bundle, or with X0V_LOOSE_ASSETS set, everything falls back to the files in ../assets.
+class AssetBundle
+{
+public:
+  static AssetBundle &getInstance()
+  {
+    static AssetBundle instance;
+    return instance;
+  }
+
+  AssetBundle(const AssetBundle &) = delete;
+  AssetBundle &operator=(const AssetBundle &) = delete;
+
+  bool open(const std::string &path);
+  void close();
+
+  bool getShaderSource(const std::string &path, std::string &source) const;
+
+  // getters
+  bool isOpen() const;
+  const std::vector<std::pair<std::string, BlockType>> &getBlocks() const;
+  const std::vector<std::string> &getLayerNames() const;
+  const BundleTextureSet *getTextureSet(BundleFormat::TextureKind kind) const;
+  const std::vector<std::pair<std::string, TextureAnimation>> &getAnimations() const;
+
+  static constexpr const char *DEFAULT_PATH = "../assets/x0v.bundle";
+
+private:
+  AssetBundle();
+  ~AssetBundle() = default;
+
+  struct ShaderEntry
+  {
+    uint64_t hash;
+    const char *data;
+    size_t size;
+  };
+
+  MappedFile file;
+  std::vector<std::pair<std::string, BlockType>> blocks;
+  std::vector<std::string> layerNames;
+  std::vector<std::pair<std::string, TextureAnimation>> animations;
+  std::unordered_map<uint32_t, BundleTextureSet> textureSets;
+  std::unordered_map<std::string, ShaderEntry> shaders;
+
+  bool parseBlockTable(BundleFormat::Reader reader);
+  bool parseLayerTable(BundleFormat::Reader reader);
+  bool parseTextureSet(BundleFormat::Reader reader);
+  bool parseShaderTable(BundleFormat::Reader reader);
+  bool parseAnimationTable(BundleFormat::Reader reader);
+};
\ No newline at end of file
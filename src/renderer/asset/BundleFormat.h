@@ -0,0 +1,119 @@
+/*
+  File: BundleFormat.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/// @brief On-disk layout of the asset bundle, shared by the runtime reader and the bundler tool.
+///
+/// A bundle is a header followed by a section table. Sections are 16 byte aligned, all integers little endian:
+///   BlockTable   u32 count, per block: string id, 6 strings top/bottom/north/east/south/west, u32 shader type, u32 emit,
+///                u32 render layer
+///   LayerTable   u32 count, per layer: string name, in texture array layer order
+///   TextureSet   TextureSetHeader, per mip level: u64 offset (from section start), u64 size, then the level data
+///                (all layers of a level back to back, RGBA8 or block compressed as given by the header's encoding)
+///   ShaderTable  u32 count, per source: string path, u64 content hash, u64 offset (from section start), u64 size
+///   AnimationTable  u32 count, per animated texture: string name, f32 frame time, u32 frame count, frame count strings
+/// Strings are a u32 length followed by the characters, without terminator.
+namespace BundleFormat
+{
+  constexpr uint32_t MAGIC = 0x42563058; // "X0VB"
+  constexpr uint32_t VERSION = 3;
+  constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+  enum SectionType : uint32_t
+  {
+    BlockTable = 1,
+    LayerTable = 2,
+    TextureSet = 3,
+    ShaderTable = 4,
+    AnimationTable = 5, // optional
+  };
+
+  enum TextureKind : uint32_t
+  {
+    Diffuse = 0,
+    Specular = 1,
+    Emissive = 2,
+  };
+
+  struct Header
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sectionCount;
+    uint32_t reserved;
+  };
+
+  struct Section
+  {
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  struct TextureSetHeader
+  {
+    uint32_t kind;
+    uint32_t textureSize;
+    uint32_t layerCount;
+    uint32_t mipLevels;
+    uint32_t encoding; // TextureEncoding
+  };
+
+  /// @brief 64 bit FNV-1a, the content hash of bundled shader sources
+  inline uint64_t hash(const char *data, size_t size)
+  {
+    uint64_t value = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i)
+    {
+      value ^= static_cast<unsigned char>(data[i]);
+      value *= 1099511628211ull;
+    }
+    return value;
+  }
+
+  /// @brief Bounds checked cursor over a section, every read fails softly and clears ok
+  struct Reader
+  {
+    const unsigned char *data;
+    size_t size;
+    size_t position = 0;
+    bool ok = true;
+
+    template <typename T>
+    T read()
+    {
+      T value{};
+      if (!ok || position + sizeof(T) > size)
+      {
+        ok = false;
+        return value;
+      }
+      std::memcpy(&value, data + position, sizeof(T));
+      position += sizeof(T);
+      return value;
+    }
+
+    std::string readString()
+    {
+      uint32_t length = read<uint32_t>();
+      if (!ok || position + length > size)
+      {
+        ok = false;
+        return std::string();
+      }
+      std::string value(reinterpret_cast<const char *>(data + position), length);
+      position += length;
+      return value;
+    }
+  };
+}
\ No newline at end of file
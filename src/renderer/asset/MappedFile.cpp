@@ -0,0 +1,122 @@
+/*
+  File: MappedFile.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "MappedFile.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+/// @brief Map a file into memory, replacing a previous mapping
+/// @param path the file
+/// @return true if the file is mapped, false if it does not exist, is empty or could not be mapped
+bool MappedFile::open(const std::string &path)
+{
+  close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  const void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!view)
+  {
+    std::cerr << "[MappedFile] Unable to map " << path << " (" << GetLastError() << ")" << std::endl;
+    if (mapping)
+      CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  this->fileHandle = file;
+  this->mappingHandle = mapping;
+  this->size = static_cast<size_t>(fileSize.QuadPart);
+#else
+  int file = ::open(path.c_str(), O_RDONLY);
+  if (file < 0)
+    return false;
+
+  struct stat status;
+  if (fstat(file, &status) != 0 || status.st_size == 0)
+  {
+    ::close(file);
+    return false;
+  }
+
+  void *view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+  ::close(file); // the mapping keeps the file alive
+
+  if (view == MAP_FAILED)
+  {
+    std::cerr << "[MappedFile] Unable to map " << path << std::endl;
+    return false;
+  }
+
+  this->size = static_cast<size_t>(status.st_size);
+#endif
+
+  this->data = static_cast<const unsigned char *>(view);
+  return true;
+}
+
+void MappedFile::close()
+{
+  if (!data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(data);
+  CloseHandle(static_cast<HANDLE>(mappingHandle));
+  CloseHandle(static_cast<HANDLE>(fileHandle));
+  mappingHandle = nullptr;
+  fileHandle = nullptr;
+#else
+  munmap(const_cast<unsigned char *>(data), size);
+#endif
+
+  data = nullptr;
+  size = 0;
+}
+
+// getters
+bool MappedFile::isOpen() const
+{
+  return data != nullptr;
+}
+
+const unsigned char *MappedFile::getData() const
+{
+  return data;
+}
+
+size_t MappedFile::getSize() const
+{
+  return size;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+/*
+  File: MappedFile.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/// @brief Read-only memory mapping of a whole file (MapViewOfFile on Windows, mmap elsewhere)
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool open(const std::string &path);
+  void close();
+
+  // getters
+  bool isOpen() const;
+  const unsigned char *getData() const;
+  size_t getSize() const;
+
+private:
+  const unsigned char *data = nullptr;
+  size_t size = 0;
+
+#ifdef _WIN32
+  void *fileHandle = nullptr;
+  void *mappingHandle = nullptr;
+#endif
+};
\ No newline at end of file
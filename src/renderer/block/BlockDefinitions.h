@@ -0,0 +1,89 @@
+/*
+  File: BlockDefinitions.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "renderer/block/BlockType.h"
+#include "renderer/texture/TextureAnimator.h"
+
+/// @brief The built-in blocks and their texture files. Loaded directly when running from loose files,
+/// otherwise baked into the asset bundle by the bundler tool.
+namespace BlockDefinitions
+{
+  constexpr int TEXTURE_SIZE = 16;
+
+  // layer order of the block texture arrays
+  inline const std::vector<std::string> TEXTURE_NAMES = {
+      "block_diamond_ore",
+      "block_sand",
+      "block_dirt",
+      "block_grass_top",
+      "block_grass_side",
+      "block_stone",
+      "block_lamp",
+      "block_oak_log_side",
+      "block_oak_log_top",
+  };
+
+  inline const std::unordered_map<std::string, std::string> DIFFUSE_PATHS = {
+      {"block_diamond_ore", "../assets/textures/block_diamond_ore.png"},
+      {"block_sand", "../assets/textures/block_sand.png"},
+      {"block_dirt", "../assets/textures/block_dirt.png"},
+      {"block_grass_top", "../assets/textures/block_grass_top.png"},
+      {"block_grass_side", "../assets/textures/block_grass_side.png"},
+      {"block_stone", "../assets/textures/block_stone.png"},
+      {"block_lamp", "../assets/textures/block_lamp_on.png"},
+      {"block_oak_log_side", "../assets/textures/block_oak_log.png"},
+      {"block_oak_log_top", "../assets/textures/block_oak_log_top.png"},
+  };
+
+  inline const std::unordered_map<std::string, std::string> SPECULAR_PATHS = {
+      {"block_diamond_ore", "../assets/textures/spec_block_diamond_ore.png"},
+      {"block_sand", "../assets/textures/spec_block_sand.png"},
+      {"block_dirt", "../assets/textures/spec_block_dirt.png"},
+      {"block_grass_top", "../assets/textures/spec_block_grass_top.png"},
+      {"block_grass_side", "../assets/textures/spec_block_grass_side.png"},
+      {"block_stone", "../assets/textures/spec_block_stone.png"},
+      {"block_lamp", "../assets/textures/spec_block_lamp_on.png"},
+      {"block_oak_log_side", "../assets/textures/spec_block_oak_log.png"},
+      {"block_oak_log_top", "../assets/textures/spec_block_oak_log_top.png"},
+  };
+
+  inline const std::unordered_map<std::string, std::string> EMISSIVE_PATHS = {
+      {"block_diamond_ore", "../assets/textures/emit_block_diamond_ore.png"},
+      {"block_sand", "../assets/textures/spec_block_sand.png"},
+      {"block_dirt", "../assets/textures/spec_block_dirt.png"},
+      {"block_grass_top", "../assets/textures/spec_block_grass_top.png"},
+      {"block_grass_side", "../assets/textures/spec_block_grass_side.png"},
+      {"block_stone", "../assets/textures/spec_block_stone.png"},
+      {"block_lamp", "../assets/textures/spec_block_lamp_on.png"},
+      {"block_oak_log_side", "../assets/textures/spec_block_oak_log.png"},
+      {"block_oak_log_top", "../assets/textures/spec_block_oak_log_top.png"},
+  };
+
+  // animated textures, every frame needs its own entry in TEXTURE_NAMES and the path tables, e.g.
+  //   {"block_water", {{"block_water", "block_water_1", "block_water_2", "block_water_3"}, 0.15f}}
+  inline const std::vector<std::pair<std::string, TextureAnimation>> ANIMATIONS = {};
+
+  inline std::vector<std::pair<std::string, BlockType>> getBlocks()
+  {
+    return {
+        {"x0v_block_grass", BlockType("block_grass_top", "block_dirt", "block_grass_side")},
+        {"x0v_block_oak_log", BlockType("block_oak_log_top", "block_oak_log_side")},
+        {"x0v_block_dirt", BlockType("block_dirt")},
+        {"x0v_block_diamond_ore", BlockType("block_diamond_ore", ShaderType::Surface, true)},
+        {"x0v_block_sand", BlockType("block_sand")},
+        {"x0v_block_stone", BlockType("block_stone")},
+        {"x0v_block_lamp", BlockType("block_lamp", ShaderType::LightBlock)},
+    };
+  }
+}
\ No newline at end of file
@@ -7,97 +7,141 @@
 
 #include "BlockMeshGenerator.h"
 
-uMeshPtr BlockMeshGenerator::generateBlockMesh(const BlockType &type, const TextureAtlas &atlas)
+/// @brief Build the mesh of a block. Faces reference their texture by array layer, so swapping the images of
+/// the texture arrays never requires rebuilding meshes.
+/// @param type the block type
+/// @param textures the diffuse texture array, specular and emissive arrays share its layer indices
+/// @param format the vertex format to build
+/// @return the mesh
+uMeshPtr BlockMeshGenerator::generateBlockMesh(const BlockType &type, const TextureArray &textures, BlockVertexFormat format)
 {
-  glm::vec4 topUV = atlas.getUVRegion(type.top);
-  glm::vec4 bottomUV = atlas.getUVRegion(type.bottom);
-  glm::vec4 northUV = atlas.getUVRegion(type.north);
-  glm::vec4 eastUV = atlas.getUVRegion(type.east);
-  glm::vec4 southUV = atlas.getUVRegion(type.south);
-  glm::vec4 westUV = atlas.getUVRegion(type.west);
-
-  auto frontFace = generateCubeFace(
-      glm::vec3(-0.5f, -0.5f, -0.5f),
-      glm::vec3(0.5f, -0.5f, -0.5f),
-      glm::vec3(-0.5f, 0.5f, -0.5f),
-      glm::vec3(0.5f, 0.5f, -0.5f),
-      southUV,
-      glm::vec3(0, 0, -1));
-
-  auto backFace = generateCubeFace(
-      glm::vec3(0.5f, -0.5f, 0.5f),
-      glm::vec3(-0.5f, -0.5f, 0.5f),
-      glm::vec3(0.5f, 0.5f, 0.5f),
-      glm::vec3(-0.5f, 0.5f, 0.5f),
-      northUV,
-      glm::vec3(0, 0, 1));
-
-  auto leftFace = generateCubeFace(
-      glm::vec3(-0.5f, -0.5f, 0.5f),
-      glm::vec3(-0.5f, -0.5f, -0.5f),
-      glm::vec3(-0.5f, 0.5f, 0.5f),
-      glm::vec3(-0.5f, 0.5f, -0.5f),
-      westUV,
-      glm::vec3(-1, 0, 0));
-
-  auto rightFace = generateCubeFace(
-      glm::vec3(0.5f, -0.5f, -0.5f),
-      glm::vec3(0.5f, -0.5f, 0.5f),
-      glm::vec3(0.5f, 0.5f, -0.5f),
-      glm::vec3(0.5f, 0.5f, 0.5f),
-      eastUV,
-      glm::vec3(1, 0, 0));
-
-  auto topFace = generateCubeFace(
-      glm::vec3(-0.5f, 0.5f, -0.5f),
-      glm::vec3(0.5f, 0.5f, -0.5f),
-      glm::vec3(-0.5f, 0.5f, 0.5f),
-      glm::vec3(0.5f, 0.5f, 0.5f),
-      topUV,
-      glm::vec3(0, 1, 0));
-
-  auto bottomFace = generateCubeFace(
-      glm::vec3(-0.5f, -0.5f, 0.5f),
-      glm::vec3(0.5f, -0.5f, 0.5f),
-      glm::vec3(-0.5f, -0.5f, -0.5f),
-      glm::vec3(0.5f, -0.5f, -0.5f),
-      bottomUV,
-      glm::vec3(0, -1, 0));
+  int topLayer = textures.getLayer(type.top);
+  int bottomLayer = textures.getLayer(type.bottom);
+  int northLayer = textures.getLayer(type.north);
+  int eastLayer = textures.getLayer(type.east);
+  int southLayer = textures.getLayer(type.south);
+  int westLayer = textures.getLayer(type.west);
+
+  // corners are bottom-left, bottom-right, top-left, top-right as seen from outside the face,
+  // faces are in PackedVertex::Direction order so every direction is one contiguous face bucket
+  const CubeFace faces[] = {
+      // right
+      {{0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, 0.5f}, {0.5f, 0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}, eastLayer, PackedVertex::PositiveX},
+      // left
+      {{-0.5f, -0.5f, 0.5f}, {-0.5f, -0.5f, -0.5f}, {-0.5f, 0.5f, 0.5f}, {-0.5f, 0.5f, -0.5f}, westLayer, PackedVertex::NegativeX},
+      // top
+      {{-0.5f, 0.5f, -0.5f}, {0.5f, 0.5f, -0.5f}, {-0.5f, 0.5f, 0.5f}, {0.5f, 0.5f, 0.5f}, topLayer, PackedVertex::PositiveY},
+      // bottom
+      {{-0.5f, -0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {-0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, -0.5f}, bottomLayer, PackedVertex::NegativeY},
+      // back
+      {{0.5f, -0.5f, 0.5f}, {-0.5f, -0.5f, 0.5f}, {0.5f, 0.5f, 0.5f}, {-0.5f, 0.5f, 0.5f}, northLayer, PackedVertex::PositiveZ},
+      // front
+      {{-0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, -0.5f}, {-0.5f, 0.5f, -0.5f}, {0.5f, 0.5f, -0.5f}, southLayer, PackedVertex::NegativeZ},
+  };
+
+  // one face of 6 vertices per direction, the face plane is where the direction starts facing a viewer
+  FaceBuckets buckets;
+  for (const auto &face : faces)
+  {
+    size_t axis = face.direction / 2;
+    buckets.ranges[face.direction] = MeshRange{face.direction * 6, 6};
+    buckets.planes[face.direction] = face.bottomLeft[axis];
+  }
+
+  uMeshPtr mesh;
+  if (format == BlockVertexFormat::FaceRecords)
+  {
+    // one record per face, so a bucket is one element instead of 6 vertices
+    std::vector<FaceRecord> records;
+    records.reserve(6);
+
+    for (const auto &face : faces)
+    {
+      records.push_back(FaceRecord::pack(glm::ivec3(0), static_cast<uint32_t>(face.layer), face.direction));
+      buckets.ranges[face.direction] = MeshRange{face.direction, 1};
+    }
+
+    mesh = std::make_unique<Mesh>(records);
+    mesh->setFaceBuckets(buckets);
+    return mesh;
+  }
+
+  if (format == BlockVertexFormat::Packed)
+  {
+    std::vector<PackedVertex> vertices;
+    vertices.reserve(6 * 6);
+
+    for (const auto &face : faces)
+      generatePackedCubeFace(vertices, face);
+
+    mesh = std::make_unique<Mesh>(vertices);
+    mesh->setFaceBuckets(buckets);
+    return mesh;
+  }
 
   std::vector<float> vertices;
-  vertices.insert(vertices.end(), topFace.begin(), topFace.end());
-  vertices.insert(vertices.end(), frontFace.begin(), frontFace.end());
-  vertices.insert(vertices.end(), backFace.begin(), backFace.end());
-  vertices.insert(vertices.end(), rightFace.begin(), rightFace.end());
-  vertices.insert(vertices.end(), leftFace.begin(), leftFace.end());
-  vertices.insert(vertices.end(), bottomFace.begin(), bottomFace.end());
+  vertices.reserve(6 * 6 * 9);
+
+  for (const auto &face : faces)
+    generateCubeFace(vertices, face.bottomLeft, face.bottomRight, face.topLeft, face.topRight, face.layer, getDirectionNormal(face.direction));
 
   std::vector<VertexAttribute>
       vertexAttributes = {
-          VertexAttribute(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), 0),                 // position data
-          VertexAttribute(1, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), 3 * sizeof(float)), // texcoord data
-          VertexAttribute(2, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), 5 * sizeof(float)), // normal data
+          VertexAttribute(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), 0),                 // position data
+          VertexAttribute(1, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), 3 * sizeof(float)), // texcoord data with array layer
+          VertexAttribute(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), 6 * sizeof(float)), // normal data
       };
 
-  return std::make_unique<Mesh>(vertices.data(), vertices.size(), vertexAttributes);
+  mesh = std::make_unique<Mesh>(vertices.data(), vertices.size(), vertexAttributes);
+  mesh->setFaceBuckets(buckets);
+  return mesh;
+}
+
+/// @brief Same triangle layout as generateCubeFace, in the 8 byte PackedVertex format
+/// @param vertices the face is appended to it
+void BlockMeshGenerator::generatePackedCubeFace(std::vector<PackedVertex> &vertices, const CubeFace &face)
+{
+  uint32_t layer = static_cast<uint32_t>(face.layer);
+
+  vertices.push_back(PackedVertex::pack(face.bottomLeft, {0.0f, 1.0f}, layer, face.direction));  // bottom-left
+  vertices.push_back(PackedVertex::pack(face.bottomRight, {1.0f, 1.0f}, layer, face.direction)); // bottom-right
+  vertices.push_back(PackedVertex::pack(face.topRight, {1.0f, 0.0f}, layer, face.direction));    // top-right
+  vertices.push_back(PackedVertex::pack(face.topRight, {1.0f, 0.0f}, layer, face.direction));    // top-right
+  vertices.push_back(PackedVertex::pack(face.topLeft, {0.0f, 0.0f}, layer, face.direction));     // top-left
+  vertices.push_back(PackedVertex::pack(face.bottomLeft, {0.0f, 1.0f}, layer, face.direction));  // bottom-left
+}
+
+glm::vec3 BlockMeshGenerator::getDirectionNormal(PackedVertex::Direction direction)
+{
+  static const glm::vec3 normals[] = {
+      glm::vec3(1, 0, 0), glm::vec3(-1, 0, 0),
+      glm::vec3(0, 1, 0), glm::vec3(0, -1, 0),
+      glm::vec3(0, 0, 1), glm::vec3(0, 0, -1)};
+
+  return normals[direction];
 }
 
-std::vector<float> BlockMeshGenerator::generateCubeFace(
+/// @brief Append the two triangles of a face, position, texcoord with layer and normal per vertex
+void BlockMeshGenerator::generateCubeFace(
+    std::vector<float> &vertices,
     glm::vec3 bottomLeft,
     glm::vec3 bottomRight,
     glm::vec3 topLeft,
     glm::vec3 topRight,
-    glm::vec4 uvRegion,
+    int layer,
     glm::vec3 normals)
 {
-  return {
-      bottomLeft.x, bottomLeft.y, bottomLeft.z, uvRegion.x, uvRegion.w, normals.x, normals.y, normals.z,    // bottom-left
-      bottomRight.x, bottomRight.y, bottomRight.z, uvRegion.z, uvRegion.w, normals.x, normals.y, normals.z, // bottom-right
-      topRight.x, topRight.y, topRight.z, uvRegion.z, uvRegion.y, normals.x, normals.y, normals.z,          // top-right
-      topRight.x, topRight.y, topRight.z, uvRegion.z, uvRegion.y, normals.x, normals.y, normals.z,          // top-right
-      topLeft.x, topLeft.y, topLeft.z, uvRegion.x, uvRegion.y, normals.x, normals.y, normals.z,             // top-left
-      bottomLeft.x, bottomLeft.y, bottomLeft.z, uvRegion.x, uvRegion.w, normals.x, normals.y, normals.z     // bottom-left
-  };
+  float l = static_cast<float>(layer);
+
+  // appended in place, instead of through a temporary vector per face
+  vertices.insert(vertices.end(), {
+      bottomLeft.x, bottomLeft.y, bottomLeft.z, 0.0f, 1.0f, l, normals.x, normals.y, normals.z,    // bottom-left
+      bottomRight.x, bottomRight.y, bottomRight.z, 1.0f, 1.0f, l, normals.x, normals.y, normals.z, // bottom-right
+      topRight.x, topRight.y, topRight.z, 1.0f, 0.0f, l, normals.x, normals.y, normals.z,          // top-right
+      topRight.x, topRight.y, topRight.z, 1.0f, 0.0f, l, normals.x, normals.y, normals.z,          // top-right
+      topLeft.x, topLeft.y, topLeft.z, 0.0f, 0.0f, l, normals.x, normals.y, normals.z,             // top-left
+      bottomLeft.x, bottomLeft.y, bottomLeft.z, 0.0f, 1.0f, l, normals.x, normals.y, normals.z     // bottom-left
+  });
 }
 
 uMeshPtr BlockMeshGenerator::generatePlainBlockMeshWithNormals()
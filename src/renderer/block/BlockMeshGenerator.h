@@ -12,21 +12,42 @@
 
 #include "renderer/mesh/Mesh.h"
 #include "renderer/block/BlockType.h"
-#include "renderer/texture/TextureAtlas.h"
+#include "renderer/texture/TextureArray.h"
+#include "renderer/mesh/PackedVertex.h"
+#include "renderer/mesh/FaceRecord.h"
+
+/// @brief How block meshes store their geometry, each needs the matching vertex input shader feature
+enum class BlockVertexFormat
+{
+  Float,      // 36 byte float vertices, no feature
+  Packed,     // 8 byte PackedVertex vertices, ShaderFeature::PackedVertices
+  FaceRecords // one 8 byte FaceRecord per face pulled by gl_VertexID, ShaderFeature::FacePulling
+};
 
 class BlockMeshGenerator
 {
 public:
   BlockMeshGenerator() = default;
-  uMeshPtr generateBlockMesh(const BlockType &type, const TextureAtlas &atlas);
+  uMeshPtr generateBlockMesh(const BlockType &type, const TextureArray &textures, BlockVertexFormat format = BlockVertexFormat::Float);
   uMeshPtr generatePlainBlockMeshWithNormals();
 
 private:
-  std::vector<float> generateCubeFace(
+  struct CubeFace
+  {
+    glm::vec3 bottomLeft, bottomRight, topLeft, topRight;
+    int layer;
+    PackedVertex::Direction direction;
+  };
+
+  void generatePackedCubeFace(std::vector<PackedVertex> &vertices, const CubeFace &face);
+  static glm::vec3 getDirectionNormal(PackedVertex::Direction direction);
+
+  void generateCubeFace(
+      std::vector<float> &vertices,
       glm::vec3 bottomLeft,
       glm::vec3 bottomRight,
       glm::vec3 topLeft,
       glm::vec3 topRight,
-      glm::vec4 uvRegion,
+      int layer,
       glm::vec3 normals = glm::vec3(0.0f));
 };
\ No newline at end of file
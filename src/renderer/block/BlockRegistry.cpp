@@ -7,73 +7,28 @@
 
 #include "BlockRegistry.h"
 
+#include "renderer/asset/AssetBundle.h"
+#include "renderer/indirect/IndirectDrawer.h"
+#include "renderer/memory/UploadScheduler.h"
+#include "renderer/mesh/MeshArena.h"
+
 BlockRegistry::BlockRegistry()
-    : textureAtlas(
-          std::unordered_map<std::string, std::string>{
-              {"block_diamond_ore", "../assets/textures/block_diamond_ore.png"},
-              {"block_sand", "../assets/textures/block_sand.png"},
-              {"block_dirt", "../assets/textures/block_dirt.png"},
-              {"block_grass_top", "../assets/textures/block_grass_top.png"},
-              {"block_grass_side", "../assets/textures/block_grass_side.png"},
-              {"block_stone", "../assets/textures/block_stone.png"},
-              {"block_lamp", "../assets/textures/block_lamp_on.png"},
-              {"block_oak_log_side", "../assets/textures/block_oak_log.png"},
-              {"block_oak_log_top", "../assets/textures/block_oak_log_top.png"},
-          },
-          16),
-      emissionAtlas(
-          std::unordered_map<std::string, std::string>{
-              {"block_diamond_ore", "../assets/textures/emit_block_diamond_ore.png"},
-              {"block_sand", "../assets/textures/spec_block_sand.png"},
-              {"block_dirt", "../assets/textures/spec_block_dirt.png"},
-              {"block_grass_top", "../assets/textures/spec_block_grass_top.png"},
-              {"block_grass_side", "../assets/textures/spec_block_grass_side.png"},
-              {"block_stone", "../assets/textures/spec_block_stone.png"},
-              {"block_lamp", "../assets/textures/spec_block_lamp_on.png"},
-              {"block_oak_log_side", "../assets/textures/spec_block_oak_log.png"},
-              {"block_oak_log_top", "../assets/textures/spec_block_oak_log_top.png"},
-          },
-          16),
-      specularAtlas(
-          std::unordered_map<std::string, std::string>{
-              {"block_diamond_ore", "../assets/textures/spec_block_diamond_ore.png"},
-              {"block_sand", "../assets/textures/spec_block_sand.png"},
-              {"block_dirt", "../assets/textures/spec_block_dirt.png"},
-              {"block_grass_top", "../assets/textures/spec_block_grass_top.png"},
-              {"block_grass_side", "../assets/textures/spec_block_grass_side.png"},
-              {"block_stone", "../assets/textures/spec_block_stone.png"},
-              {"block_lamp", "../assets/textures/spec_block_lamp_on.png"},
-              {"block_oak_log_side", "../assets/textures/spec_block_oak_log.png"},
-              {"block_oak_log_top", "../assets/textures/spec_block_oak_log_top.png"},
-          },
-          16),
-      atlasTexture(textureAtlas.getTextureID())
 {
-  registerBlock("x0v_block_grass", BlockType("block_grass_top", "block_dirt", "block_grass_side"));
-  registerBlock("x0v_block_oak_log", BlockType("block_oak_log_top", "block_oak_log_side"));
-  registerBlock("x0v_block_dirt", BlockType("block_dirt"));
-  registerBlock("x0v_block_diamond_ore", BlockType("block_diamond_ore", ShaderType::Surface, true));
-  registerBlock("x0v_block_sand", BlockType("block_sand"));
-  registerBlock("x0v_block_stone", BlockType("block_stone"));
-  registerBlock("x0v_block_lamp", BlockType("block_lamp", ShaderType::LightBlock));
+  created = true;
+
+  // statics are destroyed in reverse order of construction, created first they outlive the block meshes freed at exit
+  MeshArena::getInstance();
+  UploadScheduler::getInstance();
+
+  if (!loadFromBundle())
+    loadFromFiles();
 }
 
 void BlockRegistry::registerBlock(const std::string &blockId, const BlockType &blockType)
 {
   std::cout << "[BlockRegistry] Registering block " << blockId << std::endl;
 
-  auto blockMesh = meshGenerator.generateBlockMesh(blockType, textureAtlas);
-  auto &providedShader = ShaderProvider::getInstance().getShader(blockType.shaderType); // yes this little shit '&' here cost me 2 hours
-  auto blockMaterial = std::make_unique<Material>(providedShader, atlasTexture);
-  blockMaterial->setSpecularTexture(specularAtlas.getTextureID());
-  if (blockType.emit)
-  {
-    auto emissiveId = emissionAtlas.getTextureID();
-    blockMaterial->setEmissiveTexture(emissiveId);
-  }
-  auto entity = std::make_unique<RenderEntity>(std::move(blockMesh), std::move(blockMaterial));
-
-  blocks[blockId] = std::move(entity);
+  blocks[blockId] = createBlock(blockId, blockType);
 }
 
 /// @brief instead of adding a unique pointer to a block render entity, this creates a new unique entity
@@ -84,17 +39,135 @@ std::unique_ptr<RenderEntity> BlockRegistry::createBlock(const std::string &bloc
 {
   // std::cout << "[BlockRegistry] Creating block " << blockId << std::endl;
 
-  auto blockMesh = meshGenerator.generateBlockMesh(blockType, textureAtlas);
-  auto &providedShader = ShaderProvider::getInstance().getShader(blockType.shaderType); // yes this little shit '&' here cost me 2 hours
-  auto blockMaterial = std::make_unique<Material>(providedShader, atlasTexture);
-  blockMaterial->setSpecularTexture(specularAtlas.getTextureID());
+  auto blockMesh = meshGenerator.generateBlockMesh(blockType, *diffuseTextures, vertexFormat);
+  auto entity = std::make_unique<RenderEntity>(std::move(blockMesh), createMaterial(blockType));
+
+  // light blocks are drawn in their own color, light lists would be wasted on them
+  if (blockType.shaderType == ShaderType::LightBlock)
+    entity->setTags(EntityTag::ShadowCaster);
+
+  return entity;
+}
+
+/// @brief Upload the pre-baked texture arrays and register the block table of the asset bundle
+/// @return false if no bundle is open or it lacks one of the tables, nothing has been created then
+bool BlockRegistry::loadFromBundle()
+{
+  const auto &bundle = AssetBundle::getInstance();
+  if (!bundle.isOpen())
+    return false;
+
+  const auto *diffuse = bundle.getTextureSet(BundleFormat::Diffuse);
+  const auto *specular = bundle.getTextureSet(BundleFormat::Specular);
+  const auto *emissive = bundle.getTextureSet(BundleFormat::Emissive);
+  const auto &layerNames = bundle.getLayerNames();
+
+  if (!diffuse || !specular || !emissive || layerNames.empty() || bundle.getBlocks().empty())
+  {
+    std::cerr << "[BlockRegistry] Asset bundle is missing block data, loading loose files" << std::endl;
+    return false;
+  }
+
+  // the arrays upload one image per layer name from the texture set data
+  for (const auto *set : {diffuse, specular, emissive})
+  {
+    if (set->textureSize <= 0 || static_cast<size_t>(set->layerCount) != layerNames.size())
+    {
+      std::cerr << "[BlockRegistry] Asset bundle texture sets do not match its layer table, loading loose files" << std::endl;
+      return false;
+    }
+  }
+
+  std::cout << "[BlockRegistry] Loading blocks from the asset bundle" << std::endl;
+
+  diffuseTextures = std::make_unique<TextureArray>(layerNames, diffuse->textureSize, diffuse->mipLevels, diffuse->encoding);
+  specularTextures = std::make_unique<TextureArray>(layerNames, specular->textureSize, specular->mipLevels, specular->encoding);
+  emissiveTextures = std::make_unique<TextureArray>(layerNames, emissive->textureSize, emissive->mipLevels, emissive->encoding);
+  diffuseTexture = std::make_unique<Texture>(diffuseTextures->getTextureID(), GL_TEXTURE_2D_ARRAY);
+  textureAnimator = std::make_unique<TextureAnimator>(layerNames, bundle.getAnimations());
+
+  for (const auto &[blockId, blockType] : bundle.getBlocks())
+    registerBlock(blockId, blockType);
+
+  return true;
+}
+
+/// @brief Decode the block textures from ../assets and register the built-in blocks
+void BlockRegistry::loadFromFiles()
+{
+  // shared while the arrays are built, specular and emissive maps mostly use the same files
+  TextureDecoder textureDecoder;
+
+  diffuseTextures = std::make_unique<TextureArray>(BlockDefinitions::TEXTURE_NAMES, BlockDefinitions::DIFFUSE_PATHS, BlockDefinitions::TEXTURE_SIZE, &textureDecoder);
+  specularTextures = std::make_unique<TextureArray>(BlockDefinitions::TEXTURE_NAMES, BlockDefinitions::SPECULAR_PATHS, BlockDefinitions::TEXTURE_SIZE, &textureDecoder);
+  emissiveTextures = std::make_unique<TextureArray>(BlockDefinitions::TEXTURE_NAMES, BlockDefinitions::EMISSIVE_PATHS, BlockDefinitions::TEXTURE_SIZE, &textureDecoder);
+  diffuseTexture = std::make_unique<Texture>(diffuseTextures->getTextureID(), GL_TEXTURE_2D_ARRAY);
+  textureAnimator = std::make_unique<TextureAnimator>(BlockDefinitions::TEXTURE_NAMES, BlockDefinitions::ANIMATIONS);
+
+  for (const auto &[blockId, blockType] : BlockDefinitions::getBlocks())
+    registerBlock(blockId, blockType);
+}
+
+/// @brief Create the material for a block, using the shader permutation matching the maps the block actually has
+/// @param blockType the block type
+/// @return the material
+uMaterialPtr BlockRegistry::createMaterial(const BlockType &blockType)
+{
+  ShaderFeatures features = ShaderFeature::SpecularMap | ShaderFeature::LayeredTextures;
+  if (blockType.emit)
+    features |= ShaderFeature::Emissive;
+  if (vertexFormat == BlockVertexFormat::Packed)
+    features |= ShaderFeature::PackedVertices;
+  if (vertexFormat == BlockVertexFormat::FaceRecords)
+    features |= ShaderFeature::FacePulling;
+  if (blockType.renderLayer == RenderLayer::Cutout)
+    features |= ShaderFeature::AlphaTest;
+  if (blockType.renderLayer == RenderLayer::Translucent)
+    features |= ShaderFeature::AlphaBlend;
+
+  auto &providedShader = ShaderProvider::getInstance().getShader(blockType.shaderType, features); // yes this little shit '&' here cost me 2 hours
+  submitDerivedPermutations(providedShader, blockType);
+
+  auto blockMaterial = std::make_unique<Material>(providedShader, *diffuseTexture);
+  blockMaterial->setRenderLayer(blockType.renderLayer);
+  blockMaterial->setSpecularTexture(new Texture(specularTextures->getTextureID(), GL_TEXTURE_2D_ARRAY));
+  blockMaterial->setLayerFramesTexture(new Texture(textureAnimator->getTextureID(), GL_TEXTURE_BUFFER));
   if (blockType.emit)
   {
-    auto emissiveId = emissionAtlas.getTextureID();
-    blockMaterial->setEmissiveTexture(emissiveId);
+    auto emissiveId = emissiveTextures->getTextureID();
+    blockMaterial->setEmissiveTexture(new Texture(emissiveId, GL_TEXTURE_2D_ARRAY));
   }
 
-  return std::make_unique<RenderEntity>(std::move(blockMesh), std::move(blockMaterial));
+  return blockMaterial;
+}
+
+/// @brief Submit the permutations the passes derive from a block's material shader while the blocks load,
+/// so the first frames draw with them instead of their fallbacks
+/// @param shader the material shader of the block
+/// @param blockType the block type
+void BlockRegistry::submitDerivedPermutations(Shader &shader, const BlockType &blockType)
+{
+  auto &shaderProvider = ShaderProvider::getInstance();
+  ShaderFeatures vertexInput = shader.getFeatures() & VERTEX_INPUT_FEATURES;
+  bool indirect = IndirectDrawer::isSupported();
+
+  shaderProvider.getShader(ShaderType::ShadowDepth, vertexInput);
+  if (blockType.renderLayer == RenderLayer::Opaque)
+  {
+    shaderProvider.getShader(ShaderType::DepthPrepass, vertexInput);
+    if (indirect)
+      shaderProvider.getShader(ShaderType::DepthPrepass, vertexInput | ShaderFeature::IndirectDraw);
+  }
+
+  if (indirect)
+    shaderProvider.getPermutation(shader, ShaderFeature::IndirectDraw);
+
+  if (blockType.renderLayer == RenderLayer::Translucent)
+  {
+    shaderProvider.getPermutation(shader, ShaderFeature::WeightedBlend);
+    if (indirect)
+      shaderProvider.getPermutation(shader, ShaderFeature::IndirectDraw | ShaderFeature::WeightedBlend);
+  }
 }
 
 RenderEntity &BlockRegistry::getBlockRenderEntity(const std::string &id)
@@ -127,3 +200,46 @@ bool BlockRegistry::hasBlock(const std::string &blockId) const
 {
   return blocks.find(blockId) != blocks.end();
 }
+
+/// @brief Swap the images of the block textures, e.g. for a different texture pack. Meshes reference array layers,
+/// so existing blocks pick up the new images without being rebuilt.
+/// @param diffusePaths texture name to diffuse image path
+/// @param specularPaths texture name to specular image path
+/// @param emissivePaths texture name to emissive image path
+void BlockRegistry::reloadTextures(const std::unordered_map<std::string, std::string> &diffusePaths,
+                                   const std::unordered_map<std::string, std::string> &specularPaths,
+                                   const std::unordered_map<std::string, std::string> &emissivePaths)
+{
+  std::cout << "[BlockRegistry] Reloading block textures" << std::endl;
+
+  diffuseTextures->reload(diffusePaths);
+  specularTextures->reload(specularPaths);
+  emissiveTextures->reload(emissivePaths);
+}
+
+/// @brief Advance the animated block textures, call once per frame
+/// @param time seconds since start
+void BlockRegistry::updateAnimations(double time)
+{
+  textureAnimator->update(time);
+}
+
+// setters
+/// @brief Pick the vertex path of block meshes: float vertices, PackedVertex or pulled FaceRecords.
+/// Only takes effect before the first getInstance(), the blocks are built in the constructor.
+void BlockRegistry::setVertexFormat(BlockVertexFormat format)
+{
+  if (created)
+  {
+    std::cerr << "[BlockRegistry] The vertex format has to be set before the registry is created, ignoring it" << std::endl;
+    return;
+  }
+
+  vertexFormat = format;
+}
+
+// getters
+BlockVertexFormat BlockRegistry::getVertexFormat()
+{
+  return vertexFormat;
+}
@@ -11,12 +11,15 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "BlockType.h"
 #include "BlockMeshGenerator.h"
+#include "BlockDefinitions.h"
 
 #include "renderer/texture/Texture.h"
-#include "renderer/texture/TextureAtlas.h"
+#include "renderer/texture/TextureArray.h"
+#include "renderer/texture/TextureAnimator.h"
 #include "renderer/shader/Shader.h"
 #include "renderer/shader/ShaderProvider.h"
 #include "renderer/render_entity/RenderEntity.h"
@@ -42,15 +45,37 @@ public:
 
   bool hasBlock(const std::string &blockId) const;
 
+  void reloadTextures(const std::unordered_map<std::string, std::string> &diffusePaths,
+                      const std::unordered_map<std::string, std::string> &specularPaths,
+                      const std::unordered_map<std::string, std::string> &emissivePaths);
+  void updateAnimations(double time);
+
+  // setters
+  static void setVertexFormat(BlockVertexFormat format);
+
+  // getters
+  static BlockVertexFormat getVertexFormat();
+
 private:
   BlockRegistry();
   ~BlockRegistry() = default;
 
   std::unordered_map<std::string, std::unique_ptr<RenderEntity>> blocks;
 
-  TextureAtlas textureAtlas;
-  TextureAtlas specularAtlas;
-  TextureAtlas emissionAtlas;
-  Texture atlasTexture;
+  // diffuse, specular and emissive maps are parallel arrays sharing one layer order
+  std::unique_ptr<TextureArray> diffuseTextures;
+  std::unique_ptr<TextureArray> specularTextures;
+  std::unique_ptr<TextureArray> emissiveTextures;
+  std::unique_ptr<Texture> diffuseTexture; // non-owning wrapper of diffuseTextures for the block materials
+  std::unique_ptr<TextureAnimator> textureAnimator;
   BlockMeshGenerator meshGenerator;
+
+  // block meshes are built when the registry is created, so the format is chosen before that
+  static inline BlockVertexFormat vertexFormat = BlockVertexFormat::Packed; // FaceRecords pulls faces instead of fetching vertices
+  static inline bool created = false;
+
+  bool loadFromBundle();
+  void loadFromFiles();
+  uMaterialPtr createMaterial(const BlockType &blockType);
+  void submitDerivedPermutations(Shader &shader, const BlockType &blockType);
 };
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <iostream>
 
 #include "renderer/shader/ShaderType.h"
+#include "renderer/material/RenderLayer.h"
 
 struct BlockType
 {
@@ -27,6 +28,7 @@ public:
   std::string top, bottom, north, east, south, west;
   ShaderType shaderType;
   bool emit = false;
+  RenderLayer renderLayer = RenderLayer::Opaque; // cutout for alpha tested textures, translucent for blended ones
 
   void validate() const;
 };
\ No newline at end of file
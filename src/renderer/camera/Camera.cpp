@@ -20,13 +20,32 @@ Camera::Camera(float posX, float posY, float posZ, float upX, float upY, float u
 
 void Camera::SetProjectionMatrix(float fov, float aspectRatio, float nearPlane, float farPlane)
 {
+  this->fov = fov;
+  this->aspectRatio = aspectRatio;
+  this->nearPlane = nearPlane;
+  this->farPlane = farPlane;
+
   projectionMatrix = glm::mat4(1.0f);
   projectionMatrix = glm::perspective(glm::radians(fov), aspectRatio /* (scr_width / scr_height) */, nearPlane, farPlane);
 }
 
+/// @brief View matrix in absolute world space, loses precision far from the world origin. The renderer uses a
+/// CameraSnapshot instead, which renders camera relative.
 glm::mat4 Camera::GetViewMatrix()
 {
-  return BuildLookAtMatrix(Position, Position + Front, WorldUp);
+  glm::vec3 worldPosition = glm::vec3(GetWorldPosition());
+  return BuildLookAtMatrix(worldPosition, worldPosition + Front, WorldUp);
+}
+
+/// @brief View matrix of the camera placed at 0, for camera relative rendering
+glm::mat4 Camera::GetRotationMatrix() const
+{
+  return BuildLookAtMatrix(glm::vec3(0.0f), Front, WorldUp);
+}
+
+glm::dvec3 Camera::GetWorldPosition() const
+{
+  return Origin + glm::dvec3(Position);
 }
 
 glm::mat4 Camera::GetProjectionMatrix() const
@@ -39,6 +58,26 @@ glm::mat4 Camera::GetProjectionMatrix() const
   return projectionMatrix;
 }
 
+float Camera::GetFov() const
+{
+  return fov;
+}
+
+float Camera::GetAspectRatio() const
+{
+  return aspectRatio;
+}
+
+float Camera::GetNearPlane() const
+{
+  return nearPlane;
+}
+
+float Camera::GetFarPlane() const
+{
+  return farPlane;
+}
+
 void Camera::ProcessKeyboard(Camera_Movement direction, float deltaTime)
 {
   float velocity = MovementSpeed * deltaTime;
@@ -60,6 +99,8 @@ void Camera::ProcessKeyboard(Camera_Movement direction, float deltaTime)
     Position += Up * velocity;
   if (direction == Camera_Movement::DOWN)
     Position -= Up * velocity;
+
+  rebase();
 }
 
 void Camera::ProcessMouseMovement(float xOffset, float yOffset, GLboolean constrainPitch)
@@ -112,7 +153,17 @@ void Camera::updateCameraVectors()
   Up = glm::normalize(glm::cross(Right, Front));
 }
 
-glm::mat4 Camera::BuildLookAtMatrix(glm::vec3 pos, glm::vec3 target, glm::vec3 worldUp)
+// keeps the float position small, the world position does not change
+void Camera::rebase()
+{
+  if (glm::length(Position) < REBASE_DISTANCE)
+    return;
+
+  Origin += glm::dvec3(Position);
+  Position = glm::vec3(0.0f);
+}
+
+glm::mat4 Camera::BuildLookAtMatrix(glm::vec3 pos, glm::vec3 target, glm::vec3 worldUp) const
 {
   glm::vec3 z, y, x;
 
@@ -11,6 +11,7 @@ const float PITCH = -16.0f;
 const float SPEED = 6.0f;
 const float SENSITIVITY = 0.065f;
 const float ZOOM = 45.0f;
+const float REBASE_DISTANCE = 1024.0f; // Position is folded into Origin once it gets this far from it
 
 enum class Camera_Movement
 {
@@ -26,6 +27,7 @@ class Camera
 {
 public:
   // camera Attributes
+  glm::dvec3 Origin = glm::dvec3(0.0); // Position is relative to it, so the float part stays small
   glm::vec3 Position;
   glm::vec3 Front;
   glm::vec3 Up;
@@ -52,12 +54,21 @@ public:
   void SetProjectionMatrix(float fov, float aspectRatio, float nearPlane, float farPlane);
 
   glm::mat4 GetViewMatrix();
+  glm::mat4 GetRotationMatrix() const;
   glm::mat4 GetProjectionMatrix() const;
+  glm::dvec3 GetWorldPosition() const;
+
+  float GetFov() const;
+  float GetAspectRatio() const;
+  float GetNearPlane() const;
+  float GetFarPlane() const;
 
 private:
   glm::mat4 projectionMatrix = glm::mat4(1.0f);
+  float fov = ZOOM, aspectRatio = 1.0f, nearPlane = 0.1f, farPlane = 100.0f;
   void updateCameraVectors();
-  glm::mat4 BuildLookAtMatrix(glm::vec3 pos, glm::vec3 target, glm::vec3 worldUp);
+  void rebase();
+  glm::mat4 BuildLookAtMatrix(glm::vec3 pos, glm::vec3 target, glm::vec3 worldUp) const;
 
   bool yFlying = false;
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+  File: CameraSnapshot.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "CameraSnapshot.h"
+
+/// @brief Capture the camera for one frame
+/// @param camera the camera
+/// @param sceneOrigin world position of the origin of the scene being rendered
+CameraSnapshot::CameraSnapshot(const Camera &camera, const glm::dvec3 &sceneOrigin)
+{
+  worldPosition = camera.GetWorldPosition();
+  // subtract in double, the difference is small around the camera and fits a float again
+  sceneOffset = glm::vec3(sceneOrigin - worldPosition);
+  scenePosition = -sceneOffset;
+  front = camera.Front;
+
+  fov = camera.GetFov();
+  aspectRatio = camera.GetAspectRatio();
+  nearPlane = camera.GetNearPlane();
+  farPlane = camera.GetFarPlane();
+
+  view = camera.GetRotationMatrix();
+  projection = camera.GetProjectionMatrix();
+  viewProjection = projection * view;
+  inverseView = glm::transpose(view); // pure rotation
+  inverseProjection = glm::inverse(projection);
+  inverseViewProjection = inverseView * inverseProjection;
+
+  sceneView = view;
+  sceneView[3] = view * glm::vec4(sceneOffset, 1.0f);
+
+  // planes from the rows of the view projection matrix (Gribb & Hartmann): left, right, bottom, top, near, far
+  glm::vec4 rows[4];
+  for (int i = 0; i < 4; ++i)
+    rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+  frustumPlanes = {rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1],
+                   rows[3] - rows[1], rows[3] + rows[2], rows[3] - rows[2]};
+
+  for (auto &plane : frustumPlanes)
+    plane /= glm::length(glm::vec3(plane));
+}
+
+/// @brief Move a scene space model matrix into camera relative space
+/// @param model model matrix relative to the scene origin
+/// @return the matrix to draw with
+glm::mat4 CameraSnapshot::getRelativeModel(const glm::mat4 &model) const
+{
+  glm::mat4 relative = model;
+  relative[3] += glm::vec4(sceneOffset, 0.0f);
+  return relative;
+}
+
+/// @brief Conservative frustum test
+/// @param relativeCenter sphere center in camera relative space
+/// @param radius sphere radius
+/// @return false only if the sphere is entirely outside of one plane
+bool CameraSnapshot::isSphereVisible(const glm::vec3 &relativeCenter, float radius) const
+{
+  for (const auto &plane : frustumPlanes)
+  {
+    if (glm::dot(glm::vec3(plane), relativeCenter) + plane.w < -radius)
+      return false;
+  }
+
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+/*
+  File: CameraSnapshot.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+
+#include "renderer/camera/Camera.h"
+
+/// @brief Everything a frame needs from the camera, computed once when the frame starts.
+///
+/// Rendering is camera relative: the view matrix only rotates, and geometry is moved by the offset between the
+/// double precision origin of its scene and the double precision camera position. Only that small offset ever
+/// reaches float math, so precision does not degrade far away from the world origin and no vertex needs doubles.
+struct CameraSnapshot
+{
+  CameraSnapshot(const Camera &camera, const glm::dvec3 &sceneOrigin = glm::dvec3(0.0));
+
+  glm::mat4 view;       // rotation only, the camera sits at 0
+  glm::mat4 projection;
+  glm::mat4 viewProjection;
+  glm::mat4 inverseView;
+  glm::mat4 inverseProjection;
+  glm::mat4 inverseViewProjection;
+  glm::mat4 sceneView; // view of scene space positions, for data that is not moved on the CPU, e.g. lights
+
+  std::array<glm::vec4, 6> frustumPlanes; // camera relative, normalized, pointing inwards
+
+  glm::dvec3 worldPosition;
+  glm::vec3 scenePosition;  // camera in the space of the scene, relative to its origin
+  glm::vec3 sceneOffset;    // scene space to camera relative space, -scenePosition
+  glm::vec3 front;
+
+  float fov, aspectRatio, nearPlane, farPlane;
+
+  glm::mat4 getRelativeModel(const glm::mat4 &model) const;
+  bool isSphereVisible(const glm::vec3 &relativeCenter, float radius) const;
+};
\ No newline at end of file
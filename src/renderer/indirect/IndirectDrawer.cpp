@@ -0,0 +1,278 @@
+/*
+  File: IndirectDrawer.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "IndirectDrawer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+#include "renderer/shader/ShaderProvider.h"
+
+IndirectDrawer::IndirectDrawer()
+{
+  glGenBuffers(1, &drawIdBuffer);
+
+  std::cout << "[IndirectDrawer] Using multi draw indirect submission" << std::endl;
+}
+
+IndirectDrawer::~IndirectDrawer()
+{
+  glDeleteBuffers(1, &drawIdBuffer);
+}
+
+/// @brief Whether the context can run the indirect path: multi draw indirect, storage buffers and GLSL 430
+bool IndirectDrawer::isSupported()
+{
+  return GLAD_GL_VERSION_4_3;
+}
+
+/// @brief Forget the draws of the last frame
+void IndirectDrawer::begin()
+{
+  batches.clear();
+  draws.clear();
+  drawBatches.clear();
+  drawMeshes.clear();
+  drawRangeStarts.clear();
+  ranges.clear();
+  lightIndices.clear();
+  lastBatch = 0;
+  uploaded = false;
+}
+
+/// @brief Queue a mesh for the next submit
+/// @param material material the mesh is drawn with, its shader's indirect draw permutation is used
+/// @param mesh mesh in the arena
+/// @param meshRanges parts of the mesh to draw, e.g. its face directions that can face the camera
+/// @param relativeModel camera relative model matrix
+/// @param dirLights indices of the directional lights reaching the entity
+/// @param pointLights indices of the point lights reaching the entity
+/// @param spotLights indices of the spot lights reaching the entity
+void IndirectDrawer::add(Material &material, MeshHandle mesh, std::span<const MeshRange> meshRanges, const glm::mat4 &relativeModel,
+                         std::span<const int> dirLights, std::span<const int> pointLights, std::span<const int> spotLights)
+{
+  if (meshRanges.empty())
+    return;
+
+  const auto &allocation = MeshArena::getInstance().getAllocation(mesh);
+  uint32_t batch = findBatch(material, allocation.page, allocation.indexCount > 0);
+  batches[batch].commandCount += static_cast<uint32_t>(meshRanges.size());
+
+  draws.push_back(DrawData{relativeModel, static_cast<int32_t>(lightIndices.size()), static_cast<int32_t>(dirLights.size()),
+                           static_cast<int32_t>(pointLights.size()), static_cast<int32_t>(spotLights.size())});
+  drawBatches.push_back(batch);
+  drawMeshes.push_back(mesh);
+  drawRangeStarts.push_back(static_cast<uint32_t>(ranges.size()));
+  ranges.insert(ranges.end(), meshRanges.begin(), meshRanges.end());
+
+  lightIndices.insert(lightIndices.end(), dirLights.begin(), dirLights.end());
+  lightIndices.insert(lightIndices.end(), pointLights.begin(), pointLights.end());
+  lightIndices.insert(lightIndices.end(), spotLights.begin(), spotLights.end());
+}
+
+/// @brief Upload the queued draws and issue one multi draw per batch, the FrameData block has to be bound
+/// @param addedFeatures drawn with this permutation of the material shaders, e.g. WeightedBlend
+void IndirectDrawer::submit(ShaderFeatures addedFeatures)
+{
+  if (draws.empty())
+    return;
+
+  uploadDraws();
+
+  auto &shaderProvider = ShaderProvider::getInstance();
+  auto &meshArena = MeshArena::getInstance();
+
+  for (const auto &batch : batches)
+  {
+    Shader &shader = shaderProvider.resolve(shaderProvider.getPermutation(batch.material->getShader(), ShaderFeature::IndirectDraw | addedFeatures));
+    shader.use();
+
+    batch.material->bind(shader);
+    meshArena.bindPage(batch.page);
+
+    const void *indirect = reinterpret_cast<const void *>(commandRange.offset + batch.commandOffset);
+    if (batch.indexed)
+      glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, indirect, batch.commandCount, 0);
+    else
+      glMultiDrawArraysIndirect(GL_TRIANGLES, indirect, batch.commandCount, 0);
+
+    batch.material->unbind();
+  }
+
+  meshArena.unbind();
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+/// @brief Draw the collected draws depth only, without binding any material state. The draws are uploaded once,
+/// a submit() after this reuses them.
+/// @param depthType depth only shader type, its indirect permutation with the vertex input of each batch is used
+void IndirectDrawer::submitDepth(ShaderType depthType)
+{
+  if (draws.empty())
+    return;
+
+  uploadDraws();
+
+  auto &meshArena = MeshArena::getInstance();
+  auto &shaderProvider = ShaderProvider::getInstance();
+  Shader *boundShader = nullptr;
+
+  for (const auto &batch : batches)
+  {
+    ShaderFeatures vertexInput = batch.material->getShader().getFeatures() & VERTEX_INPUT_FEATURES;
+    Shader &shader = shaderProvider.resolve(shaderProvider.getShader(depthType, vertexInput | ShaderFeature::IndirectDraw));
+    if (&shader != boundShader)
+    {
+      shader.use();
+      boundShader = &shader;
+    }
+
+    meshArena.bindPage(batch.page);
+
+    const void *indirect = reinterpret_cast<const void *>(commandRange.offset + batch.commandOffset);
+    if (batch.indexed)
+      glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, indirect, batch.commandCount, 0);
+    else
+      glMultiDrawArraysIndirect(GL_TRIANGLES, indirect, batch.commandCount, 0);
+  }
+
+  meshArena.unbind();
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+// getters
+size_t IndirectDrawer::getDrawCount() const
+{
+  return draws.size();
+}
+
+size_t IndirectDrawer::getBatchCount() const
+{
+  return batches.size();
+}
+
+// ------- private ------- //
+
+uint32_t IndirectDrawer::findBatch(Material &material, uint32_t page, bool indexed)
+{
+  auto matches = [&](const Batch &batch)
+  {
+    return batch.page == page && batch.indexed == indexed &&
+           (batch.material == &material || batch.material->bindsSameAs(material));
+  };
+
+  // entities of an archetype are mostly drawn with the same material, try the previous batch first
+  if (lastBatch < batches.size() && matches(batches[lastBatch]))
+    return lastBatch;
+
+  auto found = std::find_if(batches.begin(), batches.end(), matches);
+  if (found != batches.end())
+    return lastBatch = static_cast<uint32_t>(found - batches.begin());
+
+  batches.push_back(Batch{&material, page, indexed});
+  return lastBatch = static_cast<uint32_t>(batches.size() - 1);
+}
+
+/// @brief Lay out the commands of every batch consecutively in the upload ring, in the order the draws were added.
+/// Each command draws one instance starting at the index of its draw, which is how the shaders find their DrawData.
+/// @return the committed command range
+UploadAllocation IndirectDrawer::writeCommands()
+{
+  size_t offset = 0;
+  for (auto &batch : batches)
+  {
+    batch.commandOffset = offset;
+    offset += batch.commandCount * (batch.indexed ? sizeof(DrawElementsIndirectCommand) : sizeof(DrawArraysIndirectCommand));
+  }
+
+  UploadAllocation commands = UploadRing::getInstance().allocate(offset, sizeof(uint32_t));
+  batchCursors.assign(batches.size(), 0);
+
+  const auto &meshArena = MeshArena::getInstance();
+
+  for (uint32_t draw = 0; draw < draws.size(); ++draw)
+  {
+    const auto &batch = batches[drawBatches[draw]];
+    const auto &allocation = meshArena.getAllocation(drawMeshes[draw]);
+    size_t rangeEnd = draw + 1 < draws.size() ? drawRangeStarts[draw + 1] : ranges.size();
+
+    for (size_t i = drawRangeStarts[draw]; i < rangeEnd; ++i)
+    {
+      const MeshRange &range = ranges[i];
+      uint32_t slot = batchCursors[drawBatches[draw]]++;
+
+      if (batch.indexed)
+      {
+        DrawElementsIndirectCommand command{range.count, 1, allocation.firstIndex + range.first, static_cast<int32_t>(allocation.firstVertex), draw};
+        std::memcpy(commands.data + batch.commandOffset + slot * sizeof(command), &command, sizeof(command));
+      }
+      else
+      {
+        // pulled records expand to several vertices each, gl_VertexID then indexes the record
+        DrawArraysIndirectCommand command{range.count * allocation.verticesPerElement, 1,
+                                          (allocation.firstVertex + range.first) * allocation.verticesPerElement, draw};
+        std::memcpy(commands.data + batch.commandOffset + slot * sizeof(command), &command, sizeof(command));
+      }
+    }
+  }
+
+  UploadRing::getInstance().commit(commands);
+  return commands;
+}
+
+/// @brief Upload data through the ring and bind the range to a storage buffer binding point
+UploadAllocation IndirectDrawer::uploadStorage(const void *data, size_t bytes)
+{
+  auto &uploadRing = UploadRing::getInstance();
+
+  // empty ranges can't be bound, an empty light list still gets one element
+  auto allocation = uploadRing.allocate(std::max(bytes, sizeof(int)), uploadRing.getStorageAlignment());
+  if (bytes > 0)
+    std::memcpy(allocation.data, data, bytes);
+  uploadRing.commit(allocation);
+
+  return allocation;
+}
+
+/// @brief Stream the draws, light lists and commands once per begin() and bind them
+void IndirectDrawer::uploadDraws()
+{
+  if (!uploaded)
+  {
+    reserveDrawIds(draws.size());
+
+    drawRange = uploadStorage(draws.data(), draws.size() * sizeof(DrawData));
+    lightRange = uploadStorage(lightIndices.data(), lightIndices.size() * sizeof(int));
+    commandRange = writeCommands();
+    uploaded = true;
+  }
+
+  // binding points are fixed in draw-data.glsl
+  glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, drawRange.buffer, drawRange.offset, drawRange.size);
+  glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 1, lightRange.buffer, lightRange.offset, lightRange.size);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandRange.buffer);
+}
+
+/// @brief Grow the buffer of ascending draw ids the mesh arena pages read the per instance draw id from
+void IndirectDrawer::reserveDrawIds(size_t count)
+{
+  if (count <= drawIdCount)
+    return;
+
+  drawIdCount = std::max<size_t>(1024, count + count / 2);
+
+  std::vector<GLuint> ids(drawIdCount);
+  std::iota(ids.begin(), ids.end(), 0u);
+
+  glBindBuffer(GL_ARRAY_BUFFER, drawIdBuffer);
+  glBufferData(GL_ARRAY_BUFFER, ids.size() * sizeof(GLuint), ids.data(), GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  MeshArena::getInstance().setDrawIdBuffer(drawIdBuffer);
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+/*
+  File: IndirectDrawer.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "renderer/material/Material.h"
+#include "renderer/mesh/MeshArena.h"
+#include "renderer/memory/UploadRing.h"
+#include "renderer/shader/ShaderType.h"
+
+/// @brief Per draw data of the indirect path, laid out to match draw-data.glsl (std430)
+struct DrawData
+{
+  glm::mat4 model; // camera relative
+  int32_t firstLightIndex;
+  int32_t dirLightCount;
+  int32_t pointLightCount;
+  int32_t spotLightCount;
+};
+
+static_assert(sizeof(DrawData) == 80, "DrawData has to match the std430 layout of draw-data.glsl");
+
+// command layouts read by glMultiDrawArraysIndirect and glMultiDrawElementsIndirect
+struct DrawArraysIndirectCommand
+{
+  uint32_t count, instanceCount, first, baseInstance;
+};
+
+struct DrawElementsIndirectCommand
+{
+  uint32_t count, instanceCount, firstIndex;
+  int32_t baseVertex;
+  uint32_t baseInstance;
+};
+
+/// @brief Submits the visible entities with one multi draw indirect call per batch of draws that bind the same
+/// material state and mesh arena page, instead of one draw call with its own uniforms per entity.
+/// Model matrices, light lists and the commands of all draws are streamed through the upload ring, the shaders
+/// index the storage buffer ranges with the draw id.
+///
+/// Needs a 4.3 context, the renderer falls back to per entity draws if isSupported() is false.
+class IndirectDrawer
+{
+public:
+  IndirectDrawer();
+  ~IndirectDrawer();
+
+  IndirectDrawer(const IndirectDrawer &) = delete;
+  IndirectDrawer &operator=(const IndirectDrawer &) = delete;
+
+  static bool isSupported();
+
+  void begin();
+  void add(Material &material, MeshHandle mesh, std::span<const MeshRange> ranges, const glm::mat4 &relativeModel,
+           std::span<const int> dirLights, std::span<const int> pointLights, std::span<const int> spotLights);
+  void submit(ShaderFeatures addedFeatures = ShaderFeature::None);
+  void submitDepth(ShaderType depthType);
+
+  // getters
+  size_t getDrawCount() const;
+  size_t getBatchCount() const;
+
+private:
+  struct Batch
+  {
+    Material *material;
+    uint32_t page;
+    bool indexed;
+    uint32_t commandCount = 0; // one per mesh range, the ranges of a draw share its draw id
+    size_t commandOffset = 0;  // bytes into the command range
+  };
+
+  // cleared every frame but never shrunk, steady state frames don't allocate
+  std::vector<Batch> batches;
+  std::vector<DrawData> draws;
+  std::vector<uint32_t> drawBatches; // batch index of every draw
+  std::vector<MeshHandle> drawMeshes;
+  std::vector<uint32_t> drawRangeStarts; // first range of every draw, the next draw's start ends it
+  std::vector<MeshRange> ranges;
+  std::vector<int> lightIndices;
+  std::vector<uint32_t> batchCursors;
+  uint32_t lastBatch = 0;
+
+  // streamed once per begin(), shared by the depth pre-pass and the main pass
+  bool uploaded = false;
+  UploadAllocation drawRange, lightRange, commandRange;
+
+  unsigned int drawIdBuffer = 0;
+  size_t drawIdCount = 0;
+
+  uint32_t findBatch(Material &material, uint32_t page, bool indexed);
+  UploadAllocation writeCommands();
+  UploadAllocation uploadStorage(const void *data, size_t bytes);
+  void uploadDraws();
+  void reserveDrawIds(size_t count);
+};
\ No newline at end of file
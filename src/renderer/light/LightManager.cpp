@@ -9,14 +9,17 @@
 
 #include <numeric>
 
+#include "renderer/memory/UploadRing.h"
+#include "renderer/shader/UniformBlocks.h"
+
 LightManager::LightManager()
 {
-    initializeUBO();
 }
 
-void LightManager::updateUBO(Camera &activeCamera)
+void LightManager::updateUBO(const CameraSnapshot &camera)
 {
-    glm::mat4 viewMatrix = activeCamera.GetViewMatrix();
+    // lights are in scene space, the shaders light in camera relative view space
+    const glm::mat4 &viewMatrix = camera.sceneView;
 
     LightData lightData;
     lightData.numDirectionalLights = directionalLights.size();
@@ -57,14 +60,10 @@ void LightManager::updateUBO(Camera &activeCamera)
         lightData.spotLights[i].outerCutOff = spotLights[i].outerCutOff;
     }
 
-    glBindBuffer(GL_UNIFORM_BUFFER, lightUBO);
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightData), &lightData);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
-    LightData debugData;
-    glBindBuffer(GL_UNIFORM_BUFFER, lightUBO);
-    glGetBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightData), &debugData);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    // a fresh range of the upload ring every frame, the GPU may still be reading the last ones
+    auto &uploadRing = UploadRing::getInstance();
+    auto allocation = uploadRing.upload(&lightData, sizeof(LightData), uploadRing.getUniformAlignment());
+    glBindBufferRange(GL_UNIFORM_BUFFER, UniformBlockBinding::LightDataBinding, allocation.buffer, allocation.offset, sizeof(LightData));
 }
 
 void LightManager::addDirectionalLight(const DirectionalLight &light)
@@ -139,20 +138,39 @@ std::span<const SpotLight> LightManager::getSpotLights() const
     return std::span<const SpotLight>(this->spotLights.data(), this->spotLights.size());
 }
 
-std::vector<int> LightManager::getApplicableDirLights(const RenderEntity &entity) const
+std::pmr::vector<int> LightManager::getApplicableDirLights(const RenderEntity &entity, std::pmr::memory_resource *resource) const
+{
+    return getApplicableDirLights(entity.getBounds().transformed(entity.getTransform().getModelMatrix()), resource);
+}
+
+std::pmr::vector<int> LightManager::getApplicablePointLights(const RenderEntity &entity, std::pmr::memory_resource *resource) const
+{
+    return getApplicablePointLights(entity.getBounds().transformed(entity.getTransform().getModelMatrix()), resource);
+}
+
+std::pmr::vector<int> LightManager::getApplicableSpotLights(const RenderEntity &entity, std::pmr::memory_resource *resource) const
 {
-    std::vector<int> indices(directionalLights.size());
+    return getApplicableSpotLights(entity.getBounds().transformed(entity.getTransform().getModelMatrix()), resource);
+}
+
+std::pmr::vector<int> LightManager::getApplicableDirLights(const Bounds &worldBounds, std::pmr::memory_resource *resource) const
+{
+    std::pmr::vector<int> indices(directionalLights.size(), resource);
     std::iota(indices.begin(), indices.end(), 0);
     return indices;
 }
 
-std::vector<int> LightManager::getApplicablePointLights(const RenderEntity &entity) const
+/// @brief Point lights whose sphere of influence touches the bounds
+/// @param worldBounds bounding sphere in world space
+/// @param resource memory for the list
+/// @return indices into the light UBO
+std::pmr::vector<int> LightManager::getApplicablePointLights(const Bounds &worldBounds, std::pmr::memory_resource *resource) const
 {
-    std::vector<int> applicableLights;
+    std::pmr::vector<int> applicableLights(resource);
 
     for (size_t i = 0; i < pointLights.size(); ++i)
     {
-        if (pointLightAffectsEntity(i, entity))
+        if (pointLightAffects(i, worldBounds))
         {
             applicableLights.push_back(static_cast<int>(i));
         }
@@ -161,27 +179,16 @@ std::vector<int> LightManager::getApplicablePointLights(const RenderEntity &enti
     return applicableLights;
 }
 
-std::vector<int> LightManager::getApplicableSpotLights(const RenderEntity &entity) const
+std::pmr::vector<int> LightManager::getApplicableSpotLights(const Bounds &worldBounds, std::pmr::memory_resource *resource) const
 {
     // TODO: return only applicable spot lights
-    std::vector<int> indices(spotLights.size());
+    std::pmr::vector<int> indices(spotLights.size(), resource);
     std::iota(indices.begin(), indices.end(), 0);
     return indices;
 }
 
 // ------- private ------- //
 
-void LightManager::initializeUBO()
-{
-    glGenBuffers(1, &lightUBO);
-    glBindBuffer(GL_UNIFORM_BUFFER, lightUBO);
-
-    glBufferData(GL_UNIFORM_BUFFER, sizeof(LightData), nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 0, lightUBO);
-
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
-}
-
 float LightManager::getPointLightSphereOfInfluence(const PointLight &light, float threshold) const
 {
     float C = light.constant - (1.0f / threshold);
@@ -199,22 +206,21 @@ float LightManager::getPointLightSphereOfInfluence(const PointLight &light, floa
     return d;
 }
 
-bool LightManager::pointLightAffectsEntity(size_t index, const RenderEntity &entity) const
+bool LightManager::pointLightAffects(size_t index, const Bounds &worldBounds) const
 {
     float pointLightRadius = pointLightInfluenceRadii[index];
 
     auto lightPosition = pointLights[index].position;
-    auto entityPosition = entity.getTransform().getPosition();
 
-    float distance = glm::distance(lightPosition, entityPosition);
+    float distance = glm::distance(lightPosition, worldBounds.center);
 
-    return distance <= pointLightRadius;
+    return distance <= pointLightRadius + worldBounds.radius;
 }
 
-bool LightManager::spotLightAffectsEntity(size_t nice, const RenderEntity &entity) const
+bool LightManager::spotLightAffects(size_t index, const Bounds &worldBounds) const
 {
     // TODO: implement spotlight culling
     // cache cone values and update when spotlights get updates
-    // check if the entity intersects with the area of effect from its transform
+    // check if the bounds intersect with the area of effect
     return false;
 }
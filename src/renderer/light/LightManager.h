@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <memory_resource>
 #include <span>
 #include <vector>
 #include <glm/glm.hpp>
@@ -17,14 +18,14 @@
 #include "renderer/light/lights/PointLight.h"
 #include "renderer/light/lights/SpotLight.h"
 #include "renderer/light/LightData.h"
-#include "renderer/camera/Camera.h"
+#include "renderer/camera/CameraSnapshot.h"
 
 class LightManager
 {
 public:
   LightManager();
 
-  void updateUBO(Camera &activeCamera);
+  void updateUBO(const CameraSnapshot &camera);
 
   void addDirectionalLight(const DirectionalLight &light);
   void addPointLight(const PointLight &light);
@@ -38,24 +39,25 @@ public:
   std::span<const PointLight> getPointLights() const;
   std::span<const SpotLight> getSpotLights() const;
 
-  std::vector<int> getApplicableDirLights(const RenderEntity &entity) const;
-  std::vector<int> getApplicablePointLights(const RenderEntity &entity) const;
-  std::vector<int> getApplicableSpotLights(const RenderEntity &entity) const;
+  // lists are allocated from the given resource, pass the frame arena for per-frame lookups
+  std::pmr::vector<int> getApplicableDirLights(const RenderEntity &entity, std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const;
+  std::pmr::vector<int> getApplicablePointLights(const RenderEntity &entity, std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const;
+  std::pmr::vector<int> getApplicableSpotLights(const RenderEntity &entity, std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const;
+  std::pmr::vector<int> getApplicableDirLights(const Bounds &worldBounds, std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const;
+  std::pmr::vector<int> getApplicablePointLights(const Bounds &worldBounds, std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const;
+  std::pmr::vector<int> getApplicableSpotLights(const Bounds &worldBounds, std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const;
 
   void recalculateAllPointLightRadii();
 
 private:
-  unsigned int lightUBO;
-
   std::vector<DirectionalLight> directionalLights;
   std::vector<PointLight> pointLights;
   std::vector<SpotLight> spotLights;
 
   std::vector<float> pointLightInfluenceRadii;
 
-  void initializeUBO();
   float getPointLightSphereOfInfluence(const PointLight &light, float threshold = .01f) const;
 
-  bool pointLightAffectsEntity(size_t index, const RenderEntity &entity) const;
-  bool spotLightAffectsEntity(size_t, const RenderEntity &entity) const;
+  bool pointLightAffects(size_t index, const Bounds &worldBounds) const;
+  bool spotLightAffects(size_t index, const Bounds &worldBounds) const;
 };
\ No newline at end of file
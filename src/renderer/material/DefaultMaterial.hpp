@@ -5,6 +5,7 @@
 
 #include "renderer/material/Material.h"
 #include "renderer/shader/Shader.h"
+#include "renderer/shader/ShaderProvider.h"
 #include "renderer/texture/Texture.h"
 
 class DefaultMaterial
@@ -13,7 +14,8 @@ public:
   static Material &getDefaultMaterial()
   {
 
-    static Shader shader("../assets/shaders/block-shader.vert", "../assets/shaders/surface-shader.frag");
+    // share the provider's surface program instead of compiling the same sources a second time
+    static Shader &shader = ShaderProvider::getInstance().getShader(ShaderType::Surface);
     static Texture texture("../resources/textures/default_texture.png", GL_RGBA);
 
     texture.setWrappingMode(GL_MIRRORED_REPEAT, GL_MIRRORED_REPEAT);
@@ -17,9 +17,20 @@ Material::~Material()
     // std::cout << "[Material] Destructor invoked, deleting emissive texture" << std::endl;
     delete emissiveTexture;
   }
+  if (layerFramesTexture)
+  {
+    delete layerFramesTexture;
+  }
 }
 
 void Material::bind() const
+{
+  bind(shader);
+}
+
+/// @brief Bind the material's textures and properties to a program, which may be a fallback for the material's own shader
+/// @param shader the program to bind the material to
+void Material::bind(Shader &shader) const
 {
   shader.use();
 
@@ -70,6 +81,13 @@ void Material::bind() const
 #endif
   }
 
+  // unit 3 is taken by the shadow map
+  if (layerFramesTexture)
+  {
+    layerFramesTexture->bind(4);
+    shader.setInt("layerFrames", 4);
+  }
+
   shader.setFloat("material.shininess", shininess);
 }
 
@@ -84,6 +102,24 @@ void Material::unbind() const
   {
     emissiveTexture->unbind();
   }
+  if (layerFramesTexture)
+  {
+    layerFramesTexture->unbind();
+  }
+}
+
+/// @brief Whether binding the other material results in the same state, so draws of both can be batched.
+/// Block materials are created per block but mostly share their shader and texture arrays.
+bool Material::bindsSameAs(const Material &other) const
+{
+  auto sameTexture = [](const Texture *a, const Texture *b)
+  {
+    return a == b || (a && b && a->getTextureId() == b->getTextureId());
+  };
+
+  return &shader == &other.shader && shininess == other.shininess && renderLayer == other.renderLayer &&
+         sameTexture(&diffuseTexture, &other.diffuseTexture) && sameTexture(specularTexture, other.specularTexture) &&
+         sameTexture(emissiveTexture, other.emissiveTexture) && sameTexture(layerFramesTexture, other.layerFramesTexture);
 }
 
 Shader &Material::getShader() const
@@ -91,11 +127,23 @@ Shader &Material::getShader() const
   return shader;
 }
 
+RenderLayer Material::getRenderLayer() const
+{
+  return renderLayer;
+}
+
 void Material::setShininess(float shininess)
 {
   this->shininess = shininess;
 }
 
+/// @brief Pick the pass the material is drawn in. The shader should be a permutation with the matching alpha
+/// feature, AlphaTest for cutout and AlphaBlend for translucent materials.
+void Material::setRenderLayer(RenderLayer layer)
+{
+  renderLayer = layer;
+}
+
 void Material::setShader(Shader &shader)
 {
   this->shader = shader;
@@ -132,3 +180,21 @@ void Material::setEmissiveTexture(unsigned int textureId)
   }
   this->emissiveTexture = new Texture(textureId);
 }
+
+void Material::setEmissiveTexture(Texture *texture)
+{
+  if (emissiveTexture)
+  {
+    delete emissiveTexture;
+  }
+  this->emissiveTexture = texture;
+}
+
+void Material::setLayerFramesTexture(Texture *texture)
+{
+  if (layerFramesTexture)
+  {
+    delete layerFramesTexture;
+  }
+  this->layerFramesTexture = texture;
+}
@@ -6,6 +6,7 @@
 #include "renderer/shader/Shader.h"
 #include "renderer/texture/Texture.h"
 #include "renderer/color/Color.h"
+#include "renderer/material/RenderLayer.h"
 
 class Material
 {
@@ -14,10 +15,14 @@ public:
   ~Material();
 
   void bind() const;
+  void bind(Shader &program) const;
   void unbind() const;
 
+  bool bindsSameAs(const Material &other) const;
+
   // getters
   Shader &getShader() const;
+  RenderLayer getRenderLayer() const;
 
   // setters
   void setShininess(float shininess);
@@ -26,6 +31,9 @@ public:
   void setSpecularTexture(Texture *texture);
   void setSpecularTexture(unsigned int textureId);
   void setEmissiveTexture(unsigned int textureId);
+  void setEmissiveTexture(Texture *texture);
+  void setLayerFramesTexture(Texture *texture);
+  void setRenderLayer(RenderLayer layer);
 
 private:
   Shader &shader;
@@ -34,6 +42,8 @@ private:
   glm::vec3 specularColor;
   Texture *specularTexture;
   Texture *emissiveTexture;
+  Texture *layerFramesTexture = nullptr; // animation frame table of layered materials
+  RenderLayer renderLayer = RenderLayer::Opaque;
   // some day normal maps...
 };
 
@@ -0,0 +1,21 @@
+/*
+  File: RenderLayer.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief The pass a material is drawn in, each pass sets its blend, cull and depth state once
+enum class RenderLayer : uint32_t
+{
+  Opaque = 0,      // no blending, back faces culled, sorted front to back
+  Cutout = 1,      // alpha tested, double sided, e.g. foliage
+  Translucent = 2, // alpha blended without depth writes, sorted back to front
+};
+
+constexpr size_t RENDER_LAYER_COUNT = 3;
\ No newline at end of file
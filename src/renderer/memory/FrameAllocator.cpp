@@ -0,0 +1,119 @@
+/*
+  File: FrameAllocator.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "FrameAllocator.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#ifdef X0V_CHECK_FRAME_ALLOCATIONS
+namespace
+{
+  std::atomic<size_t> heapAllocations{0};
+}
+
+void *operator new(size_t size)
+{
+  ++heapAllocations;
+  if (void *pointer = std::malloc(size ? size : 1))
+    return pointer;
+
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+  std::free(pointer);
+}
+
+static size_t getHeapAllocations()
+{
+  return heapAllocations.load();
+}
+#else
+static size_t getHeapAllocations()
+{
+  return 0;
+}
+#endif
+
+FrameAllocator::FrameAllocator()
+{
+#ifdef X0V_CHECK_FRAME_ALLOCATIONS
+  std::cout << "[FrameAllocator] Checking for heap allocations after " << WARMUP_FRAMES << " frames" << std::endl;
+#endif
+}
+
+/// @brief Arena of the render thread, only use it from there
+FrameArena &FrameAllocator::getFrameArena()
+{
+  return frameArena;
+}
+
+/// @brief Arena of the calling thread, created on first use
+FrameArena &FrameAllocator::getThreadArena()
+{
+  thread_local FrameArena *arena = nullptr;
+
+  if (!arena)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    arena = threadArenas.emplace_back(std::make_unique<FrameArena>()).get();
+  }
+
+  return *arena;
+}
+
+/// @brief Reset all arenas, call once at the end of the frame while no worker is running
+void FrameAllocator::endFrame()
+{
+  size_t allocations = getHeapAllocations() - allocationsAtFrameStart;
+  if (frameCount >= WARMUP_FRAMES && allocations > 0)
+  {
+    std::cerr << "[FrameAllocator] Frame " << frameCount << " made " << allocations << " heap allocations" << std::endl;
+    assert(allocations == 0 && "steady state frames must not allocate from the heap");
+  }
+
+  frameArena.reset();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &arena : threadArenas)
+      arena->reset();
+  }
+
+  ++frameCount;
+  allocationsAtFrameStart = getHeapAllocations(); // merging grown arenas above is not the next frame's fault
+}
+
+// getters
+uint64_t FrameAllocator::getFrameCount() const
+{
+  return frameCount;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+/*
+  File: FrameAllocator.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "renderer/memory/FrameArena.h"
+
+/// @brief Owner of the per-frame arenas: one for the render thread, and one per thread that asks for its own,
+/// e.g. TaskPool workers, so worker chunks never contend on a shared bump pointer. endFrame() resets all of them.
+///
+/// Built with X0V_CHECK_FRAME_ALLOCATIONS, global operator new is counted and endFrame() asserts that a frame after
+/// the warm-up did not allocate from the heap at all.
+class FrameAllocator
+{
+public:
+  static FrameAllocator &getInstance()
+  {
+    static FrameAllocator instance;
+    return instance;
+  }
+
+  FrameAllocator(const FrameAllocator &) = delete;
+  FrameAllocator &operator=(const FrameAllocator &) = delete;
+
+  FrameArena &getFrameArena();
+  FrameArena &getThreadArena();
+
+  void endFrame();
+
+  // getters
+  uint64_t getFrameCount() const;
+
+  // frames that may still allocate, e.g. while shader permutations finish compiling
+  static constexpr uint64_t WARMUP_FRAMES = 120;
+
+private:
+  FrameAllocator();
+  ~FrameAllocator() = default;
+
+  FrameArena frameArena;
+  std::vector<std::unique_ptr<FrameArena>> threadArenas;
+  std::mutex mutex;
+  uint64_t frameCount = 0;
+  size_t allocationsAtFrameStart = 0;
+};
\ No newline at end of file
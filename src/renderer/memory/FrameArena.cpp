@@ -0,0 +1,106 @@
+/*
+  File: FrameArena.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+FrameArena::FrameArena(size_t initialCapacity)
+{
+  blocks.reserve(8);
+  addBlock(std::max<size_t>(initialCapacity, 256));
+}
+
+FrameArena::~FrameArena()
+{
+  releaseBlocks();
+}
+
+/// @brief Free everything allocated since the last reset, call once per frame when nothing uses the memory anymore
+void FrameArena::reset()
+{
+  if (blocks.size() > 1)
+  {
+    size_t capacity = getCapacity();
+    releaseBlocks();
+    addBlock(capacity);
+  }
+
+  offset = 0;
+  used = 0;
+}
+
+// getters
+size_t FrameArena::getCapacity() const
+{
+  size_t capacity = 0;
+  for (const auto &block : blocks)
+    capacity += block.size;
+
+  return capacity;
+}
+
+size_t FrameArena::getUsed() const
+{
+  return used;
+}
+
+/// @return the most bytes handed out in a single frame so far
+size_t FrameArena::getPeakUsed() const
+{
+  return peakUsed;
+}
+
+// ------- protected ------- //
+
+void *FrameArena::do_allocate(size_t bytes, size_t alignment)
+{
+  auto &block = blocks.back();
+  auto address = reinterpret_cast<uintptr_t>(block.data) + offset;
+  size_t padding = (alignment - address % alignment) % alignment;
+
+  if (offset + padding + bytes > block.size)
+  {
+    // grow geometrically, the next reset() merges the blocks anyway
+    addBlock(std::max(block.size * 2, bytes + alignment));
+    return do_allocate(bytes, alignment);
+  }
+
+  offset += padding + bytes;
+  used += bytes;
+  peakUsed = std::max(peakUsed, used);
+
+  return reinterpret_cast<void *>(address + padding);
+}
+
+void FrameArena::do_deallocate(void *, size_t, size_t)
+{
+  // released all at once in reset()
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+  return this == &other;
+}
+
+// ------- private ------- //
+
+void FrameArena::addBlock(size_t size)
+{
+  blocks.push_back(Block{static_cast<std::byte *>(::operator new(size)), size});
+  offset = 0;
+}
+
+void FrameArena::releaseBlocks()
+{
+  for (const auto &block : blocks)
+    ::operator delete(block.data);
+
+  blocks.clear();
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+/*
+  File: FrameArena.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/// @brief Bump allocator for data that only lives until the end of the frame, usable by std::pmr containers.
+/// Deallocation does nothing, reset() frees everything at once. When a frame needed more than one block,
+/// reset() merges them into a single block of the combined size, so a steady frame never goes to the heap again.
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+  explicit FrameArena(size_t initialCapacity = 64 * 1024);
+  ~FrameArena();
+
+  FrameArena(const FrameArena &) = delete;
+  FrameArena &operator=(const FrameArena &) = delete;
+
+  void reset();
+
+  // getters
+  size_t getCapacity() const;
+  size_t getUsed() const;
+  size_t getPeakUsed() const;
+
+protected:
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+private:
+  struct Block
+  {
+    std::byte *data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks; // the last one is allocated from
+  size_t offset = 0;         // into the last block
+  size_t used = 0, peakUsed = 0;
+
+  void addBlock(size_t size);
+  void releaseBlocks();
+};
\ No newline at end of file
@@ -0,0 +1,244 @@
+/*
+  File: UploadRing.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "UploadRing.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+/// @brief Delete the fences and the buffer, call while the context is still current
+void UploadRing::shutdown()
+{
+  if (!initialized)
+    return;
+
+  for (GLsync &fence : fences)
+  {
+    if (fence)
+      glDeleteSync(fence);
+    fence = nullptr;
+  }
+
+  releaseRetiredBuffers();
+
+  if (mapped)
+  {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  }
+  glDeleteBuffers(1, &buffer);
+
+  buffer = 0;
+  mapped = nullptr;
+  initialized = false;
+}
+
+/// @brief Reserve space in the region of the current frame. Never waits for the GPU.
+/// @param size bytes to reserve
+/// @param alignment alignment of the offset in the buffer, e.g. getUniformAlignment() for uniform block ranges
+/// @return the reserved range, valid until the end of the frame
+UploadAllocation UploadRing::allocate(size_t size, size_t alignment)
+{
+  if (!initialized)
+    initialize();
+
+  size_t offset = (head + alignment - 1) / alignment * alignment;
+  if (offset + size > frameCapacity)
+  {
+    grow(std::max(frameCapacity * 2, size + alignment));
+    offset = 0;
+  }
+
+  head = offset + size;
+
+  size_t bufferOffset = frameIndex * frameCapacity + offset;
+  std::byte *memory = persistent ? mapped : staging.data();
+
+  return UploadAllocation{buffer, bufferOffset, size, memory + bufferOffset};
+}
+
+/// @brief Make the written contents of an allocation visible to the GPU, call before using it in a draw or copy.
+/// Nothing to do on persistently mapped storage, it is coherent.
+void UploadRing::commit(const UploadAllocation &allocation)
+{
+  if (persistent || allocation.size == 0)
+    return;
+
+  glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.buffer);
+  glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.offset, allocation.size, allocation.data);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+/// @brief Copy data into the ring and commit it
+UploadAllocation UploadRing::upload(const void *data, size_t size, size_t alignment)
+{
+  UploadAllocation allocation = allocate(size, alignment);
+  std::memcpy(allocation.data, data, size);
+  commit(allocation);
+
+  return allocation;
+}
+
+/// @brief Fence the region of the finished frame and move on to the next one. Only waits if the GPU is
+/// FRAMES_IN_FLIGHT frames behind, call once per frame after all draws were submitted.
+void UploadRing::endFrame()
+{
+  if (!initialized)
+    return;
+
+  if (persistent)
+    fences[frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  frameIndex = (frameIndex + 1) % FRAMES_IN_FLIGHT;
+  head = 0;
+
+  waitForRegion(frameIndex);
+
+  // without buffer storage the driver renames the storage for us, once per trip around the ring
+  if (!persistent && frameIndex == 0)
+  {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, frameCapacity * FRAMES_IN_FLIGHT, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  }
+
+  releaseRetiredBuffers();
+}
+
+// getters
+bool UploadRing::isPersistent() const
+{
+  return persistent;
+}
+
+size_t UploadRing::getUniformAlignment() const
+{
+  return uniformAlignment;
+}
+
+size_t UploadRing::getStorageAlignment() const
+{
+  return storageAlignment;
+}
+
+size_t UploadRing::getFrameCapacity() const
+{
+  return frameCapacity;
+}
+
+/// @return how often a region was still in use by the GPU when the ring came back to it
+uint64_t UploadRing::getStallCount() const
+{
+  return stallCount;
+}
+
+// ------- private ------- //
+
+void UploadRing::initialize()
+{
+  initialized = true;
+  persistent = GLAD_GL_ARB_buffer_storage;
+
+  GLint alignment = 0;
+  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+  uniformAlignment = std::max<size_t>(alignment, 16);
+
+  if (GLAD_GL_VERSION_4_3)
+  {
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    storageAlignment = std::max<size_t>(alignment, 16);
+  }
+
+  createBuffer(FRAME_CAPACITY);
+
+  std::cout << "[UploadRing] " << (persistent ? "Persistently mapped" : "Orphaning") << " ring with " << FRAMES_IN_FLIGHT
+            << " frames of " << frameCapacity / 1024 << " KiB" << std::endl;
+}
+
+void UploadRing::createBuffer(size_t capacity)
+{
+  frameCapacity = capacity;
+  size_t bufferSize = frameCapacity * FRAMES_IN_FLIGHT;
+
+  glGenBuffers(1, &buffer);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+
+  if (persistent)
+  {
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_COPY_WRITE_BUFFER, bufferSize, nullptr, flags);
+    mapped = static_cast<std::byte *>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, bufferSize, flags));
+  }
+  else
+  {
+    glBufferData(GL_COPY_WRITE_BUFFER, bufferSize, nullptr, GL_STREAM_DRAW);
+    staging.resize(bufferSize);
+  }
+
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+/// @brief Switch to a larger buffer in the middle of a frame. The old one is released at the end of the frame,
+/// the driver keeps it alive until the GPU is done with it.
+void UploadRing::grow(size_t minimumCapacity)
+{
+  size_t capacity = frameCapacity;
+  while (capacity < minimumCapacity)
+    capacity *= 2;
+
+  std::cout << "[UploadRing] Frame uploads exceeded " << frameCapacity / 1024 << " KiB, growing to " << capacity / 1024
+            << " KiB per frame" << std::endl;
+
+  retiredBuffers.push_back(RetiredBuffer{buffer, mapped != nullptr, std::move(staging)});
+  mapped = nullptr;
+  staging.clear();
+
+  // the fences guarded regions of the old buffer, the new one is not in use yet
+  for (GLsync &fence : fences)
+  {
+    if (fence)
+      glDeleteSync(fence);
+    fence = nullptr;
+  }
+
+  createBuffer(capacity);
+  head = 0;
+}
+
+void UploadRing::waitForRegion(uint32_t region)
+{
+  GLsync &fence = fences[region];
+  if (!fence)
+    return;
+
+  if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+  {
+    ++stallCount;
+    glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+  }
+
+  glDeleteSync(fence);
+  fence = nullptr;
+}
+
+void UploadRing::releaseRetiredBuffers()
+{
+  for (auto &retired : retiredBuffers)
+  {
+    if (retired.mapped)
+    {
+      glBindBuffer(GL_COPY_WRITE_BUFFER, retired.buffer);
+      glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+      glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &retired.buffer);
+  }
+
+  retiredBuffers.clear();
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+/*
+  File: UploadRing.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+
+/// @brief A range of the upload ring, written by the CPU and read by the GPU within the same frame
+struct UploadAllocation
+{
+  unsigned int buffer = 0;   // buffer object to bind or copy from
+  size_t offset = 0;         // bytes into the buffer
+  size_t size = 0;           // bytes
+  std::byte *data = nullptr; // write the contents here, then commit()
+};
+
+/// @brief Streaming buffer all per-frame data is uploaded through: light data, frame uniforms, per draw data and
+/// mesh staging. The buffer is split into one region per frame in flight, a region is only written again once the
+/// fence placed at the end of its frame has passed, so uploads never wait for the GPU to finish reading.
+///
+/// Uses persistently mapped storage where buffer storage is available. On plain 3.3 contexts the writes go to a
+/// CPU copy and are submitted with glBufferSubData, the buffer is orphaned whenever the ring wraps around.
+class UploadRing
+{
+public:
+  static UploadRing &getInstance()
+  {
+    static UploadRing instance;
+    return instance;
+  }
+
+  UploadRing(const UploadRing &) = delete;
+  UploadRing &operator=(const UploadRing &) = delete;
+
+  UploadAllocation allocate(size_t size, size_t alignment = 16);
+  void commit(const UploadAllocation &allocation);
+  UploadAllocation upload(const void *data, size_t size, size_t alignment = 16);
+
+  void endFrame();
+  void shutdown();
+
+  // getters
+  bool isPersistent() const;
+  size_t getUniformAlignment() const;
+  size_t getStorageAlignment() const;
+  size_t getFrameCapacity() const;
+  uint64_t getStallCount() const;
+
+  static constexpr uint32_t FRAMES_IN_FLIGHT = 3;
+  static constexpr size_t FRAME_CAPACITY = 4 * 1024 * 1024; // bytes per frame, grows if a frame needs more
+
+private:
+  UploadRing() = default;
+  ~UploadRing() = default; // runs after the context is gone, the buffer is released by shutdown()
+
+  struct RetiredBuffer
+  {
+    unsigned int buffer;
+    bool mapped;
+    std::vector<std::byte> staging; // moved out of the ring, pending commits may still read from it
+  };
+
+  unsigned int buffer = 0;
+  std::byte *mapped = nullptr;    // persistent mapping of the whole buffer
+  std::vector<std::byte> staging; // CPU copy of the buffer on the orphaning path
+  bool initialized = false, persistent = false;
+
+  size_t frameCapacity = 0;
+  uint32_t frameIndex = 0; // region written this frame
+  size_t head = 0;         // bytes used in the current region
+  std::array<GLsync, FRAMES_IN_FLIGHT> fences{};
+  std::vector<RetiredBuffer> retiredBuffers;
+
+  size_t uniformAlignment = 256, storageAlignment = 256;
+  uint64_t stallCount = 0;
+
+  void initialize();
+  void createBuffer(size_t capacity);
+  void grow(size_t minimumCapacity);
+  void waitForRegion(uint32_t region);
+  void releaseRetiredBuffers();
+};
\ No newline at end of file
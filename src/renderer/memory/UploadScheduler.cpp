@@ -0,0 +1,210 @@
+/*
+  File: UploadScheduler.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "UploadScheduler.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+  double toMilliseconds(std::chrono::steady_clock::duration duration)
+  {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  }
+}
+
+/// @brief Queue an upload
+/// @param kind what is uploaded, reported back with the completed uploads
+/// @param bytes size of the upload, counted against the per-frame byte budget
+/// @param priority uploads of higher priority run first, equal priorities in submission order
+/// @param upload issues the GL calls, runs on the render thread during update()
+/// @return ticket to cancel the upload with, e.g. when its owner is destroyed first
+UploadTicket UploadScheduler::schedule(UploadKind kind, size_t bytes, UploadPriority priority, std::function<void()> upload)
+{
+  UploadTicket ticket = nextTicket++;
+
+  pending.emplace(ticket, PendingUpload{kind, bytes, std::move(upload), Clock::now()});
+  queues[static_cast<size_t>(priority)].push_back(ticket);
+  pendingBytes += bytes;
+
+  return ticket;
+}
+
+/// @return false if the upload already ran or was cancelled before
+bool UploadScheduler::cancel(UploadTicket ticket)
+{
+  auto upload = pending.find(ticket);
+  if (upload == pending.end())
+    return false;
+
+  pendingBytes -= upload->second.bytes;
+  pending.erase(upload); // its queue entry is skipped once it comes up
+
+  return true;
+}
+
+/// @brief Run queued uploads until the budgets of this frame are used up, call once per frame before drawing.
+/// At least one upload runs per frame, so uploads larger than the byte budget still make progress.
+void UploadScheduler::update()
+{
+  adaptBudget();
+  completed.clear();
+  budgetExhausted = false;
+
+  auto start = Clock::now();
+  size_t bytes = 0;
+
+  UploadTicket ticket;
+  PendingUpload *upload;
+
+  while (popNext(ticket, upload))
+  {
+    if (!completed.empty() && (bytes + upload->bytes > byteBudget || toMilliseconds(Clock::now() - start) > timeBudget))
+    {
+      budgetExhausted = true;
+      break;
+    }
+
+    bytes += upload->bytes;
+    execute(ticket, *upload);
+  }
+}
+
+/// @brief Mark the end of the frame's CPU work, call once its commands are submitted and before swapping buffers.
+/// Frames without this call leave the budgets as they are.
+void UploadScheduler::endFrame()
+{
+  if (frameStart != Clock::time_point())
+    frameWork = toMilliseconds(Clock::now() - frameStart);
+}
+
+/// @brief Run every queued upload regardless of the budget, e.g. behind a loading screen
+void UploadScheduler::flush()
+{
+  completed.clear();
+
+  UploadTicket ticket;
+  PendingUpload *upload;
+
+  while (popNext(ticket, upload))
+    execute(ticket, *upload);
+}
+
+bool UploadScheduler::isPending(UploadTicket ticket) const
+{
+  return pending.find(ticket) != pending.end();
+}
+
+// setters
+void UploadScheduler::setTargetFrameTime(double milliseconds)
+{
+  targetFrameTime = milliseconds;
+}
+
+// getters
+size_t UploadScheduler::getPendingCount() const
+{
+  return pending.size();
+}
+
+size_t UploadScheduler::getPendingBytes() const
+{
+  return pendingBytes;
+}
+
+size_t UploadScheduler::getByteBudget() const
+{
+  return byteBudget;
+}
+
+/// @return milliseconds per frame
+double UploadScheduler::getTimeBudget() const
+{
+  return timeBudget;
+}
+
+/// @return the uploads of the last update with their queue latency
+std::span<const CompletedUpload> UploadScheduler::getCompletedUploads() const
+{
+  return completed;
+}
+
+/// @return moving average of the queue latency in milliseconds
+double UploadScheduler::getAverageLatency() const
+{
+  return averageLatency;
+}
+
+/// @return longest queue latency so far in milliseconds
+double UploadScheduler::getMaxLatency() const
+{
+  return maxLatency;
+}
+
+// ------- private ------- //
+
+/// @brief Fit the budgets to the CPU work of the last frame. The wall clock time between updates includes the swap
+/// and the vsync wait, with vsync it always sits at the target frame time and shows no headroom.
+void UploadScheduler::adaptBudget()
+{
+  if (frameWork >= 0.0)
+  {
+    double headroom = targetFrameTime - frameWork;
+
+    // a little jitter around the target is normal, only clearly missed frames back off
+    if (frameWork > targetFrameTime * 1.1)
+      byteBudget = std::max(byteBudget / 2, MIN_BYTE_BUDGET);
+    else if (budgetExhausted && headroom > targetFrameTime * 0.25)
+      byteBudget = std::min(byteBudget + byteBudget / 4, MAX_BYTE_BUDGET);
+
+    timeBudget = std::clamp(headroom * 0.5, MIN_TIME_BUDGET, MAX_TIME_BUDGET);
+  }
+
+  frameWork = -1.0;
+  frameStart = Clock::now();
+}
+
+/// @brief Find the next live upload, dropping cancelled tickets from the queue fronts
+/// @return false if nothing is pending
+bool UploadScheduler::popNext(UploadTicket &ticket, PendingUpload *&upload)
+{
+  for (auto &queue : queues)
+  {
+    while (!queue.empty())
+    {
+      auto found = pending.find(queue.front());
+      if (found == pending.end())
+      {
+        queue.pop_front();
+        continue;
+      }
+
+      ticket = found->first;
+      upload = &found->second;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void UploadScheduler::execute(UploadTicket ticket, PendingUpload &upload)
+{
+  double latency = toMilliseconds(Clock::now() - upload.scheduledAt);
+  completed.push_back(CompletedUpload{ticket, upload.kind, upload.bytes, latency});
+
+  averageLatency = averageLatency == 0.0 ? latency : averageLatency * 0.9 + latency * 0.1;
+  maxLatency = std::max(maxLatency, latency);
+
+  // removed before it runs, the upload may schedule or cancel others. Its queue entry is dropped with the next pop.
+  auto function = std::move(upload.upload);
+  pendingBytes -= upload.bytes;
+  pending.erase(ticket);
+
+  function();
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+/*
+  File: UploadScheduler.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+using UploadTicket = uint64_t;
+
+constexpr UploadTicket NO_UPLOAD = 0;
+
+enum class UploadPriority
+{
+  High,   // needed for the next frames, e.g. textures of visible materials
+  Normal, // new geometry
+  Low,    // prefetching, nothing waits for it
+};
+
+enum class UploadKind
+{
+  Mesh,
+  Texture,
+  Buffer,
+};
+
+/// @brief An upload executed during the last update and how long it waited in the queue
+struct CompletedUpload
+{
+  UploadTicket ticket;
+  UploadKind kind;
+  size_t bytes;
+  double latencyMilliseconds;
+};
+
+/// @brief Queues GPU uploads and executes them a few per frame, highest priority first, so a burst of new
+/// meshes or textures is spread over several frames instead of causing a hitch.
+///
+/// Each frame gets a byte and a time budget. The byte budget grows while frames finish with headroom left to the
+/// target frame time and is halved when a frame misses it, the time budget is a share of the measured headroom.
+/// Frame time here is the CPU work from update() to endFrame(), without the swap and vsync wait.
+class UploadScheduler
+{
+public:
+  static UploadScheduler &getInstance()
+  {
+    static UploadScheduler instance;
+    return instance;
+  }
+
+  UploadScheduler(const UploadScheduler &) = delete;
+  UploadScheduler &operator=(const UploadScheduler &) = delete;
+
+  UploadTicket schedule(UploadKind kind, size_t bytes, UploadPriority priority, std::function<void()> upload);
+  bool cancel(UploadTicket ticket);
+  void update();
+  void endFrame();
+  void flush();
+
+  bool isPending(UploadTicket ticket) const;
+
+  // setters
+  void setTargetFrameTime(double milliseconds);
+
+  // getters
+  size_t getPendingCount() const;
+  size_t getPendingBytes() const;
+  size_t getByteBudget() const;
+  double getTimeBudget() const;
+  std::span<const CompletedUpload> getCompletedUploads() const;
+  double getAverageLatency() const;
+  double getMaxLatency() const;
+
+  static constexpr size_t MIN_BYTE_BUDGET = 256 * 1024;       // per frame
+  static constexpr size_t MAX_BYTE_BUDGET = 64 * 1024 * 1024; // per frame
+  static constexpr double MIN_TIME_BUDGET = 0.5;              // milliseconds per frame
+  static constexpr double MAX_TIME_BUDGET = 4.0;              // milliseconds per frame
+
+private:
+  UploadScheduler() = default;
+
+  using Clock = std::chrono::steady_clock;
+
+  struct PendingUpload
+  {
+    UploadKind kind;
+    size_t bytes;
+    std::function<void()> upload;
+    Clock::time_point scheduledAt;
+  };
+
+  std::unordered_map<UploadTicket, PendingUpload> pending;
+  std::array<std::deque<UploadTicket>, 3> queues; // per priority, cancelled tickets are skipped when popped
+  UploadTicket nextTicket = 1;
+  size_t pendingBytes = 0;
+
+  double targetFrameTime = 1000.0 / 60.0; // milliseconds
+  size_t byteBudget = 4 * 1024 * 1024;
+  double timeBudget = MAX_TIME_BUDGET;
+  bool budgetExhausted = false; // last update stopped with uploads left
+  Clock::time_point frameStart; // start of the last update()
+  double frameWork = -1.0;      // milliseconds from update() to endFrame() of the last frame, negative if not reported
+
+  std::vector<CompletedUpload> completed;
+  double averageLatency = 0.0, maxLatency = 0.0;
+
+  void adaptBudget();
+  bool popNext(UploadTicket &ticket, PendingUpload *&upload);
+  void execute(UploadTicket ticket, PendingUpload &upload);
+};
\ No newline at end of file
@@ -0,0 +1,49 @@
+/*
+  File: FaceBuckets.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "renderer/mesh/MeshArena.h"
+
+/// @brief Set of face directions, bit i is PackedVertex::Direction i
+using FaceDirections = uint32_t;
+
+constexpr size_t FACE_DIRECTION_COUNT = 6;
+constexpr FaceDirections ALL_FACE_DIRECTIONS = (1u << FACE_DIRECTION_COUNT) - 1;
+
+/// @brief Layout of a mesh whose faces are grouped by direction into six contiguous ranges, in PackedVertex::Direction
+/// order (+X, -X, +Y, -Y, +Z, -Z). A direction whose faces all point away from the viewer is skipped as a whole,
+/// so the GPU never fetches or transforms those vertices.
+struct FaceBuckets
+{
+  std::array<MeshRange, FACE_DIRECTION_COUNT> ranges{};
+
+  // where the faces of a direction start to face a viewer, in mesh space along the direction's axis:
+  // the smallest coordinate of a positive facing face, the largest of a negative facing one
+  std::array<float, FACE_DIRECTION_COUNT> planes{};
+
+  /// @brief Directions with at least one face that can face the viewer
+  /// @param viewer position in the space of the mesh
+  FaceDirections getFacingDirections(const glm::vec3 &viewer) const
+  {
+    FaceDirections directions = 0;
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+      if (viewer[axis] > planes[axis * 2])
+        directions |= 1u << (axis * 2);
+      if (viewer[axis] < planes[axis * 2 + 1])
+        directions |= 1u << (axis * 2 + 1);
+    }
+
+    return directions;
+  }
+};
\ No newline at end of file
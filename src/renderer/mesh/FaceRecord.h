@@ -0,0 +1,52 @@
+/*
+  File: FaceRecord.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "renderer/mesh/PackedVertex.h"
+#include "renderer/mesh/VertexAttribute.h"
+
+/// @brief 8 byte record of one block face, expanded to its two triangles in face-record.glsl.
+/// Meshes of face records have no vertex attributes: the vertex shader pulls the record of its face from a buffer
+/// texture by gl_VertexID / 6, so a face costs 8 bytes instead of 6 vertices.
+///   x: cell x, y, z as 10 bit integers, offset by 512 (covering [-512, 512))
+///   y: texture array layer in bits 0-11, face direction in bits 12-14, light in bits 16-23
+struct FaceRecord
+{
+  uint32_t position;
+  uint32_t attributes;
+
+  static constexpr uint32_t MAX_LAYER = 0xFFF;
+  static constexpr uint32_t VERTICES_PER_FACE = 6;
+
+  /// @param cell the unit cube the face belongs to, its center is at the cell coordinates
+  /// @param light brightness the face is lit with, 255 leaves the shading as it is
+  static FaceRecord pack(const glm::ivec3 &cell, uint32_t layer, PackedVertex::Direction direction, uint32_t light = 255)
+  {
+    auto biased = [](int value)
+    {
+      return static_cast<uint32_t>(glm::clamp(value + 512, 0, 1023));
+    };
+
+    FaceRecord record;
+    record.position = biased(cell.x) | (biased(cell.y) << 10) | (biased(cell.z) << 20);
+    record.attributes = glm::min(layer, MAX_LAYER) | (static_cast<uint32_t>(direction) << 12) | (glm::min(light, 255u) << 16);
+    return record;
+  }
+
+  /// @brief Only describes the record size, the arena enables no attribute for pulled formats
+  static std::vector<VertexAttribute> getVertexAttributes()
+  {
+    return {VertexAttribute(0, 2, GL_UNSIGNED_INT, GL_FALSE, sizeof(FaceRecord), 0, true)};
+  }
+};
+
+static_assert(sizeof(FaceRecord) == 8, "FaceRecord must stay 8 bytes");
\ No newline at end of file
@@ -1,8 +1,9 @@
 #include "Mesh.h"
 
-Mesh::Mesh(const float *vertices, const size_t verticesCount, const std::vector<VertexAttribute> &vertexAttributes, const int *indices, const size_t indicesCount)
-    : vertices(vertices, vertices + verticesCount),
-      vertexAttributes(vertexAttributes)
+Mesh::Mesh(const float *vertices, const size_t verticesCount, const std::vector<VertexAttribute> &vertexAttributes, const int *indices, const size_t indicesCount,
+           MeshStorage storage)
+    : vertexData(reinterpret_cast<const unsigned char *>(vertices), reinterpret_cast<const unsigned char *>(vertices + verticesCount)),
+      vertexAttributes(vertexAttributes), storage(storage)
 {
   if (indices != nullptr)
   {
@@ -12,10 +13,26 @@ Mesh::Mesh(const float *vertices, const size_t verticesCount, const std::vector<
   setupMesh();
 }
 
-Mesh::Mesh(const std::vector<float> &vertices, const std::vector<VertexAttribute> &vertexAttributes, const std::vector<int> &indices)
-    : vertices(vertices),
+Mesh::Mesh(const std::vector<float> &vertices, const std::vector<VertexAttribute> &vertexAttributes, const std::vector<int> &indices, MeshStorage storage)
+    : vertexData(reinterpret_cast<const unsigned char *>(vertices.data()), reinterpret_cast<const unsigned char *>(vertices.data() + vertices.size())),
       indices(indices),
-      vertexAttributes(vertexAttributes)
+      vertexAttributes(vertexAttributes), storage(storage)
+{
+  setupMesh();
+}
+
+Mesh::Mesh(const std::vector<PackedVertex> &vertices, const std::vector<int> &indices, MeshStorage storage)
+    : vertexData(reinterpret_cast<const unsigned char *>(vertices.data()), reinterpret_cast<const unsigned char *>(vertices.data() + vertices.size())),
+      indices(indices),
+      vertexAttributes(PackedVertex::getVertexAttributes()), storage(storage)
+{
+  setupMesh();
+}
+
+/// @brief A mesh of face records, drawn through vertex pulling with the FacePulling shader permutations
+Mesh::Mesh(const std::vector<FaceRecord> &faces, MeshStorage storage)
+    : vertexData(reinterpret_cast<const unsigned char *>(faces.data()), reinterpret_cast<const unsigned char *>(faces.data() + faces.size())),
+      vertexAttributes(FaceRecord::getVertexAttributes()), verticesPerElement(FaceRecord::VERTICES_PER_FACE), storage(storage)
 {
   setupMesh();
 }
@@ -27,10 +44,17 @@ Mesh::~Mesh()
 
 // Move Constructor: Transfer ownership
 Mesh::Mesh(Mesh &&other) noexcept
-    : VAO(other.VAO), VBO(other.VBO), EBO(other.EBO),
-      vertices(std::move(other.vertices)), indices(std::move(other.indices)), vertexAttributes(std::move(other.vertexAttributes))
+    : vertexData(std::move(other.vertexData)), indices(std::move(other.indices)), vertexAttributes(std::move(other.vertexAttributes)),
+      vertexCount(other.vertexCount), indexCount(other.indexCount), verticesPerElement(other.verticesPerElement),
+      storage(other.storage), handle(other.handle), uploadTicket(other.uploadTicket), uploadTarget(std::move(other.uploadTarget)),
+      faceBuckets(other.faceBuckets)
 {
-  other.VAO = other.VBO = other.EBO = 0;
+  other.handle = INVALID_MESH;
+  other.uploadTicket = NO_UPLOAD;
+
+  // the queued upload now uploads this mesh, nothing is rescheduled so the move can not throw
+  if (uploadTarget)
+    *uploadTarget = this;
 }
 
 // assignment operator for move
@@ -38,70 +62,163 @@ Mesh &Mesh::operator=(Mesh &&other) noexcept
 {
   if (this != &other)
   {
-    if (VAO)
-      glDeleteVertexArrays(1, &VAO);
-    if (VBO)
-      glDeleteBuffers(1, &VBO);
-    if (EBO)
-      glDeleteBuffers(1, &EBO);
-
-    VAO = other.VAO;
-    VBO = other.VBO;
-    EBO = other.EBO;
+    free();
+
+    vertexData = std::move(other.vertexData);
+    indices = std::move(other.indices);
+    vertexAttributes = std::move(other.vertexAttributes);
+    vertexCount = other.vertexCount;
+    indexCount = other.indexCount;
+    verticesPerElement = other.verticesPerElement;
+    storage = other.storage;
+    handle = other.handle;
+    uploadTicket = other.uploadTicket;
+    uploadTarget = std::move(other.uploadTarget);
+    faceBuckets = other.faceBuckets;
 
     // Invalidate the moved-from object
-    other.VAO = other.VBO = other.EBO = 0;
+    other.handle = INVALID_MESH;
+    other.uploadTicket = NO_UPLOAD;
+
+    if (uploadTarget)
+      *uploadTarget = this;
   }
   return *this;
 }
 
 void Mesh::free()
 {
-  glDeleteVertexArrays(1, &VAO);
-  glDeleteBuffers(1, &VBO);
-  if (!indices.empty())
-  {
-    glDeleteBuffers(1, &EBO);
-  }
+  if (uploadTicket != NO_UPLOAD)
+    UploadScheduler::getInstance().cancel(uploadTicket);
+  uploadTicket = NO_UPLOAD;
+
+  if (handle != INVALID_MESH)
+    MeshArena::getInstance().free(handle);
+
+  handle = INVALID_MESH;
 }
 
+/// @brief Bind the arena page of the mesh, meshes on the same page share it and skip the rebind
 void Mesh::bindBuffers() const
 {
-  glBindVertexArray(VAO);
-
-  if (!indices.empty())
-  {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-  }
+  if (isUploaded())
+    MeshArena::getInstance().bind(handle);
 }
 
 void Mesh::unbindBuffers() const
 {
-  glBindVertexArray(0);
-  //? no need to unbind the EBO, as it is unbound when the VAO is unbound
+  MeshArena::getInstance().unbind();
 }
 
 void Mesh::draw() const
 {
-  if (indices.empty())
+  if (isUploaded())
+    MeshArena::getInstance().draw(handle);
+}
+
+/// @brief Draw only the faces of some directions, meshes without face buckets are drawn whole
+/// @param directions e.g. the directions that can face the camera
+void Mesh::draw(FaceDirections directions) const
+{
+  if (!isUploaded())
+    return;
+
+  std::array<MeshRange, FACE_DIRECTION_COUNT> storage;
+  auto ranges = getRanges(directions, storage);
+  if (!ranges.empty())
+    MeshArena::getInstance().draw(handle, ranges);
+}
+
+/// @return false while the upload is still queued
+bool Mesh::isUploaded() const
+{
+  return handle != INVALID_MESH;
+}
+
+/// @return whether the vertices and indices are still available on the CPU, see getVertexData() and getIndices()
+bool Mesh::hasCpuCopy() const
+{
+  return storage == MeshStorage::KeepCpuCopy || !isUploaded();
+}
+
+/// @brief Declare the mesh as grouped into one contiguous range per face direction, see FaceBuckets
+void Mesh::setFaceBuckets(const FaceBuckets &buckets)
+{
+  faceBuckets = buckets;
+}
+
+bool Mesh::hasFaceBuckets() const
+{
+  return faceBuckets.has_value();
+}
+
+const FaceBuckets &Mesh::getFaceBuckets() const
+{
+  return *faceBuckets;
+}
+
+/// @brief The ranges to draw for a set of face directions, ranges that follow each other are merged
+/// @param storage holds the returned ranges
+/// @return the whole mesh as one range if it has no face buckets
+std::span<const MeshRange> Mesh::getRanges(FaceDirections directions, std::array<MeshRange, FACE_DIRECTION_COUNT> &storage) const
+{
+  if (!faceBuckets)
   {
-    int numVertices = vertices.size() / (vertexAttributes[0].stride / sizeof(float));
-    glDrawArrays(GL_TRIANGLES, 0, numVertices);
+    storage[0] = MeshRange{0, static_cast<uint32_t>(indexCount > 0 ? indexCount : vertexCount)};
+    return std::span<const MeshRange>(storage.data(), 1);
   }
-  else
+
+  size_t count = 0;
+  for (size_t direction = 0; direction < FACE_DIRECTION_COUNT; ++direction)
   {
-    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+    const MeshRange &range = faceBuckets->ranges[direction];
+    if (!(directions & (1u << direction)) || range.count == 0)
+      continue;
+
+    if (count > 0 && storage[count - 1].first + storage[count - 1].count == range.first)
+      storage[count - 1].count += range.count;
+    else
+      storage[count++] = range;
   }
+
+  return std::span<const MeshRange>(storage.data(), count);
 }
 
 int Mesh::getVertexCount() const
 {
-  return vertices.size() / (vertexAttributes[0].stride / sizeof(float));
+  return static_cast<int>(vertexCount);
 }
 
 int Mesh::getIndexCount() const
 {
-  return indices.size();
+  return static_cast<int>(indexCount);
+}
+
+const std::vector<VertexAttribute> &Mesh::getVertexAttributes() const
+{
+  return vertexAttributes;
+}
+
+/// @return the raw vertex bytes, empty if the mesh did not keep a CPU copy
+std::span<const unsigned char> Mesh::getVertexData() const
+{
+  return vertexData;
+}
+
+/// @return the indices, empty if the mesh did not keep a CPU copy
+std::span<const int> Mesh::getIndices() const
+{
+  return indices;
+}
+
+MeshStorage Mesh::getStorage() const
+{
+  return storage;
+}
+
+MeshHandle Mesh::getHandle() const
+{
+  return handle;
 }
 
 void Mesh::setupMesh()
@@ -112,24 +229,25 @@ void Mesh::setupMesh()
     return;
   }
 
-  glGenVertexArrays(1, &this->VAO);
-  glBindVertexArray(this->VAO);
+  vertexCount = vertexData.size() / vertexAttributes[0].stride;
+  indexCount = indices.size();
 
-  glGenBuffers(1, &this->VBO);
-  glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-  glBufferData(GL_ARRAY_BUFFER, this->vertices.size() * sizeof(float), this->vertices.data(), GL_STATIC_DRAW);
+  size_t bytes = vertexData.size() + indices.size() * sizeof(int);
+  uploadTarget = std::make_unique<Mesh *>(this);
+  uploadTicket = UploadScheduler::getInstance().schedule(UploadKind::Mesh, bytes, UploadPriority::Normal, [target = uploadTarget.get()]()
+                                                         { (*target)->upload(); });
+}
 
-  if (!indices.empty())
-  {
-    glGenBuffers(1, &this->EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->indices.size() * sizeof(int), this->indices.data(), GL_STATIC_DRAW);
-  }
+void Mesh::upload()
+{
+  uploadTicket = NO_UPLOAD;
+  handle = MeshArena::getInstance().allocate(vertexAttributes, vertexData.data(), vertexData.size(),
+                                             indices.empty() ? nullptr : indices.data(), indices.size(), verticesPerElement);
 
-  // set the vertex attributes
-  for (const auto &vA : this->vertexAttributes)
+  // the arena holds the geometry now, the CPU copy would only double the resident size
+  if (storage == MeshStorage::GpuOnly)
   {
-    glVertexAttribPointer(vA.layoutIndex, vA.size, vA.type, vA.normalized, vA.stride, vA.offset);
-    glEnableVertexAttribArray(vA.layoutIndex);
+    std::vector<unsigned char>().swap(vertexData);
+    std::vector<int>().swap(indices);
   }
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <optional>
+#include <span>
 #include <vector>
 #include <iostream>
 #include <glad/glad.h>
@@ -7,12 +10,30 @@
 #include "renderer/material/Material.h"
 #include "renderer/material/DefaultMaterial.hpp"
 #include "renderer/mesh/VertexAttribute.h"
+#include "renderer/mesh/PackedVertex.h"
+#include "renderer/mesh/FaceRecord.h"
+#include "renderer/mesh/MeshArena.h"
+#include "renderer/mesh/FaceBuckets.h"
+#include "renderer/memory/UploadScheduler.h"
 
+/// @brief Whether a mesh keeps its vertices and indices in CPU memory once they are uploaded
+enum class MeshStorage
+{
+  GpuOnly,     // released after the upload, only counts and format stay
+  KeepCpuCopy, // for meshes that are read back, e.g. for picking or collision
+};
+
+/// @brief Geometry stored in the MeshArena, the mesh itself only holds the handle of its allocation.
+/// The upload is queued in the UploadScheduler, until it ran the mesh is not drawn.
 class Mesh
 {
 public:
-  Mesh(const float *vertices, const size_t verticesCount, const std::vector<VertexAttribute> &vertexAttributes, const int *indices = nullptr, const size_t indicesCount = 0);
-  Mesh(const std::vector<float> &vertices, const std::vector<VertexAttribute> &vertexAttributes, const std::vector<int> &indices = {});
+  Mesh(const float *vertices, const size_t verticesCount, const std::vector<VertexAttribute> &vertexAttributes, const int *indices = nullptr, const size_t indicesCount = 0,
+       MeshStorage storage = MeshStorage::GpuOnly);
+  Mesh(const std::vector<float> &vertices, const std::vector<VertexAttribute> &vertexAttributes, const std::vector<int> &indices = {},
+       MeshStorage storage = MeshStorage::GpuOnly);
+  Mesh(const std::vector<PackedVertex> &vertices, const std::vector<int> &indices = {}, MeshStorage storage = MeshStorage::GpuOnly);
+  Mesh(const std::vector<FaceRecord> &faces, MeshStorage storage = MeshStorage::GpuOnly);
   ~Mesh();
 
   // delete copy constructor and assignment operator
@@ -26,17 +47,44 @@ public:
   void bindBuffers() const;
   void unbindBuffers() const;
   void draw() const;
+  void draw(FaceDirections directions) const;
+
+  bool isUploaded() const;
+
+  bool hasCpuCopy() const;
+
+  // setters
+  void setFaceBuckets(const FaceBuckets &buckets);
+
+  // getters
+  bool hasFaceBuckets() const;
+  const FaceBuckets &getFaceBuckets() const;
+  std::span<const MeshRange> getRanges(FaceDirections directions, std::array<MeshRange, FACE_DIRECTION_COUNT> &storage) const;
 
   int getVertexCount() const;
   int getIndexCount() const;
+  const std::vector<VertexAttribute> &getVertexAttributes() const;
+  std::span<const unsigned char> getVertexData() const;
+  std::span<const int> getIndices() const;
+  MeshStorage getStorage() const;
+  MeshHandle getHandle() const;
 
 private:
-  std::vector<float> vertices;
+  // CPU side geometry, empty once uploaded unless the mesh keeps a copy
+  std::vector<unsigned char> vertexData; // raw vertex bytes, laid out as described by the vertex attributes
   std::vector<int> indices;
+
   std::vector<VertexAttribute> vertexAttributes;
-  unsigned int VBO = 0, VAO = 0, EBO = 0;
+  size_t vertexCount = 0, indexCount = 0;  // vertex count is in face records for pulled meshes
+  uint32_t verticesPerElement = 1;          // FaceRecord::VERTICES_PER_FACE for pulled meshes
+  MeshStorage storage;
+  MeshHandle handle = INVALID_MESH;
+  UploadTicket uploadTicket = NO_UPLOAD;
+  std::unique_ptr<Mesh *> uploadTarget; // the queued upload calls through it, so a move re-targets it without rescheduling
+  std::optional<FaceBuckets> faceBuckets; // only set for meshes grouped by face direction
 
   void setupMesh();
+  void upload();
   void free();
 };
 
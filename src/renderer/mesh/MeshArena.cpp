@@ -0,0 +1,415 @@
+/*
+  File: MeshArena.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "MeshArena.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "renderer/memory/UploadRing.h"
+#include "renderer/shader/UniformBlocks.h"
+
+/// @brief Copy a mesh into the arena
+/// @param attributes vertex layout, meshes with the same layout share pages
+/// @param vertexData interleaved vertices as described by the attributes
+/// @param vertexBytes size of the vertex data
+/// @param indices optional triangle indices, relative to the first vertex of the mesh
+/// @param indexCount number of indices
+/// @param verticesPerElement vertices the shader expands every element to, e.g. 6 for pulled face records
+/// @return handle to draw and free the mesh with
+MeshHandle MeshArena::allocate(const std::vector<VertexAttribute> &attributes, const void *vertexData, size_t vertexBytes,
+                               const int *indices, size_t indexCount, uint32_t verticesPerElement)
+{
+  MeshAllocation allocation;
+  allocation.format = getFormat(attributes, verticesPerElement);
+  allocation.vertexCount = static_cast<uint32_t>(vertexBytes / formats[allocation.format].stride);
+  allocation.indexCount = static_cast<uint32_t>(indexCount);
+  allocation.verticesPerElement = verticesPerElement;
+  allocation.live = true;
+
+  auto tryPage = [&](uint32_t index)
+  {
+    auto &page = pages[index];
+    if (!page.vertices.allocate(allocation.vertexCount, allocation.firstVertex))
+      return false;
+
+    if (!page.indices.allocate(allocation.indexCount, allocation.firstIndex))
+    {
+      page.vertices.free(allocation.firstVertex, allocation.vertexCount);
+      return false;
+    }
+
+    allocation.page = index;
+    return true;
+  };
+
+  bool placed = false;
+  for (uint32_t i = 0; i < pages.size() && !placed; ++i)
+    placed = pages[i].format == allocation.format && tryPage(i);
+
+  if (!placed)
+  {
+    // meshes larger than a page get a page of their own size
+    uint32_t vertexCapacity = std::max<uint32_t>(VERTEX_PAGE_SIZE / formats[allocation.format].stride, allocation.vertexCount);
+    uint32_t indexCapacity = std::max<uint32_t>(INDEX_PAGE_SIZE, allocation.indexCount);
+    tryPage(createPage(allocation.format, vertexCapacity, indexCapacity));
+  }
+
+  // staged in the upload ring and copied on the GPU, the page may still be read by draws in flight.
+  // copies go through the copy targets, binding the element buffer would change whatever VAO is bound
+  const auto &page = pages[allocation.page];
+  GLsizei stride = formats[allocation.format].stride;
+  auto &uploadRing = UploadRing::getInstance();
+
+  auto stagedVertices = uploadRing.upload(vertexData, vertexBytes, sizeof(int));
+  glBindBuffer(GL_COPY_READ_BUFFER, stagedVertices.buffer);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, page.VBO);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, stagedVertices.offset,
+                      static_cast<GLintptr>(allocation.firstVertex) * stride, vertexBytes);
+
+  if (indexCount > 0)
+  {
+    auto stagedIndices = uploadRing.upload(indices, indexCount * sizeof(int), sizeof(int));
+    glBindBuffer(GL_COPY_READ_BUFFER, stagedIndices.buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, page.EBO);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, stagedIndices.offset,
+                        static_cast<GLintptr>(allocation.firstIndex) * sizeof(int), indexCount * sizeof(int));
+  }
+
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  MeshHandle handle;
+  if (!freeHandles.empty())
+  {
+    handle = freeHandles.back();
+    freeHandles.pop_back();
+    allocations[handle] = allocation;
+  }
+  else
+  {
+    handle = static_cast<MeshHandle>(allocations.size());
+    allocations.push_back(allocation);
+  }
+
+  return handle;
+}
+
+void MeshArena::free(MeshHandle handle)
+{
+  // meshes of static owners are destroyed after the arena released everything
+  if (isShutDown)
+    return;
+
+  auto &allocation = allocations[handle];
+  if (!allocation.live)
+    return;
+
+  auto &page = pages[allocation.page];
+  page.vertices.free(allocation.firstVertex, allocation.vertexCount);
+  page.indices.free(allocation.firstIndex, allocation.indexCount);
+
+  allocation.live = false;
+  freeHandles.push_back(handle);
+}
+
+/// @brief Bind the VAO of the mesh's page, does nothing if it is bound already
+void MeshArena::bind(MeshHandle handle)
+{
+  bindPageObjects(pages[allocations[handle].page]);
+}
+
+/// @brief Bind the VAO of a page, for draws that address the page directly like multi draw indirect
+void MeshArena::bindPage(uint32_t page)
+{
+  bindPageObjects(pages[page]);
+}
+
+/// @brief Unbind the page VAO, e.g. at the end of a pass
+void MeshArena::unbind()
+{
+  if (!boundVAO)
+    return;
+
+  glBindVertexArray(0);
+  boundVAO = 0;
+}
+
+/// @brief Draw a mesh, its page has to be bound
+void MeshArena::draw(MeshHandle handle) const
+{
+  const auto &allocation = allocations[handle];
+
+  if (allocation.indexCount == 0)
+  {
+    glDrawArrays(GL_TRIANGLES, allocation.firstVertex * allocation.verticesPerElement, allocation.vertexCount * allocation.verticesPerElement);
+  }
+  else
+  {
+    const void *firstIndex = reinterpret_cast<const void *>(static_cast<uintptr_t>(allocation.firstIndex) * sizeof(int));
+    glDrawElementsBaseVertex(GL_TRIANGLES, allocation.indexCount, GL_UNSIGNED_INT, firstIndex, allocation.firstVertex);
+  }
+}
+
+/// @brief Draw parts of a mesh with one multi draw call
+/// @param ranges at most MAX_DRAW_RANGES ranges, e.g. the face directions that can face the camera
+void MeshArena::draw(MeshHandle handle, std::span<const MeshRange> ranges) const
+{
+  const auto &allocation = allocations[handle];
+
+  size_t count = std::min(ranges.size(), MAX_DRAW_RANGES);
+  GLint firsts[MAX_DRAW_RANGES];
+  GLsizei counts[MAX_DRAW_RANGES];
+  const void *offsets[MAX_DRAW_RANGES];
+  GLint baseVertices[MAX_DRAW_RANGES];
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    bool indexed = allocation.indexCount > 0;
+    counts[i] = static_cast<GLsizei>(indexed ? ranges[i].count : ranges[i].count * allocation.verticesPerElement);
+    firsts[i] = static_cast<GLint>((allocation.firstVertex + ranges[i].first) * allocation.verticesPerElement);
+    offsets[i] = reinterpret_cast<const void *>(static_cast<uintptr_t>(allocation.firstIndex + ranges[i].first) * sizeof(int));
+    baseVertices[i] = static_cast<GLint>(allocation.firstVertex);
+  }
+
+  if (allocation.indexCount == 0)
+    glMultiDrawArrays(GL_TRIANGLES, firsts, counts, static_cast<GLsizei>(count));
+  else
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, counts, GL_UNSIGNED_INT, offsets, static_cast<GLsizei>(count), baseVertices);
+}
+
+/// @brief Compact at most one fragmented page, call once per frame outside of passes
+void MeshArena::update()
+{
+  for (uint32_t i = 0; i < pages.size(); ++i)
+  {
+    const auto &vertices = pages[i].vertices;
+
+    // only worth the copies if a meaningful part of the page is lost in holes
+    if (vertices.getFragmentation() > DEFRAGMENT_THRESHOLD && vertices.getFreeSize() >= vertices.getCapacity() / 4)
+    {
+      compact(i);
+      return;
+    }
+  }
+}
+
+/// @brief Delete the buffers of all pages, call while the context is still current. Meshes freed after this,
+/// e.g. the block meshes of the registry at exit, are ignored.
+void MeshArena::shutdown()
+{
+  if (isShutDown)
+    return;
+
+  for (auto &page : pages)
+  {
+    glDeleteVertexArrays(1, &page.VAO);
+    glDeleteBuffers(1, &page.VBO);
+    glDeleteBuffers(1, &page.EBO);
+    glDeleteTextures(1, &page.recordTexture);
+  }
+
+  pages.clear();
+  allocations.clear();
+  freeHandles.clear();
+  boundVAO = 0;
+  isShutDown = true;
+}
+
+// setters
+
+/// @brief Source the per instance draw id of every page from a buffer of ascending uints.
+/// Indirect draws start their single instance at their draw index, so each vertex sees the index of its draw.
+/// @param buffer buffer object with at least as many ids as draws are submitted at once
+void MeshArena::setDrawIdBuffer(unsigned int buffer)
+{
+  drawIdBuffer = buffer;
+
+  for (const auto &page : pages)
+    attachDrawIds(page);
+
+  glBindVertexArray(0);
+  boundVAO = 0;
+}
+
+// getters
+const MeshAllocation &MeshArena::getAllocation(MeshHandle handle) const
+{
+  return allocations[handle];
+}
+
+size_t MeshArena::getPageCount() const
+{
+  return pages.size();
+}
+
+// ------- private ------- //
+
+uint32_t MeshArena::getFormat(const std::vector<VertexAttribute> &attributes, uint32_t verticesPerElement)
+{
+  auto sameAttribute = [](const VertexAttribute &a, const VertexAttribute &b)
+  {
+    return a.layoutIndex == b.layoutIndex && a.size == b.size && a.type == b.type && a.normalized == b.normalized &&
+           a.stride == b.stride && a.offset == b.offset && a.integer == b.integer;
+  };
+
+  for (uint32_t i = 0; i < formats.size(); ++i)
+  {
+    const auto &known = formats[i].attributes;
+    if (formats[i].verticesPerElement == verticesPerElement && std::equal(known.begin(), known.end(), attributes.begin(), attributes.end(), sameAttribute))
+      return i;
+  }
+
+  formats.push_back(VertexFormat{attributes, attributes.front().stride, verticesPerElement});
+  return static_cast<uint32_t>(formats.size() - 1);
+}
+
+uint32_t MeshArena::createPage(uint32_t format, uint32_t vertexCapacity, uint32_t indexCapacity)
+{
+  pages.push_back(Page{format, 0, 0, 0, 0, RangeAllocator(vertexCapacity), RangeAllocator(indexCapacity)});
+  createPageObjects(pages.back());
+
+  std::cout << "[MeshArena] Created page " << pages.size() - 1 << " for " << vertexCapacity << " vertices of format "
+            << format << std::endl;
+
+  return static_cast<uint32_t>(pages.size() - 1);
+}
+
+/// @brief Create the buffers of a page for its capacities and a VAO over them
+void MeshArena::createPageObjects(Page &page)
+{
+  const auto &format = formats[page.format];
+
+  glGenBuffers(1, &page.VBO);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, page.VBO);
+  glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(page.vertices.getCapacity()) * format.stride, nullptr, GL_STATIC_DRAW);
+
+  glGenBuffers(1, &page.EBO);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, page.EBO);
+  glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(page.indices.getCapacity()) * sizeof(int), nullptr, GL_STATIC_DRAW);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  glGenVertexArrays(1, &page.VAO);
+  glBindVertexArray(page.VAO);
+  glBindBuffer(GL_ARRAY_BUFFER, page.VBO);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, page.EBO);
+
+  // pulled formats fetch nothing through attributes, gl_VertexID runs past the element count of the buffer
+  for (const auto &vA : format.attributes)
+  {
+    if (format.verticesPerElement > 1)
+      break;
+
+    if (vA.integer)
+      glVertexAttribIPointer(vA.layoutIndex, vA.size, vA.type, vA.stride, vA.offset);
+    else
+      glVertexAttribPointer(vA.layoutIndex, vA.size, vA.type, vA.normalized, vA.stride, vA.offset);
+    glEnableVertexAttribArray(vA.layoutIndex);
+  }
+
+  if (drawIdBuffer)
+    attachDrawIds(page);
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  boundVAO = 0;
+
+  if (format.verticesPerElement > 1)
+  {
+    glGenTextures(1, &page.recordTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, page.recordTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, page.VBO);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+  }
+}
+
+/// @brief Point the draw id attribute of a page's VAO at the draw id buffer, leaves the VAO bound
+void MeshArena::attachDrawIds(const Page &page)
+{
+  glBindVertexArray(page.VAO);
+  glBindBuffer(GL_ARRAY_BUFFER, drawIdBuffer);
+  glVertexAttribIPointer(DRAW_ID_LOCATION, 1, GL_UNSIGNED_INT, sizeof(GLuint), nullptr);
+  glVertexAttribDivisor(DRAW_ID_LOCATION, 1);
+  glEnableVertexAttribArray(DRAW_ID_LOCATION);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/// @brief Bind the VAO of a page and the record texture of pulled pages, does nothing if it is bound already
+void MeshArena::bindPageObjects(const Page &page)
+{
+  if (page.VAO == boundVAO)
+    return;
+
+  glBindVertexArray(page.VAO);
+  boundVAO = page.VAO;
+
+  if (page.recordTexture)
+  {
+    glActiveTexture(GL_TEXTURE0 + FACE_RECORD_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, page.recordTexture);
+    glActiveTexture(GL_TEXTURE0);
+  }
+}
+
+/// @brief Move all live meshes of a page to its start, so the free space is one range again.
+/// The ranges are copied into fresh buffers on the GPU, the CPU never sees the data.
+void MeshArena::compact(uint32_t pageIndex)
+{
+  auto &page = pages[pageIndex];
+  GLsizei stride = formats[page.format].stride;
+
+  std::vector<MeshHandle> members;
+  for (MeshHandle handle = 0; handle < allocations.size(); ++handle)
+  {
+    if (allocations[handle].live && allocations[handle].page == pageIndex)
+      members.push_back(handle);
+  }
+
+  std::sort(members.begin(), members.end(), [&](MeshHandle a, MeshHandle b)
+            { return allocations[a].firstVertex < allocations[b].firstVertex; });
+
+  unsigned int oldVAO = page.VAO, oldVBO = page.VBO, oldEBO = page.EBO, oldRecordTexture = page.recordTexture;
+  createPageObjects(page);
+
+  uint32_t vertexOffset = 0, indexOffset = 0;
+  for (MeshHandle handle : members)
+  {
+    auto &allocation = allocations[handle];
+
+    glBindBuffer(GL_COPY_READ_BUFFER, oldVBO);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, page.VBO);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(allocation.firstVertex) * stride,
+                        static_cast<GLintptr>(vertexOffset) * stride, static_cast<GLsizeiptr>(allocation.vertexCount) * stride);
+
+    if (allocation.indexCount > 0)
+    {
+      // indices are relative to the first vertex, they stay valid as they are
+      glBindBuffer(GL_COPY_READ_BUFFER, oldEBO);
+      glBindBuffer(GL_COPY_WRITE_BUFFER, page.EBO);
+      glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(allocation.firstIndex) * sizeof(int),
+                          static_cast<GLintptr>(indexOffset) * sizeof(int), static_cast<GLsizeiptr>(allocation.indexCount) * sizeof(int));
+    }
+
+    allocation.firstVertex = vertexOffset;
+    allocation.firstIndex = indexOffset;
+    vertexOffset += allocation.vertexCount;
+    indexOffset += allocation.indexCount;
+  }
+
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  glDeleteVertexArrays(1, &oldVAO);
+  glDeleteBuffers(1, &oldVBO);
+  glDeleteBuffers(1, &oldEBO);
+  glDeleteTextures(1, &oldRecordTexture);
+
+  page.vertices.reset(vertexOffset);
+  page.indices.reset(indexOffset);
+
+  std::cout << "[MeshArena] Compacted page " << pageIndex << ", " << members.size() << " meshes" << std::endl;
+}
\ No newline at end of file
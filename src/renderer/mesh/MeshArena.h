@@ -0,0 +1,120 @@
+/*
+  File: MeshArena.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glad/glad.h>
+
+#include "renderer/mesh/RangeAllocator.h"
+#include "renderer/mesh/VertexAttribute.h"
+
+using MeshHandle = uint32_t;
+
+constexpr MeshHandle INVALID_MESH = ~MeshHandle(0);
+
+/// @brief Where the vertices and indices of a mesh live in the arena
+struct MeshAllocation
+{
+  uint32_t format = 0, page = 0;
+  uint32_t firstVertex = 0, vertexCount = 0; // in elements of the format, vertices or pulled records
+  uint32_t firstIndex = 0, indexCount = 0;   // in indices
+  uint32_t verticesPerElement = 1;           // vertices drawn per element, more than 1 for pulled records
+  bool live = false;
+};
+
+/// @brief Part of a mesh, in elements (vertices or pulled records) for non-indexed and in indices for indexed meshes,
+/// relative to the mesh's start
+struct MeshRange
+{
+  uint32_t first = 0, count = 0;
+};
+
+/// @brief Vertex and index storage of all meshes in a few large buffer pages per vertex format.
+/// Every page has one VAO, so consecutive draws of meshes on the same page never rebind it, and meshes
+/// are drawn by offset (base vertex, first index) instead of owning buffer objects.
+///
+/// Formats with more than one vertex per element are pulled: the page enables no vertex attribute, the vertex
+/// shader reads its element from the page's buffer texture by gl_VertexID instead.
+///
+/// Meshes only keep a handle, the allocation behind it may move: update() compacts one page per frame
+/// once freed holes make up too much of it, copying the live ranges on the GPU.
+class MeshArena
+{
+public:
+  static MeshArena &getInstance()
+  {
+    static MeshArena instance;
+    return instance;
+  }
+
+  MeshArena(const MeshArena &) = delete;
+  MeshArena &operator=(const MeshArena &) = delete;
+
+  MeshHandle allocate(const std::vector<VertexAttribute> &attributes, const void *vertexData, size_t vertexBytes,
+                      const int *indices, size_t indexCount, uint32_t verticesPerElement = 1);
+  void free(MeshHandle handle);
+
+  void bind(MeshHandle handle);
+  void bindPage(uint32_t page);
+  void unbind();
+  void draw(MeshHandle handle) const;
+  void draw(MeshHandle handle, std::span<const MeshRange> ranges) const;
+
+  void update();
+  void shutdown();
+
+  // setters
+  void setDrawIdBuffer(unsigned int buffer);
+
+  // getters
+  const MeshAllocation &getAllocation(MeshHandle handle) const;
+  size_t getPageCount() const;
+
+  static constexpr size_t VERTEX_PAGE_SIZE = 4 * 1024 * 1024; // bytes
+  static constexpr uint32_t INDEX_PAGE_SIZE = 256 * 1024;     // indices
+  static constexpr float DEFRAGMENT_THRESHOLD = 0.5f;          // fragmentation a page is compacted at
+  static constexpr GLuint DRAW_ID_LOCATION = 4;                // per instance draw index of indirect draws
+  static constexpr size_t MAX_DRAW_RANGES = 6;                 // ranges of one mesh per draw, one per face direction
+
+private:
+  MeshArena() = default;
+  ~MeshArena() = default; // runs after the context is gone, GL objects are released by shutdown()
+
+  struct VertexFormat
+  {
+    std::vector<VertexAttribute> attributes;
+    GLsizei stride;
+    uint32_t verticesPerElement;
+  };
+
+  struct Page
+  {
+    uint32_t format;
+    unsigned int VAO = 0, VBO = 0, EBO = 0;
+    unsigned int recordTexture = 0; // RG32UI view of the VBO, only for pulled formats
+    RangeAllocator vertices, indices;
+  };
+
+  std::vector<VertexFormat> formats;
+  std::vector<Page> pages;
+  std::vector<MeshAllocation> allocations;
+  std::vector<MeshHandle> freeHandles;
+  unsigned int boundVAO = 0;
+  unsigned int drawIdBuffer = 0;
+  bool isShutDown = false;
+
+  uint32_t getFormat(const std::vector<VertexAttribute> &attributes, uint32_t verticesPerElement);
+  uint32_t createPage(uint32_t format, uint32_t vertexCapacity, uint32_t indexCapacity);
+  void createPageObjects(Page &page);
+  void attachDrawIds(const Page &page);
+  void bindPageObjects(const Page &page);
+  void compact(uint32_t pageIndex);
+};
\ No newline at end of file
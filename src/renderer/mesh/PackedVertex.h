@@ -0,0 +1,61 @@
+/*
+  File: PackedVertex.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "renderer/mesh/VertexAttribute.h"
+
+/// @brief 8 byte vertex for axis aligned block geometry, decoded in packed-vertex.glsl
+///   x: position x, y, z as 10 bit fixed point (1/32 units, offset by -8, covering [-8, 24))
+///   y: u, v as 6 bit fixed point (1/32 units, covering [0, 1]), texture array layer in bits 12-23,
+///      face direction in bits 24-26
+struct PackedVertex
+{
+  uint32_t position;
+  uint32_t attributes;
+
+  // face directions, indexing FACE_NORMALS in the shader
+  enum Direction : uint32_t
+  {
+    PositiveX = 0,
+    NegativeX = 1,
+    PositiveY = 2,
+    NegativeY = 3,
+    PositiveZ = 4,
+    NegativeZ = 5,
+  };
+
+  static constexpr uint32_t MAX_LAYER = 0xFFF;
+
+  static PackedVertex pack(const glm::vec3 &position, const glm::vec2 &uv, uint32_t layer, Direction direction)
+  {
+    auto quantize = [](float value)
+    {
+      return static_cast<uint32_t>(glm::clamp(value + 8.0f, 0.0f, 1023.0f / 32.0f) * 32.0f + 0.5f);
+    };
+    auto fixed6 = [](float value)
+    {
+      return static_cast<uint32_t>(glm::clamp(value, 0.0f, 1.0f) * 32.0f + 0.5f);
+    };
+
+    PackedVertex vertex;
+    vertex.position = quantize(position.x) | (quantize(position.y) << 10) | (quantize(position.z) << 20);
+    vertex.attributes = fixed6(uv.x) | (fixed6(uv.y) << 6) | (glm::min(layer, MAX_LAYER) << 12) | (static_cast<uint32_t>(direction) << 24);
+    return vertex;
+  }
+
+  static std::vector<VertexAttribute> getVertexAttributes()
+  {
+    return {VertexAttribute(0, 2, GL_UNSIGNED_INT, GL_FALSE, sizeof(PackedVertex), 0, true)};
+  }
+};
+
+static_assert(sizeof(PackedVertex) == 8, "PackedVertex must stay 8 bytes");
\ No newline at end of file
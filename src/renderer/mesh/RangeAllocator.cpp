@@ -0,0 +1,116 @@
+/*
+  File: RangeAllocator.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "RangeAllocator.h"
+
+#include <algorithm>
+
+RangeAllocator::RangeAllocator(uint32_t capacity) : capacity(capacity)
+{
+  reset();
+}
+
+/// @brief Take the first free range that is large enough
+/// @param size units to allocate
+/// @param offset start of the allocated range
+/// @return false if no free range is large enough
+bool RangeAllocator::allocate(uint32_t size, uint32_t &offset)
+{
+  if (size == 0)
+  {
+    offset = 0;
+    return true;
+  }
+
+  for (auto range = freeRanges.begin(); range != freeRanges.end(); ++range)
+  {
+    if (range->second < size)
+      continue;
+
+    offset = range->first;
+    uint32_t remaining = range->second - size;
+    freeRanges.erase(range);
+
+    if (remaining > 0)
+      freeRanges.emplace(offset + size, remaining);
+
+    freeSize -= size;
+    return true;
+  }
+
+  return false;
+}
+
+/// @brief Return a range, merging it with adjacent free ranges
+void RangeAllocator::free(uint32_t offset, uint32_t size)
+{
+  if (size == 0)
+    return;
+
+  freeSize += size;
+
+  auto next = freeRanges.lower_bound(offset);
+
+  if (next != freeRanges.begin())
+  {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == offset)
+    {
+      offset = previous->first;
+      size += previous->second;
+      freeRanges.erase(previous);
+    }
+  }
+
+  if (next != freeRanges.end() && offset + size == next->first)
+  {
+    size += next->second;
+    freeRanges.erase(next);
+  }
+
+  freeRanges.emplace(offset, size);
+}
+
+/// @brief Forget all allocations
+/// @param usedPrefix units at the start that stay allocated, e.g. after compacting
+void RangeAllocator::reset(uint32_t usedPrefix)
+{
+  freeRanges.clear();
+  freeSize = capacity - usedPrefix;
+
+  if (freeSize > 0)
+    freeRanges.emplace(usedPrefix, freeSize);
+}
+
+// getters
+uint32_t RangeAllocator::getCapacity() const
+{
+  return capacity;
+}
+
+uint32_t RangeAllocator::getFreeSize() const
+{
+  return freeSize;
+}
+
+uint32_t RangeAllocator::getLargestFreeRange() const
+{
+  uint32_t largest = 0;
+  for (const auto &[offset, size] : freeRanges)
+    largest = std::max(largest, size);
+
+  return largest;
+}
+
+/// @return 0 if all free space is one range, towards 1 the more it is split into small holes
+float RangeAllocator::getFragmentation() const
+{
+  if (freeSize == 0)
+    return 0.0f;
+
+  return 1.0f - static_cast<float>(getLargestFreeRange()) / static_cast<float>(freeSize);
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+/*
+  File: RangeAllocator.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+/// @brief First-fit free list over a range of [0, capacity) units, e.g. vertices of a buffer page.
+/// Freed ranges are merged with their free neighbours, so the list only holds the actual holes.
+class RangeAllocator
+{
+public:
+  explicit RangeAllocator(uint32_t capacity = 0);
+
+  bool allocate(uint32_t size, uint32_t &offset);
+  void free(uint32_t offset, uint32_t size);
+  void reset(uint32_t usedPrefix = 0);
+
+  // getters
+  uint32_t getCapacity() const;
+  uint32_t getFreeSize() const;
+  uint32_t getLargestFreeRange() const;
+  float getFragmentation() const;
+
+private:
+  uint32_t capacity;
+  uint32_t freeSize = 0;
+  std::map<uint32_t, uint32_t> freeRanges; // offset -> size
+};
\ No newline at end of file
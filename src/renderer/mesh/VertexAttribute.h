@@ -4,8 +4,8 @@
 
 struct VertexAttribute
 {
-  VertexAttribute(GLuint layoutIdx, GLint size, GLenum type, GLboolean normalized, GLsizei stride, size_t offset)
-      : layoutIndex(layoutIdx), size(size), type(type), normalized(normalized), stride(stride), offset((void *)offset) {};
+  VertexAttribute(GLuint layoutIdx, GLint size, GLenum type, GLboolean normalized, GLsizei stride, size_t offset, bool integer = false)
+      : layoutIndex(layoutIdx), size(size), type(type), normalized(normalized), stride(stride), offset((void *)offset), integer(integer) {};
   // the layout index in the shader
   GLuint layoutIndex;
   // number of components / array members
@@ -18,4 +18,6 @@ struct VertexAttribute
   GLsizei stride;
   // the offset of the first component of the first generic vertex attribute in the array in the data store of the buffer currently bound to the GL_ARRAY_BUFFER target
   const void *offset;
+  // whether the attribute is read as integer (ivec / uvec) in the shader instead of being converted to float
+  bool integer;
 };
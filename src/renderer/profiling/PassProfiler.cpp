@@ -0,0 +1,157 @@
+/*
+  File: PassProfiler.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "PassProfiler.h"
+
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+  constexpr const char *PASS_NAMES[RENDER_PASS_COUNT] = {"depth pre-pass", "opaque", "cutout", "translucent", "weighted blended"};
+}
+
+PassProfiler::PassProfiler()
+{
+  for (auto &frame : frames)
+  {
+    glGenQueries(RENDER_PASS_COUNT, frame.timers.data());
+    glGenQueries(RENDER_PASS_COUNT, frame.samples.data());
+  }
+}
+
+PassProfiler::~PassProfiler()
+{
+  for (auto &frame : frames)
+  {
+    glDeleteQueries(RENDER_PASS_COUNT, frame.timers.data());
+    glDeleteQueries(RENDER_PASS_COUNT, frame.samples.data());
+  }
+}
+
+/// @brief Start measuring a pass, passes can't overlap
+void PassProfiler::beginPass(RenderPass pass)
+{
+  if (passActive)
+    endPass();
+
+  auto index = static_cast<size_t>(pass);
+  auto &frame = frames[frameIndex];
+
+  glBeginQuery(GL_TIME_ELAPSED, frame.timers[index]);
+  glBeginQuery(GL_SAMPLES_PASSED, frame.samples[index]);
+  frame.issued[index] = true;
+  passActive = true;
+}
+
+void PassProfiler::endPass()
+{
+  if (!passActive)
+    return;
+
+  glEndQuery(GL_SAMPLES_PASSED);
+  glEndQuery(GL_TIME_ELAPSED);
+  passActive = false;
+}
+
+/// @brief Close the queries of the frame and read the ones issued QUERY_FRAMES frames ago
+/// @param pixelCount pixels of the viewport the passes drew to
+void PassProfiler::endFrame(uint64_t pixelCount)
+{
+  endPass();
+
+  frames[frameIndex].pixelCount = pixelCount;
+  frames[frameIndex].pending = true;
+
+  frameIndex = (frameIndex + 1) % QUERY_FRAMES;
+  if (frames[frameIndex].pending)
+    collect(frames[frameIndex]);
+
+  if (collectedFrames < REPORT_INTERVAL)
+    return;
+
+  for (size_t pass = 0; pass < RENDER_PASS_COUNT; ++pass)
+  {
+    passTimes[pass] = static_cast<float>(static_cast<double>(passNanoseconds[pass]) / collectedFrames / 1e6);
+    passNanoseconds[pass] = 0;
+  }
+
+  overdraw = pixels > 0 ? static_cast<float>(static_cast<double>(litSamples) / static_cast<double>(pixels)) : 0.0f;
+  litSamples = pixels = 0;
+  collectedFrames = 0;
+
+  logStats();
+}
+
+void PassProfiler::logStats() const
+{
+  std::cout << "[PassProfiler] " << std::fixed << std::setprecision(3);
+  for (size_t pass = 0; pass < RENDER_PASS_COUNT; ++pass)
+    std::cout << PASS_NAMES[pass] << " " << passTimes[pass] << " ms, ";
+
+  std::cout << std::setprecision(2) << "overdraw " << overdraw << "x" << std::defaultfloat << std::endl;
+}
+
+// getters
+
+/// @return GPU milliseconds per frame of a pass, averaged over the last report interval
+float PassProfiler::getPassTime(RenderPass pass) const
+{
+  return passTimes[static_cast<size_t>(pass)];
+}
+
+/// @return lit fragments per pixel, averaged over the last report interval
+float PassProfiler::getOverdraw() const
+{
+  return overdraw;
+}
+
+// ------- private ------- //
+
+/// @brief Add the results of a frame, a frame whose results are not in yet is dropped since its queries get reused now
+void PassProfiler::collect(FrameQueries &frame)
+{
+  // QUERY_FRAMES frames later the results are usually in, but reading one that isn't would wait for the GPU
+  bool available = true;
+  for (size_t pass = 0; pass < RENDER_PASS_COUNT && available; ++pass)
+  {
+    if (!frame.issued[pass])
+      continue;
+
+    GLuint timerAvailable = GL_FALSE, samplesAvailable = GL_FALSE;
+    glGetQueryObjectuiv(frame.timers[pass], GL_QUERY_RESULT_AVAILABLE, &timerAvailable);
+    glGetQueryObjectuiv(frame.samples[pass], GL_QUERY_RESULT_AVAILABLE, &samplesAvailable);
+    available = timerAvailable && samplesAvailable;
+  }
+
+  if (!available)
+  {
+    frame.issued.fill(false);
+    frame.pending = false;
+    return;
+  }
+
+  for (size_t pass = 0; pass < RENDER_PASS_COUNT; ++pass)
+  {
+    if (!frame.issued[pass])
+      continue;
+
+    GLuint64 nanoseconds = 0, samples = 0;
+    glGetQueryObjectui64v(frame.timers[pass], GL_QUERY_RESULT, &nanoseconds);
+    glGetQueryObjectui64v(frame.samples[pass], GL_QUERY_RESULT, &samples);
+
+    passNanoseconds[pass] += nanoseconds;
+    if (pass == static_cast<size_t>(RenderPass::Opaque) || pass == static_cast<size_t>(RenderPass::Cutout))
+      litSamples += samples;
+
+    frame.issued[pass] = false;
+  }
+
+  pixels += frame.pixelCount;
+  frame.pending = false;
+  ++collectedFrames;
+}
\ No newline at end of file
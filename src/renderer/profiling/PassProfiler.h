@@ -0,0 +1,78 @@
+/*
+  File: PassProfiler.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glad/glad.h>
+
+enum class RenderPass : uint32_t
+{
+  DepthPrepass = 0,
+  Opaque = 1,
+  Cutout = 2,
+  Translucent = 3,     // sorted blending
+  WeightedBlended = 4, // accumulation and composite of order independent transparency
+};
+
+constexpr size_t RENDER_PASS_COUNT = 5;
+
+/// @brief GPU time and passed fragments of the scene passes, measured with timer and samples passed queries.
+/// Results are read a few frames late so the queries never stall the pipeline, and averaged over a report interval.
+///
+/// The overdraw is the number of lit fragments (opaque and cutout passes) per pixel. Compared with the pass times,
+/// it tells whether the depth pre-pass pays off for a scene: it only does when the lit passes save more than the
+/// pre-pass costs.
+class PassProfiler
+{
+public:
+  PassProfiler();
+  ~PassProfiler();
+
+  PassProfiler(const PassProfiler &) = delete;
+  PassProfiler &operator=(const PassProfiler &) = delete;
+
+  void beginPass(RenderPass pass);
+  void endPass();
+  void endFrame(uint64_t pixelCount);
+
+  void logStats() const;
+
+  // getters
+  float getPassTime(RenderPass pass) const;
+  float getOverdraw() const;
+
+  static constexpr size_t QUERY_FRAMES = 4;        // frames a result is read after its pass ran
+  static constexpr uint32_t REPORT_INTERVAL = 600; // frames averaged per report
+
+private:
+  struct FrameQueries
+  {
+    std::array<GLuint, RENDER_PASS_COUNT> timers{};
+    std::array<GLuint, RENDER_PASS_COUNT> samples{};
+    std::array<bool, RENDER_PASS_COUNT> issued{};
+    uint64_t pixelCount = 0;
+    bool pending = false;
+  };
+
+  std::array<FrameQueries, QUERY_FRAMES> frames;
+  size_t frameIndex = 0;
+  bool passActive = false;
+
+  // sums since the last report
+  std::array<uint64_t, RENDER_PASS_COUNT> passNanoseconds{};
+  uint64_t litSamples = 0, pixels = 0;
+  uint32_t collectedFrames = 0;
+
+  // averages of the last report
+  std::array<float, RENDER_PASS_COUNT> passTimes{};
+  float overdraw = 0.0f;
+
+  void collect(FrameQueries &frame);
+};
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 #include "RenderEntity.h"
 
-size_t RenderEntity::nextId = 0;
+std::atomic<size_t> RenderEntity::nextId = 0;
 
 RenderEntity::RenderEntity(uMeshPtr mesh, uMaterialPtr mat)
     : transform(), mesh(std::move(mesh)), material(std::move(mat)), id(nextId++)
@@ -16,16 +16,40 @@ RenderEntity::RenderEntity(uMeshPtr mesh, uMaterialPtr mat)
 
 RenderEntity::~RenderEntity()
 {
+  if (store)
+    store->destroy(handle);
 }
 
 void RenderEntity::setMesh(uMeshPtr mesh)
 {
   this->mesh = std::move(mesh);
+  if (store)
+    store->setMesh(handle, this->mesh.get());
 }
 
 void RenderEntity::setMaterial(uMaterialPtr material)
 {
   this->material = std::move(material);
+  if (store)
+    store->setMaterial(handle, this->material.get());
+}
+
+/// @brief Pick which passes handle the entity, e.g. emitters don't need light lists
+/// @param tags combination of EntityTag flags
+void RenderEntity::setTags(EntityTags tags)
+{
+  this->tags = tags;
+  if (store)
+    store->setTags(handle, tags);
+}
+
+/// @brief Bounding sphere used for culling
+/// @param bounds sphere in transform space
+void RenderEntity::setBounds(const Bounds &bounds)
+{
+  this->bounds = bounds;
+  if (store)
+    store->setBounds(handle, bounds);
 }
 
 Transform &RenderEntity::getTransform()
@@ -52,3 +76,19 @@ size_t RenderEntity::getId() const
 {
   return id;
 }
+
+/// @return the handle in the scene's EntityStore, invalid while the entity isn't part of a scene
+EntityHandle RenderEntity::getHandle() const
+{
+  return handle;
+}
+
+EntityTags RenderEntity::getTags() const
+{
+  return tags;
+}
+
+const Bounds &RenderEntity::getBounds() const
+{
+  return bounds;
+}
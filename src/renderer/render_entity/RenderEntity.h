@@ -7,10 +7,15 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "renderer/mesh/Mesh.h"
 #include "renderer/material/Material.h"
 #include "renderer/transform/Transform.h"
+#include "renderer/scene/EntityStore.h"
 
+/// @brief Owner of the mesh, material and transform of one renderable. Once added to a Scene, the components are
+/// drawn from the scene's EntityStore, setters keep the store's copy up to date.
 class RenderEntity
 {
 public:
@@ -19,8 +24,13 @@ public:
 
   void setMesh(uMeshPtr mesh);
   void setMaterial(uMaterialPtr material);
+  void setTags(EntityTags tags);
+  void setBounds(const Bounds &bounds);
 
   size_t getId() const;
+  EntityHandle getHandle() const;
+  EntityTags getTags() const;
+  const Bounds &getBounds() const;
 
   Transform &getTransform();
   const Transform &getTransform() const; // read only access
@@ -29,10 +39,17 @@ public:
   Material *getMaterial();
 
 private:
-  // TODO: Solid method for unique IDs
-  static size_t nextId;
+  friend class Scene;
+
+  static std::atomic<size_t> nextId;
   size_t id;
 
+  // set while the entity is part of a scene
+  EntityStore *store = nullptr;
+  EntityHandle handle;
+  EntityTags tags = EntityTag::Default;
+  Bounds bounds;
+
   Transform transform;
 
   uMeshPtr mesh;
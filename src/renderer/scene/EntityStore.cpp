@@ -0,0 +1,207 @@
+/*
+  File: EntityStore.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "EntityStore.h"
+
+/// @brief Add an entity
+/// @param transform the transform placing it, owned by the caller
+/// @param mesh the mesh to draw, owned by the caller
+/// @param material the material to draw with, owned by the caller
+/// @param bounds bounding sphere around the mesh in transform space
+/// @param tags picks the archetype
+/// @return handle of the new entity
+EntityHandle EntityStore::create(TransformHandle transform, Mesh *mesh, Material *material, const Bounds &bounds, EntityTags tags)
+{
+  uint32_t index;
+  if (!freeRecords.empty())
+  {
+    index = freeRecords.back();
+    freeRecords.pop_back();
+  }
+  else
+  {
+    index = static_cast<uint32_t>(records.size());
+    records.emplace_back();
+  }
+
+  auto &record = records[index];
+  EntityHandle handle{index, record.generation};
+
+  record.archetype = getArchetype(tags);
+  record.row = appendRow(record.archetype, handle, transform, mesh, material, bounds);
+  record.alive = true;
+  ++count;
+
+  return handle;
+}
+
+/// @brief Remove an entity, its handle and every copy of it become stale
+/// @return false if the handle was already stale
+bool EntityStore::destroy(EntityHandle handle)
+{
+  if (!find(handle))
+    return false;
+
+  auto &record = records[handle.index];
+  removeRow(record.archetype, record.row);
+
+  record.alive = false;
+  ++record.generation;
+  freeRecords.push_back(handle.index);
+  --count;
+
+  return true;
+}
+
+bool EntityStore::isAlive(EntityHandle handle) const
+{
+  return find(handle) != nullptr;
+}
+
+// setters
+
+/// @brief Move an entity to the archetype of other tags
+void EntityStore::setTags(EntityHandle handle, EntityTags tags)
+{
+  const auto *record = find(handle);
+  if (!record || archetypes[record->archetype].tags == tags)
+    return;
+
+  // copy the row out first, adding the archetype may reallocate the list
+  const auto &source = archetypes[record->archetype];
+  TransformHandle transform = source.transforms[record->row];
+  Mesh *mesh = source.meshes[record->row];
+  Material *material = source.materials[record->row];
+  Bounds bounds = source.bounds[record->row];
+
+  uint32_t target = getArchetype(tags);
+  removeRow(records[handle.index].archetype, records[handle.index].row);
+
+  records[handle.index].archetype = target;
+  records[handle.index].row = appendRow(target, handle, transform, mesh, material, bounds);
+}
+
+void EntityStore::setMesh(EntityHandle handle, Mesh *mesh)
+{
+  if (const auto *record = find(handle))
+    archetypes[record->archetype].meshes[record->row] = mesh;
+}
+
+void EntityStore::setMaterial(EntityHandle handle, Material *material)
+{
+  if (const auto *record = find(handle))
+    archetypes[record->archetype].materials[record->row] = material;
+}
+
+void EntityStore::setBounds(EntityHandle handle, const Bounds &bounds)
+{
+  if (const auto *record = find(handle))
+    archetypes[record->archetype].bounds[record->row] = bounds;
+}
+
+// getters
+
+EntityTags EntityStore::getTags(EntityHandle handle) const
+{
+  const auto *record = find(handle);
+  return record ? archetypes[record->archetype].tags : EntityTag::None;
+}
+
+TransformHandle EntityStore::getTransform(EntityHandle handle) const
+{
+  const auto *record = find(handle);
+  return record ? archetypes[record->archetype].transforms[record->row] : INVALID_TRANSFORM;
+}
+
+Mesh *EntityStore::getMesh(EntityHandle handle) const
+{
+  const auto *record = find(handle);
+  return record ? archetypes[record->archetype].meshes[record->row] : nullptr;
+}
+
+Material *EntityStore::getMaterial(EntityHandle handle) const
+{
+  const auto *record = find(handle);
+  return record ? archetypes[record->archetype].materials[record->row] : nullptr;
+}
+
+Bounds EntityStore::getBounds(EntityHandle handle) const
+{
+  const auto *record = find(handle);
+  return record ? archetypes[record->archetype].bounds[record->row] : Bounds();
+}
+
+/// @return all archetypes, empty ones included, iterate these instead of looking entities up one by one
+std::span<const EntityArchetype> EntityStore::getArchetypes() const
+{
+  return std::span<const EntityArchetype>(archetypes.data(), archetypes.size());
+}
+
+size_t EntityStore::getCount() const
+{
+  return count;
+}
+
+// ------- private ------- //
+
+const EntityStore::EntityRecord *EntityStore::find(EntityHandle handle) const
+{
+  if (handle.index >= records.size())
+    return nullptr;
+
+  const auto &record = records[handle.index];
+  return record.alive && record.generation == handle.generation ? &record : nullptr;
+}
+
+uint32_t EntityStore::getArchetype(EntityTags tags)
+{
+  for (size_t i = 0; i < archetypes.size(); ++i)
+  {
+    if (archetypes[i].tags == tags)
+      return static_cast<uint32_t>(i);
+  }
+
+  archetypes.emplace_back().tags = tags;
+  return static_cast<uint32_t>(archetypes.size() - 1);
+}
+
+uint32_t EntityStore::appendRow(uint32_t archetype, EntityHandle handle, TransformHandle transform, Mesh *mesh,
+                                Material *material, const Bounds &bounds)
+{
+  auto &target = archetypes[archetype];
+  target.entities.push_back(handle);
+  target.transforms.push_back(transform);
+  target.meshes.push_back(mesh);
+  target.materials.push_back(material);
+  target.bounds.push_back(bounds);
+
+  return static_cast<uint32_t>(target.size() - 1);
+}
+
+/// @brief Fill the gap with the last row of the archetype, so the arrays stay dense
+void EntityStore::removeRow(uint32_t archetype, uint32_t row)
+{
+  auto &source = archetypes[archetype];
+  size_t last = source.size() - 1;
+
+  if (row != last)
+  {
+    source.entities[row] = source.entities[last];
+    source.transforms[row] = source.transforms[last];
+    source.meshes[row] = source.meshes[last];
+    source.materials[row] = source.materials[last];
+    source.bounds[row] = source.bounds[last];
+
+    records[source.entities[row].index].row = row;
+  }
+
+  source.entities.pop_back();
+  source.transforms.pop_back();
+  source.meshes.pop_back();
+  source.materials.pop_back();
+  source.bounds.pop_back();
+}
\ No newline at end of file
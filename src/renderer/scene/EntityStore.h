@@ -0,0 +1,119 @@
+/*
+  File: EntityStore.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "renderer/transform/TransformStore.h"
+
+class Mesh;
+class Material;
+
+/// @brief Generational reference to an entity, stale once the entity is destroyed even if its slot gets reused
+struct EntityHandle
+{
+  uint32_t index = ~uint32_t(0);
+  uint32_t generation = 0;
+
+  bool isValid() const { return index != ~uint32_t(0); }
+  bool operator==(const EntityHandle &other) const = default;
+};
+
+using EntityTags = uint32_t;
+
+/// @brief Flags that decide which archetype an entity lives in, so passes can skip whole archetypes instead of testing per entity
+namespace EntityTag
+{
+  enum : EntityTags
+  {
+    None = 0,
+    LightReceiver = 1 << 0, // gets per entity light lists in the lit pass
+    ShadowCaster = 1 << 1,  // drawn into the shadow cascades
+    Default = LightReceiver | ShadowCaster
+  };
+}
+
+/// @brief Bounding sphere in the local space of the entity's transform
+struct Bounds
+{
+  glm::vec3 center = glm::vec3(0.0f);
+  float radius = 0.8660254f; // unit cube
+
+  /// @brief The sphere in world space, scaled by the largest axis scale of the model matrix
+  Bounds transformed(const glm::mat4 &model) const
+  {
+    float scale = glm::max(glm::length(glm::vec3(model[0])), glm::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+    return Bounds{glm::vec3(model * glm::vec4(center, 1.0f)), radius * scale};
+  }
+};
+
+/// @brief Dense storage of all entities sharing the same tags. Row i of every array belongs to the same entity.
+struct EntityArchetype
+{
+  EntityTags tags = EntityTag::None;
+
+  std::vector<EntityHandle> entities;
+  std::vector<TransformHandle> transforms;
+  std::vector<Mesh *> meshes;
+  std::vector<Material *> materials;
+  std::vector<Bounds> bounds;
+
+  size_t size() const { return entities.size(); }
+};
+
+/// @brief Renderable components of all entities of a scene, grouped into archetypes by their tags.
+/// Creating, destroying and re-tagging are O(1): rows are appended, and removed by moving the last row of the
+/// archetype into the gap. Entity handles go through a slot table, so they stay valid while rows move.
+/// Transforms, meshes and materials are referenced, not owned.
+class EntityStore
+{
+public:
+  EntityHandle create(TransformHandle transform, Mesh *mesh, Material *material,
+                      const Bounds &bounds = Bounds(), EntityTags tags = EntityTag::Default);
+  bool destroy(EntityHandle handle);
+  bool isAlive(EntityHandle handle) const;
+
+  // setters
+  void setTags(EntityHandle handle, EntityTags tags);
+  void setMesh(EntityHandle handle, Mesh *mesh);
+  void setMaterial(EntityHandle handle, Material *material);
+  void setBounds(EntityHandle handle, const Bounds &bounds);
+
+  // getters
+  EntityTags getTags(EntityHandle handle) const;
+  TransformHandle getTransform(EntityHandle handle) const;
+  Mesh *getMesh(EntityHandle handle) const;
+  Material *getMaterial(EntityHandle handle) const;
+  Bounds getBounds(EntityHandle handle) const;
+  std::span<const EntityArchetype> getArchetypes() const;
+  size_t getCount() const;
+
+private:
+  /// @brief Where a handle's components currently are
+  struct EntityRecord
+  {
+    uint32_t generation = 0;
+    uint32_t archetype = 0;
+    uint32_t row = 0;
+    bool alive = false;
+  };
+
+  std::vector<EntityRecord> records;
+  std::vector<uint32_t> freeRecords;
+  std::vector<EntityArchetype> archetypes; // only a handful, found by a linear search
+  size_t count = 0;
+
+  const EntityRecord *find(EntityHandle handle) const;
+  uint32_t getArchetype(EntityTags tags);
+  uint32_t appendRow(uint32_t archetype, EntityHandle handle, TransformHandle transform, Mesh *mesh,
+                     Material *material, const Bounds &bounds);
+  void removeRow(uint32_t archetype, uint32_t row);
+};
\ No newline at end of file
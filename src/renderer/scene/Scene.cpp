@@ -7,17 +7,131 @@
 
 #include "Scene.h"
 
-void Scene::addEntity(uRenderEntityPtr entity)
+#include "renderer/transform/TransformStore.h"
+
+/// @brief Take ownership of an entity and add its components to the entity store
+/// @param entity the entity
+/// @return handle to remove the entity with again
+EntityHandle Scene::addEntity(uRenderEntityPtr entity)
 {
-    this->renderEntities.push_back(std::move(entity));
+    invalidateShadows(*entity);
+
+    EntityHandle handle = entityStore.create(entity->getTransform().getHandle(), entity->getMesh(), entity->getMaterial(),
+                                             entity->getBounds(), entity->getTags());
+    entity->store = &entityStore;
+    entity->handle = handle;
+
+    if ((entity->getTags() & EntityTag::ShadowCaster) && !entity->getMesh()->isUploaded())
+        pendingUploads.push_back(handle);
+
+    if (handle.index >= renderEntities.size())
+    {
+        renderEntities.resize(handle.index + 1);
+        shadowBounds.resize(handle.index + 1);
+    }
+    shadowBounds[handle.index] = entity->getBounds().transformed(entity->getTransform().getModelMatrix());
+    renderEntities[handle.index] = std::move(entity);
+
+    return handle;
 }
 
-std::span<const uRenderEntityPtr> Scene::getEntities() const
+/// @brief Remove and destroy an entity
+/// @param handle the handle addEntity() returned
+/// @return false if the entity was already removed
+bool Scene::removeEntity(EntityHandle handle)
 {
-    return std::span<const uRenderEntityPtr>(this->renderEntities.data(), this->renderEntities.size());
+    if (!entityStore.isAlive(handle))
+        return false;
+
+    invalidateShadows(*renderEntities[handle.index]);
+    renderEntities[handle.index].reset(); // detaches from the store
+
+    return true;
+}
+
+/// @brief Keep the cached shadow cascades in sync with the casters, call once per frame after the uploads ran and the
+/// transforms were updated. Only the regions around casters whose mesh arrived on the GPU or that moved are invalidated.
+void Scene::updateShadowCasters()
+{
+    // a moved caster leaves a stale shadow where it was and is missing where it is now
+    auto &transformStore = TransformStore::getInstance();
+    if (transformStore.hasWorldChanges())
+    {
+        for (size_t index = 0; index < renderEntities.size(); ++index)
+        {
+            RenderEntity *entity = renderEntities[index].get();
+            if (!entity || !(entity->getTags() & EntityTag::ShadowCaster) || !transformStore.hasWorldChanged(entity->getTransform().getHandle()))
+                continue;
+
+            invalidateShadows(shadowBounds[index]);
+            shadowBounds[index] = entity->getBounds().transformed(entity->getTransform().getModelMatrix());
+            invalidateShadows(shadowBounds[index]);
+        }
+    }
+
+    for (size_t i = 0; i < pendingUploads.size();)
+    {
+        RenderEntity *entity = getEntity(pendingUploads[i]);
+        if (entity && !entity->getMesh()->isUploaded())
+        {
+            ++i;
+            continue;
+        }
+
+        if (entity)
+            invalidateShadows(*entity);
+
+        pendingUploads[i] = pendingUploads.back();
+        pendingUploads.pop_back();
+    }
+}
+
+/// @return the entity, nullptr if the handle is stale
+RenderEntity *Scene::getEntity(EntityHandle handle)
+{
+    return entityStore.isAlive(handle) ? renderEntities[handle.index].get() : nullptr;
+}
+
+const EntityStore &Scene::getEntityStore() const
+{
+    return this->entityStore;
+}
+
+/// @brief Place the scene in the world, e.g. at the corner of the region it covers. Keeping positions relative
+/// to a nearby origin keeps them small enough for floats, however large the world is.
+/// @param origin world position in double precision
+void Scene::setOrigin(const glm::dvec3 &origin)
+{
+    this->origin = origin;
+}
+
+const glm::dvec3 &Scene::getOrigin() const
+{
+    return this->origin;
 }
 
 LightManager *Scene::getLightManager()
 {
     return &this->lightManager;
+}
+
+CascadedShadowMap *Scene::getShadowMap()
+{
+    return &this->shadowMap;
+}
+
+// ------- private ------- //
+
+/// @brief Static geometry appearing or disappearing changes what the cached shadow cascades around it should contain
+void Scene::invalidateShadows(const RenderEntity &entity)
+{
+    if (!(entity.getTags() & EntityTag::ShadowCaster))
+        return;
+
+    invalidateShadows(entity.getBounds().transformed(entity.getTransform().getModelMatrix()));
+}
+
+void Scene::invalidateShadows(const Bounds &bounds)
+{
+    shadowMap.invalidateRegion(bounds.center - glm::vec3(bounds.radius), bounds.center + glm::vec3(bounds.radius));
 }
\ No newline at end of file
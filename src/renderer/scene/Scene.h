@@ -11,23 +11,45 @@
 #include <span>
 
 #include "renderer/render_entity/RenderEntity.h"
+#include "renderer/scene/EntityStore.h"
 #include "renderer/light/lights/DirectionalLight.h"
 #include "renderer/light/lights/SpotLight.h"
 #include "renderer/light/lights/PointLight.h"
 #include "renderer/light/LightManager.h"
+#include "renderer/shadow/CascadedShadowMap.h"
 
 class Scene
 {
 public:
   Scene() = default;
 
-  void addEntity(uRenderEntityPtr entity);
+  EntityHandle addEntity(uRenderEntityPtr entity);
+  bool removeEntity(EntityHandle handle);
+  void updateShadowCasters();
 
-  std::span<const uRenderEntityPtr> getEntities() const;
+  RenderEntity *getEntity(EntityHandle handle);
+  const EntityStore &getEntityStore() const;
+  void setOrigin(const glm::dvec3 &origin);
+  const glm::dvec3 &getOrigin() const;
   LightManager *getLightManager();
+  CascadedShadowMap *getShadowMap();
 
 private:
+  // hot components for the passes, declared first so the owners below detach from it before it goes away
+  EntityStore entityStore;
+  // cold owners of the components, indexed like the handles
   std::vector<uRenderEntityPtr> renderEntities;
 
   LightManager lightManager = LightManager();
+  CascadedShadowMap shadowMap;
+  // shadow casters whose mesh upload is still queued, the cascades around them are invalidated once it ran
+  std::vector<EntityHandle> pendingUploads;
+  // world bounds the cascades were last invalidated with per shadow caster, indexed like the handles
+  std::vector<Bounds> shadowBounds;
+
+  // world position of the scene's 0, entity and light positions are relative to it
+  glm::dvec3 origin = glm::dvec3(0.0);
+
+  void invalidateShadows(const RenderEntity &entity);
+  void invalidateShadows(const Bounds &bounds);
 };
\ No newline at end of file
@@ -4,51 +4,115 @@ unsigned int Shader::currentlyActiveShaderProgramId = 0;
 
 Shader::Shader(const char *vertexPath, const char *fragmentPath)
 {
-  std::string vertexShaderCode;
-  std::string fragmentShaderCode;
-  std::ifstream vShaderFile;
-  std::ifstream fShaderFile;
+  std::string vertexShaderCode = readSourceFile(vertexPath);
+  std::string fragmentShaderCode = readSourceFile(fragmentPath);
 
-  // ensure ifstream objects can throw exceptions:
-  vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-  fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-  try
+  if (vertexShaderCode.empty() || fragmentShaderCode.empty())
   {
-    // open files
-    vShaderFile.open(vertexPath);
-    fShaderFile.open(fragmentPath);
+    std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << "VertexShader Path: " << vertexPath << "FragmentShader Path: " << fragmentPath << std::endl;
+  }
 
-    std::stringstream vShaderStream, fShaderStream;
+  std::string name = std::filesystem::path(vertexPath).filename().string() + " + " + std::filesystem::path(fragmentPath).filename().string();
+  buildProgram(name, vertexShaderCode, fragmentShaderCode, "");
+  finish();
+}
 
-    // read the file buffer contents into streams
-    vShaderStream << vShaderFile.rdbuf();
-    fShaderStream << fShaderFile.rdbuf();
+/// @brief Create a program from already preprocessed sources, e.g. a permutation built by the ShaderProvider.
+/// The program is only submitted for compilation, it has to be finished through poll() or finish() before use.
+/// @param name readable name of the program for logging
+/// @param vertexShaderCode the preprocessed vertex shader source
+/// @param fragmentShaderCode the preprocessed fragment shader source
+/// @param defines the injected defines, part of the binary cache key
+/// @param features the feature bits the sources were built with
+/// @param type the shader type of the permutation, so the provider finds its siblings without a lookup
+Shader::Shader(const std::string &name, const std::string &vertexShaderCode, const std::string &fragmentShaderCode,
+               const std::string &defines, ShaderFeatures features, ShaderType type)
+    : features(features), type(type)
+{
+  buildProgram(name, vertexShaderCode, fragmentShaderCode, defines);
+}
 
-    // close file handlers
-    vShaderFile.close();
-    fShaderFile.close();
+/// @brief Read a shader source file into a string in a single read
+/// @param path the path to the source file
+/// @return the source code, empty if the file could not be read
+std::string Shader::readSourceFile(const char *path)
+{
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    return "";
 
-    // convert the streams to strings
-    vertexShaderCode = vShaderStream.str();
-    fragmentShaderCode = fShaderStream.str();
-  }
-  catch (std::ifstream::failure e)
-  {
-    std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << "VertexShader Path: " << vertexPath << "FragmentShader Path: " << fragmentPath << std::endl;
-  }
+  std::string code(static_cast<size_t>(file.tellg()), '\0');
+  file.seekg(0);
+  file.read(code.data(), code.size());
 
-  const char *vShaderCode = vertexShaderCode.c_str();
-  const char *fShaderCode = fragmentShaderCode.c_str();
+  return file ? code : "";
+}
 
-  unsigned int vertexShaderId = compileVertexShader(vShaderCode);
-  unsigned int fragmentShaderId = compileFragmentShader(fShaderCode);
+/// @brief Start building the program, restoring it from the binary cache if possible and submitting it for compilation otherwise.
+/// Compile and link status are not queried here, so drivers compiling in the background are not forced to finish.
+/// @param name readable name of the program for logging
+/// @param vertexShaderCode the vertex shader source
+/// @param fragmentShaderCode the fragment shader source
+/// @param defines the defines that were injected into the sources, part of the cache key
+void Shader::buildProgram(const std::string &name, const std::string &vertexShaderCode, const std::string &fragmentShaderCode, const std::string &defines)
+{
+  this->name = name;
+  this->compileStartTime = std::chrono::steady_clock::now();
+
+  auto &cache = ShaderCache::getInstance();
+  cacheKey = cache.computeKey(vertexShaderCode, fragmentShaderCode, defines);
 
   ID = glCreateProgram();
+
+  if (cache.loadProgram(cacheKey, ID))
+  {
+    bindUniformBlocks();
+    status = ShaderStatus::Ready;
+    std::cout << "[Shader] Loaded program " << name << " from binary cache in " << getElapsedMilliseconds(compileStartTime) << " ms" << std::endl;
+    return;
+  }
+
+  vertexShaderId = compileVertexShader(vertexShaderCode.c_str());
+  fragmentShaderId = compileFragmentShader(fragmentShaderCode.c_str());
+
+  cache.prepareProgram(ID);
   glAttachShader(ID, vertexShaderId);
   glAttachShader(ID, fragmentShaderId);
   glLinkProgram(ID);
 
+  status = ShaderStatus::Pending;
+}
+
+/// @brief Check whether the driver finished compiling and linking without blocking.
+/// Only possible with GL_KHR_parallel_shader_compile, without it the program is reported as still pending.
+/// @param parallelCompileSupported whether GL_COMPLETION_STATUS_KHR may be queried
+/// @return true once the program is ready or failed
+bool Shader::poll(bool parallelCompileSupported)
+{
+  if (status != ShaderStatus::Pending)
+    return true;
+
+  if (!parallelCompileSupported)
+    return false;
+
+  int completed = GL_FALSE;
+  glGetProgramiv(ID, GL_COMPLETION_STATUS_KHR, &completed);
+
+  if (completed)
+    finish();
+
+  return completed;
+}
+
+/// @brief Wait for the program to be compiled and linked, report errors and store the binary in the cache
+void Shader::finish()
+{
+  if (status != ShaderStatus::Pending)
+    return;
+
+  checkCompileStatus(vertexShaderId, "VERTEX");
+  checkCompileStatus(fragmentShaderId, "FRAGMENT");
+
   // print linking errors if any
   int success;
   char infoLog[512];
@@ -58,10 +122,57 @@ Shader::Shader(const char *vertexPath, const char *fragmentPath)
     glGetProgramInfoLog(ID, 512, NULL, infoLog);
     std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n"
               << infoLog << std::endl;
+    status = ShaderStatus::Failed;
+  }
+  else
+  {
+    ShaderCache::getInstance().storeProgram(cacheKey, ID);
+    bindUniformBlocks();
+    status = ShaderStatus::Ready;
+    std::cout << "[Shader] Compiled program " << name << " from source in " << getElapsedMilliseconds(compileStartTime) << " ms" << std::endl;
   }
 
+  glDetachShader(ID, vertexShaderId);
+  glDetachShader(ID, fragmentShaderId);
   glDeleteShader(vertexShaderId);
   glDeleteShader(fragmentShaderId);
+  vertexShaderId = fragmentShaderId = 0;
+}
+
+/// @brief Point the shared uniform blocks the program uses at their binding points, samplers that are not bound
+/// by a material get their fixed texture unit as well
+void Shader::bindUniformBlocks()
+{
+  static constexpr std::pair<const char *, UniformBlockBinding> blocks[] = {
+      {"LightData", UniformBlockBinding::LightDataBinding},
+      {"FrameData", UniformBlockBinding::FrameDataBinding},
+  };
+
+  for (const auto &[blockName, binding] : blocks)
+  {
+    GLuint index = glGetUniformBlockIndex(ID, blockName);
+    if (index != GL_INVALID_INDEX)
+      glUniformBlockBinding(ID, index, binding);
+  }
+
+  GLint faceRecords = glGetUniformLocation(ID, "faceRecords");
+  if (faceRecords >= 0)
+    setInt("faceRecords", FACE_RECORD_TEXTURE_UNIT);
+}
+
+bool Shader::isReady() const
+{
+  return status == ShaderStatus::Ready;
+}
+
+ShaderStatus Shader::getStatus() const
+{
+  return status;
+}
+
+double Shader::getElapsedMilliseconds(std::chrono::steady_clock::time_point startTime)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
 }
 
 void Shader::use()
@@ -76,15 +187,25 @@ void Shader::use()
   }
 }
 
+ShaderFeatures Shader::getFeatures() const
+{
+  return features;
+}
+
+ShaderType Shader::getType() const
+{
+  return type;
+}
+
 /// <summary>
 /// set a boolean uniform value on the shader program
 /// </summary>
 /// <param name="name">the name of the uniform attribute</param>
 /// <param name="value">the value to set the uniform to</param>
-void Shader::setBool(const std::string &name, bool value)
+void Shader::setBool(const char *name, bool value)
 {
   use();
-  glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+  glUniform1i(glGetUniformLocation(ID, name), (int)value);
 }
 
 /// <summary>
@@ -92,10 +213,10 @@ void Shader::setBool(const std::string &name, bool value)
 /// </summary>
 /// <param name="name">the name of the uniform attribute</param>
 /// <param name="value">the value to set the uniform to</param>
-void Shader::setInt(const std::string &name, int value)
+void Shader::setInt(const char *name, int value)
 {
   use();
-  glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+  glUniform1i(glGetUniformLocation(ID, name), value);
 }
 
 /// <summary>
@@ -103,109 +224,119 @@ void Shader::setInt(const std::string &name, int value)
 /// </summary>
 /// <param name="name">the name of the uniform attribute</param>
 /// <param name="value">the value to set the uniform to</param>
-void Shader::setFloat(const std::string &name, float value)
+void Shader::setFloat(const char *name, float value)
 {
   use();
-  glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+  glUniform1f(glGetUniformLocation(ID, name), value);
 }
 
-void Shader::setVec2(const std::string &name, const glm::vec2 &value)
+void Shader::setVec2(const char *name, const glm::vec2 &value)
 {
   use();
-  glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+  glUniform2fv(glGetUniformLocation(ID, name), 1, &value[0]);
 }
 
-void Shader::setVec2(const std::string &name, float x, float y)
+void Shader::setVec2(const char *name, float x, float y)
 {
   use();
-  glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+  glUniform2f(glGetUniformLocation(ID, name), x, y);
 }
 
 // ------------------------------------------------------------------------
-void Shader::setVec3(const std::string &name, const glm::vec3 &value)
+void Shader::setVec3(const char *name, const glm::vec3 &value)
 {
   use();
-  glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+  glUniform3fv(glGetUniformLocation(ID, name), 1, &value[0]);
 }
 
-void Shader::setVec3(const std::string &name, float x, float y, float z)
+void Shader::setVec3(const char *name, float x, float y, float z)
 {
   use();
-  glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+  glUniform3f(glGetUniformLocation(ID, name), x, y, z);
 }
 
 // ------------------------------------------------------------------------
-void Shader::setVec4(const std::string &name, const glm::vec4 &value)
+void Shader::setVec4(const char *name, const glm::vec4 &value)
 {
   use();
-  glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+  glUniform4fv(glGetUniformLocation(ID, name), 1, &value[0]);
 }
 
-void Shader::setVec4(const std::string &name, float x, float y, float z, float w)
+void Shader::setVec4(const char *name, float x, float y, float z, float w)
 {
   use();
-  glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+  glUniform4f(glGetUniformLocation(ID, name), x, y, z, w);
 }
 
 // ------------------------------------------------------------------------
-void Shader::setMat2(const std::string &name, const glm::mat2 &mat)
+void Shader::setMat2(const char *name, const glm::mat2 &mat)
 {
   use();
-  glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+  glUniformMatrix2fv(glGetUniformLocation(ID, name), 1, GL_FALSE, &mat[0][0]);
 }
 
 // ------------------------------------------------------------------------
-void Shader::setMat3(const std::string &name, const glm::mat3 &mat)
+void Shader::setMat3(const char *name, const glm::mat3 &mat)
 {
   use();
-  glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+  glUniformMatrix3fv(glGetUniformLocation(ID, name), 1, GL_FALSE, &mat[0][0]);
 }
 
 // ------------------------------------------------------------------------
-void Shader::setMat4(const std::string &name, const glm::mat4 &mat)
+void Shader::setMat4(const char *name, const glm::mat4 &mat)
 {
   use();
-  glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+  glUniformMatrix4fv(glGetUniformLocation(ID, name), 1, GL_FALSE, &mat[0][0]);
 }
 
-unsigned int Shader::compileVertexShader(const char *code)
+// ------------------------------------------------------------------------
+// arrays are set through the name of the array, count elements starting at [0]
+void Shader::setIntArray(const char *name, const int *values, int count)
 {
-  unsigned int vertexShaderId;
-  int success;
-  char infoLog[512];
+  use();
+  glUniform1iv(glGetUniformLocation(ID, name), count, values);
+}
+
+void Shader::setFloatArray(const char *name, const float *values, int count)
+{
+  use();
+  glUniform1fv(glGetUniformLocation(ID, name), count, values);
+}
+
+void Shader::setMat4Array(const char *name, const glm::mat4 *values, int count)
+{
+  use();
+  glUniformMatrix4fv(glGetUniformLocation(ID, name), count, GL_FALSE, &values[0][0][0]);
+}
 
-  vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
+unsigned int Shader::compileVertexShader(const char *code)
+{
+  unsigned int vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
   glShaderSource(vertexShaderId, 1, &code, NULL);
   glCompileShader(vertexShaderId);
 
-  glGetShaderiv(vertexShaderId, GL_COMPILE_STATUS, &success);
-  if (!success)
-  {
-    glGetShaderInfoLog(vertexShaderId, 512, NULL, infoLog);
-    std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n"
-              << infoLog << std::endl;
-  };
-
   return vertexShaderId;
 }
 
 unsigned int Shader::compileFragmentShader(const char *code)
 {
-  unsigned int fragmentShaderId;
-  int success;
-  char infoLog[512];
-
-  fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
+  unsigned int fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
   glShaderSource(fragmentShaderId, 1, &code, NULL);
   glCompileShader(fragmentShaderId);
 
-  glGetShaderiv(fragmentShaderId, GL_COMPILE_STATUS, &success);
+  return fragmentShaderId;
+}
+
+void Shader::checkCompileStatus(unsigned int shaderId, const char *stage)
+{
+  int success;
+  char infoLog[512];
+
+  glGetShaderiv(shaderId, GL_COMPILE_STATUS, &success);
   if (!success)
   {
-    glGetShaderInfoLog(fragmentShaderId, 512, NULL, infoLog);
-    std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n"
+    glGetShaderInfoLog(shaderId, 512, NULL, infoLog);
+    std::cout << "ERROR::SHADER::" << stage << "::COMPILATION_FAILED\n"
               << infoLog << std::endl;
   };
-
-  return fragmentShaderId;
 }
\ No newline at end of file
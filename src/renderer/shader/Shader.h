@@ -3,51 +3,98 @@
 #include <glad/glad.h>
 
 #include <string>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <filesystem>
+#include <utility>
 
 #include <glm/glm.hpp>
 
+#include "renderer/shader/ShaderCache.h"
+#include "renderer/shader/ShaderFeatures.h"
+#include "renderer/shader/ShaderType.h"
+#include "renderer/shader/UniformBlocks.h"
+
+enum class ShaderStatus
+{
+  Pending, // submitted to the driver, compile / link may still be running
+  Ready,
+  Failed,
+};
+
 class Shader
 {
 public:
   unsigned int ID; // shader program id
 
   Shader(const char *vertexPath, const char *fragmentPath);
+  Shader(const std::string &name, const std::string &vertexShaderCode, const std::string &fragmentShaderCode,
+         const std::string &defines, ShaderFeatures features = ShaderFeature::None, ShaderType type = ShaderType::Surface);
 
   void use(); // use/activate the shader
 
+  bool poll(bool parallelCompileSupported);
+  void finish();
+
+  bool isReady() const;
+  ShaderStatus getStatus() const;
+  ShaderFeatures getFeatures() const;
+  ShaderType getType() const;
+
   // --- utility uniform functions
-  void setBool(const std::string &name, bool value);
-  void setInt(const std::string &name, int value);
+  void setBool(const char *name, bool value);
+  void setInt(const char *name, int value);
 
   /// <summary>
   /// set a float uniform value on the shader program
   /// </summary>
   /// <param name="name">the name of the uniform attribute</param>
   /// <param name="value">the value to set the uniform to</param>
-  void setFloat(const std::string &name, float value);
+  void setFloat(const char *name, float value);
 
-  void setMat2(const std::string &name, const glm::mat2 &value);
-  void setMat3(const std::string &name, const glm::mat3 &value);
-  void setMat4(const std::string &name, const glm::mat4 &value);
+  void setMat2(const char *name, const glm::mat2 &value);
+  void setMat3(const char *name, const glm::mat3 &value);
+  void setMat4(const char *name, const glm::mat4 &value);
 
-  void setVec2(const std::string &name, const glm::vec2 &value);
-  void setVec2(const std::string &name, float x, float y);
+  void setVec2(const char *name, const glm::vec2 &value);
+  void setVec2(const char *name, float x, float y);
 
-  void setVec3(const std::string &name, const glm::vec3 &value);
-  void setVec3(const std::string &name, float x, float y, float z);
+  void setVec3(const char *name, const glm::vec3 &value);
+  void setVec3(const char *name, float x, float y, float z);
 
-  void setVec4(const std::string &name, const glm::vec4 &value);
-  void setVec4(const std::string &name, float x, float y, float z, float w);
+  void setVec4(const char *name, const glm::vec4 &value);
+  void setVec4(const char *name, float x, float y, float z, float w);
+
+  void setIntArray(const char *name, const int *values, int count);
+  void setFloatArray(const char *name, const float *values, int count);
+  void setMat4Array(const char *name, const glm::mat4 *values, int count);
 
 protected:
+  void buildProgram(const std::string &name, const std::string &vertexShaderCode, const std::string &fragmentShaderCode, const std::string &defines);
+
   unsigned int compileVertexShader(const char *shaderCode);
   unsigned int compileFragmentShader(const char *shaderCode);
+  void checkCompileStatus(unsigned int shaderId, const char *stage);
+
+  void bindUniformBlocks();
+
+  static std::string readSourceFile(const char *path);
+  static double getElapsedMilliseconds(std::chrono::steady_clock::time_point startTime);
 
 private:
   static unsigned int currentlyActiveShaderProgramId;
+
+  ShaderFeatures features = ShaderFeature::None;
+  ShaderType type = ShaderType::Surface; // the ShaderProvider type the permutation belongs to
+  ShaderStatus status = ShaderStatus::Pending;
+
+  // state of an in-flight compile
+  std::string name;
+  uint64_t cacheKey = 0;
+  unsigned int vertexShaderId = 0, fragmentShaderId = 0;
+  std::chrono::steady_clock::time_point compileStartTime;
 };
 
 using uShaderPtr = std::unique_ptr<Shader>;
@@ -0,0 +1,217 @@
+/*
+  File: ShaderCache.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "ShaderCache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+  constexpr uint32_t CACHE_MAGIC = 0x42563058; // "X0VB"
+  constexpr uint32_t CACHE_VERSION = 1;
+
+  struct CacheEntryHeader
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t binaryFormat;
+    uint32_t binaryLength;
+  };
+}
+
+ShaderCache::ShaderCache()
+{
+}
+
+/// @brief Hash the inputs of a program together with the driver identity
+/// @param vertexSource the (preprocessed) vertex shader source
+/// @param fragmentSource the (preprocessed) fragment shader source
+/// @param defines the defines injected into both stages
+/// @return the cache key
+uint64_t ShaderCache::computeKey(const std::string &vertexSource, const std::string &fragmentSource, const std::string &defines)
+{
+  queryDriver();
+
+  uint64_t key = hash(driverIdentity, 14695981039346656037ull);
+  key = hash(defines, key);
+  key = hash(vertexSource, key);
+  key = hash(fragmentSource, key);
+  return key;
+}
+
+/// @brief Try to restore a program from its cached binary
+/// @param key the cache key of the program
+/// @param program an unlinked program object to load the binary into
+/// @return true if the program was restored and is linked, false if it has to be compiled from source
+bool ShaderCache::loadProgram(uint64_t key, unsigned int program)
+{
+  if (!isSupported())
+    return false;
+
+  auto path = getEntryPath(key);
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+
+  std::error_code error;
+  auto fileSize = std::filesystem::file_size(path, error);
+
+  CacheEntryHeader header{};
+  file.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+  // the binary is the rest of the entry, checked before its length is trusted for the allocation
+  if (!file || error || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.key != key ||
+      header.binaryLength == 0 || header.binaryLength != fileSize - sizeof(header))
+  {
+    std::cout << "[ShaderCache] Discarding malformed cache entry " << path.filename() << std::endl;
+    file.close();
+    std::filesystem::remove(path, error);
+    return false;
+  }
+
+  std::vector<char> binary(header.binaryLength);
+  file.read(binary.data(), binary.size());
+  if (!file)
+  {
+    std::cout << "[ShaderCache] Discarding truncated cache entry " << path.filename() << std::endl;
+    file.close();
+    std::filesystem::remove(path, error);
+    return false;
+  }
+
+  glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+  // the driver rejects binaries from other driver builds, which the key should already catch
+  int success;
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  if (!success)
+  {
+    std::cout << "[ShaderCache] Driver rejected cached binary " << path.filename() << ", recompiling" << std::endl;
+    file.close();
+    std::filesystem::remove(path, error);
+    return false;
+  }
+
+  return true;
+}
+
+/// @brief Write the binary of a linked program to the cache
+/// @param key the cache key of the program
+/// @param program a successfully linked program object
+void ShaderCache::storeProgram(uint64_t key, unsigned int program)
+{
+  if (!isSupported())
+    return;
+
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+    return;
+
+  std::vector<char> binary(length);
+  GLenum binaryFormat = 0;
+  glGetProgramBinary(program, length, nullptr, &binaryFormat, binary.data());
+
+  std::error_code error;
+  std::filesystem::create_directories(cacheDirectory, error);
+  if (error)
+  {
+    std::cerr << "[ShaderCache] Unable to create cache directory " << cacheDirectory << ": " << error.message() << std::endl;
+    return;
+  }
+
+  CacheEntryHeader header{CACHE_MAGIC, CACHE_VERSION, key, binaryFormat, static_cast<uint32_t>(length)};
+
+  // write to a temporary file first so a crash never leaves a truncated entry behind
+  auto path = getEntryPath(key);
+  auto temporaryPath = path;
+  temporaryPath += ".tmp";
+
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(binary.data(), binary.size());
+    if (!file)
+    {
+      std::cerr << "[ShaderCache] Failed writing cache entry " << temporaryPath << std::endl;
+      return;
+    }
+  }
+
+  std::filesystem::rename(temporaryPath, path, error);
+}
+
+/// @brief Must be called on a program before linking it from source, so its binary can be retrieved afterwards
+void ShaderCache::prepareProgram(unsigned int program)
+{
+  if (isSupported())
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+bool ShaderCache::isSupported()
+{
+  queryDriver();
+  return supported;
+}
+
+void ShaderCache::setCacheDirectory(const std::filesystem::path &directory)
+{
+  this->cacheDirectory = directory;
+}
+
+// ------- private ------- //
+
+void ShaderCache::queryDriver()
+{
+  if (driverQueried)
+    return;
+  driverQueried = true;
+
+  auto getString = [](GLenum name)
+  {
+    auto value = reinterpret_cast<const char *>(glGetString(name));
+    return std::string(value ? value : "");
+  };
+
+  driverIdentity = getString(GL_VENDOR) + "|" + getString(GL_RENDERER) + "|" + getString(GL_VERSION) + "|" + getString(GL_SHADING_LANGUAGE_VERSION);
+
+  GLint formatCount = 0;
+  if (GLAD_GL_VERSION_4_1 || GLAD_GL_ARB_get_program_binary)
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+
+  supported = formatCount > 0;
+
+  std::cout << "[ShaderCache] Program binary cache " << (supported ? "enabled" : "not supported by driver") << " (" << driverIdentity << ")" << std::endl;
+}
+
+std::filesystem::path ShaderCache::getEntryPath(uint64_t key) const
+{
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+  return cacheDirectory / name;
+}
+
+/// @brief 64 bit FNV-1a
+uint64_t ShaderCache::hash(const std::string &data, uint64_t seed)
+{
+  uint64_t value = seed;
+  for (unsigned char c : data)
+  {
+    value ^= c;
+    value *= 1099511628211ull;
+  }
+
+  // mix in the length so concatenated inputs can not collide by shifting a boundary
+  value ^= data.size();
+  value *= 1099511628211ull;
+
+  return value;
+}
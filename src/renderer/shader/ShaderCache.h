@@ -0,0 +1,51 @@
+/*
+  File: ShaderCache.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <filesystem>
+#include <glad/glad.h>
+
+/// @brief Disk cache for linked shader program binaries (glGetProgramBinary / glProgramBinary).
+/// Entries are keyed by a hash over the shader sources, the injected defines and the driver identity,
+/// so any change to one of them misses the cache and the program is compiled from source again.
+class ShaderCache
+{
+public:
+  static ShaderCache &getInstance()
+  {
+    static ShaderCache instance;
+    return instance;
+  }
+
+  ShaderCache(const ShaderCache &) = delete;
+  ShaderCache &operator=(const ShaderCache &) = delete;
+
+  uint64_t computeKey(const std::string &vertexSource, const std::string &fragmentSource, const std::string &defines);
+
+  bool loadProgram(uint64_t key, unsigned int program);
+  void storeProgram(uint64_t key, unsigned int program);
+  void prepareProgram(unsigned int program);
+
+  bool isSupported();
+  void setCacheDirectory(const std::filesystem::path &directory);
+
+private:
+  ShaderCache();
+  ~ShaderCache() = default;
+
+  bool supported = false;
+  bool driverQueried = false;
+  std::string driverIdentity;
+  std::filesystem::path cacheDirectory = "../cache/shaders";
+
+  void queryDriver();
+  std::filesystem::path getEntryPath(uint64_t key) const;
+  static uint64_t hash(const std::string &data, uint64_t seed);
+};
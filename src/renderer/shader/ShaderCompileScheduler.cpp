@@ -0,0 +1,93 @@
+/*
+  File: ShaderCompileScheduler.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "ShaderCompileScheduler.h"
+
+#include <algorithm>
+
+/// @brief Query parallel compile support and set the driver's compiler thread count. Has to run before the first
+/// program is compiled, the thread count only applies to compiles started afterwards.
+void ShaderCompileScheduler::initialize()
+{
+  if (initialized)
+    return;
+  initialized = true;
+
+  // let the driver pick the number of compiler threads
+  if (GLAD_GL_KHR_parallel_shader_compile)
+  {
+    glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    parallelCompileSupported = true;
+  }
+  else if (GLAD_GL_ARB_parallel_shader_compile)
+  {
+    glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+    parallelCompileSupported = true;
+  }
+
+  std::cout << "[ShaderCompileScheduler] Parallel shader compilation " << (parallelCompileSupported ? "supported" : "not supported, finishing programs incrementally") << std::endl;
+}
+
+/// @brief Track a program whose compilation was started with Shader::buildProgram
+void ShaderCompileScheduler::submit(Shader *shader)
+{
+  if (shader->getStatus() == ShaderStatus::Pending)
+    pending.push_back(shader);
+}
+
+/// @brief Finish every program the driver is done with. Never blocks when parallel compilation is supported,
+/// otherwise finishes up to the configured number of programs.
+void ShaderCompileScheduler::poll()
+{
+  if (pending.empty())
+    return;
+
+  int blockingFinishes = 0;
+
+  auto finished = std::remove_if(pending.begin(), pending.end(), [&](Shader *shader)
+                                 {
+                                   if (shader->poll(parallelCompileSupported))
+                                     return true;
+
+                                   if (!parallelCompileSupported && blockingFinishes < blockingFinishesPerPoll)
+                                   {
+                                     ++blockingFinishes;
+                                     shader->finish();
+                                     return true;
+                                   }
+
+                                   return false; });
+
+  pending.erase(finished, pending.end());
+
+  if (pending.empty())
+    std::cout << "[ShaderCompileScheduler] All submitted programs are compiled" << std::endl;
+}
+
+/// @brief Block until every submitted program is finished, e.g. for loading screens
+void ShaderCompileScheduler::finishAll()
+{
+  for (Shader *shader : pending)
+    shader->finish();
+
+  pending.clear();
+}
+
+bool ShaderCompileScheduler::isParallelCompileSupported() const
+{
+  return parallelCompileSupported;
+}
+
+size_t ShaderCompileScheduler::getPendingCount() const
+{
+  return pending.size();
+}
+
+void ShaderCompileScheduler::setBlockingFinishesPerPoll(int count)
+{
+  this->blockingFinishesPerPoll = std::max(1, count);
+}
@@ -0,0 +1,49 @@
+/*
+  File: ShaderCompileScheduler.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <vector>
+#include <glad/glad.h>
+
+#include "renderer/shader/Shader.h"
+
+/// @brief Tracks programs that were submitted to the driver but not finished yet.
+/// With GL_KHR_parallel_shader_compile the driver compiles on its own threads and completion is polled without
+/// blocking. Without it, pending programs are finished a few per frame so the cost is spread out.
+class ShaderCompileScheduler
+{
+public:
+  static ShaderCompileScheduler &getInstance()
+  {
+    static ShaderCompileScheduler instance;
+    return instance;
+  }
+
+  ShaderCompileScheduler(const ShaderCompileScheduler &) = delete;
+  ShaderCompileScheduler &operator=(const ShaderCompileScheduler &) = delete;
+
+  void initialize();
+
+  void submit(Shader *shader);
+  void poll();
+  void finishAll();
+
+  bool isParallelCompileSupported() const;
+  size_t getPendingCount() const;
+
+  void setBlockingFinishesPerPoll(int count);
+
+private:
+  ShaderCompileScheduler() = default;
+
+  std::vector<Shader *> pending;
+
+  bool initialized = false;
+  bool parallelCompileSupported = false;
+  int blockingFinishesPerPoll = 1; // used when completion can not be polled
+};
\ No newline at end of file
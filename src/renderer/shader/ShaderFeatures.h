@@ -0,0 +1,36 @@
+/*
+  File: ShaderFeatures.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstdint>
+
+using ShaderFeatures = uint32_t;
+
+/// @brief Compile-time features of a shader permutation. Each set bit injects its define into the sources,
+/// so a variant only contains the code it needs. Scoped by a namespace so the names stay out of the global one,
+/// while the values remain plain ShaderFeatures bits that combine with | and &.
+namespace ShaderFeature
+{
+enum : ShaderFeatures
+{
+  None = 0,
+  Emissive = 1 << 0,        // FEATURE_EMISSIVE, samples material.emissive
+  SpecularMap = 1 << 1,     // FEATURE_SPECULAR_MAP, samples material.specular
+  BlinnPhong = 1 << 2,      // LIGHT_MODEL_BLINN_PHONG, halfway vector specular instead of phong
+  PackedVertices = 1 << 3,  // FEATURE_PACKED_VERTICES, vertices in the 8 byte PackedVertex format
+  LayeredTextures = 1 << 4, // FEATURE_TEXTURE_ARRAY, material maps are sampler2DArray indexed by the vertex layer
+  IndirectDraw = 1 << 5,    // FEATURE_INDIRECT_DRAW, GLSL 430, model and light lists come from the draw data buffers
+  AlphaTest = 1 << 6,       // FEATURE_ALPHA_TEST, discards fragments below the alpha cutoff
+  AlphaBlend = 1 << 7,      // FEATURE_ALPHA_BLEND, outputs the diffuse alpha for blending
+  WeightedBlend = 1 << 8,   // FEATURE_WEIGHTED_BLEND, writes to the accumulation targets of weighted blended transparency
+  FacePulling = 1 << 9,     // FEATURE_FACE_PULLING, no vertex attributes, faces are pulled from FaceRecord buffer textures
+};
+}
+
+/// @brief Features that select how the vertex shader reads its vertices, at most one of them is set
+constexpr ShaderFeatures VERTEX_INPUT_FEATURES = ShaderFeature::PackedVertices | ShaderFeature::FacePulling;
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+  File: ShaderPreprocessor.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "ShaderPreprocessor.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "renderer/asset/AssetBundle.h"
+
+/// @brief Expand all includes of a shader and inject the defines right after its #version directive
+/// @param path the shader source file
+/// @param defines name / value pairs, an empty value defines the name as 1
+/// @return the preprocessed source, empty if the file could not be read
+std::string ShaderPreprocessor::process(const std::filesystem::path &path, const ShaderDefines &defines)
+{
+  std::string output;
+  std::unordered_set<std::string> included;
+
+  expandIncludes(path, output, included, 0);
+
+  if (output.empty())
+    return output;
+
+  // defines have to follow the version directive, which must be the first statement of the shader
+  size_t versionStart = output.find("#version");
+  size_t insertAt = versionStart == std::string::npos ? 0 : output.find('\n', versionStart);
+  insertAt = insertAt == std::string::npos ? output.size() : insertAt + 1;
+
+  output.insert(insertAt, toDefineBlock(defines) + "#line 2\n");
+
+  return output;
+}
+
+std::string ShaderPreprocessor::toDefineBlock(const ShaderDefines &defines)
+{
+  std::string block;
+  for (const auto &[name, value] : defines)
+  {
+    block += "#define " + name + " " + (value.empty() ? "1" : value) + "\n";
+  }
+  return block;
+}
+
+/// @brief Replace the #version directive of a processed source, e.g. for permutations that need a newer GLSL
+/// @param source the processed shader source
+/// @param version the new version, e.g. "430 core"
+void ShaderPreprocessor::setVersion(std::string &source, const std::string &version)
+{
+  size_t versionStart = source.find("#version");
+  if (versionStart == std::string::npos)
+  {
+    source.insert(0, "#version " + version + "\n");
+    return;
+  }
+
+  size_t versionEnd = source.find('\n', versionStart);
+  source.replace(versionStart, versionEnd == std::string::npos ? std::string::npos : versionEnd - versionStart, "#version " + version);
+}
+
+// ------- private ------- //
+
+const std::string *ShaderPreprocessor::readFile(const std::filesystem::path &path)
+{
+  auto key = path.lexically_normal().generic_string();
+
+  auto cached = fileCache.find(key);
+  if (cached != fileCache.end())
+    return &cached->second;
+
+  // the bundle holds the sources under the path they had in the assets folder
+  std::string bundled;
+  if (AssetBundle::getInstance().getShaderSource(key, bundled))
+    return &fileCache.emplace(key, std::move(bundled)).first->second;
+
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+  {
+    std::cerr << "[ShaderPreprocessor] Unable to read shader file " << key << std::endl;
+    return nullptr;
+  }
+
+  std::string content(static_cast<size_t>(file.tellg()), '\0');
+  file.seekg(0);
+  file.read(content.data(), content.size());
+
+  return &fileCache.emplace(key, std::move(content)).first->second;
+}
+
+void ShaderPreprocessor::expandIncludes(const std::filesystem::path &path, std::string &output, std::unordered_set<std::string> &included, int depth)
+{
+  if (depth > 16)
+  {
+    std::cerr << "[ShaderPreprocessor] Include depth exceeded at " << path << std::endl;
+    return;
+  }
+
+  // every file is only included once, like #pragma once
+  if (!included.insert(path.lexically_normal().generic_string()).second)
+    return;
+
+  const std::string *source = readFile(path);
+  if (!source)
+    return;
+
+  std::istringstream lines(*source);
+  std::string line;
+  int lineNumber = 0;
+
+  while (std::getline(lines, line))
+  {
+    ++lineNumber;
+
+    size_t directive = line.find_first_not_of(" \t");
+    bool isInclude = directive != std::string::npos && line.compare(directive, 8, "#include") == 0;
+    bool isVersion = directive != std::string::npos && line.compare(directive, 8, "#version") == 0;
+
+    // only the root shader may declare a version
+    if (isVersion && depth > 0)
+      continue;
+
+    if (!isInclude)
+    {
+      output += line;
+      output += '\n';
+      continue;
+    }
+
+    size_t open = line.find('"', directive);
+    size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+
+    if (close == std::string::npos)
+    {
+      std::cerr << "[ShaderPreprocessor] Malformed include in " << path << ":" << lineNumber << std::endl;
+      continue;
+    }
+
+    auto includePath = path.parent_path() / line.substr(open + 1, close - open - 1);
+
+    output += "#line 1\n";
+    expandIncludes(includePath, output, included, depth + 1);
+    output += "#line " + std::to_string(lineNumber + 1) + "\n";
+  }
+}
@@ -0,0 +1,36 @@
+/*
+  File: ShaderPreprocessor.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
+
+/// @brief Resolves #include directives and injects #defines into GLSL sources.
+/// Files are read once and kept in memory, so building many permutations of the same shader stays cheap.
+class ShaderPreprocessor
+{
+public:
+  ShaderPreprocessor() = default;
+
+  std::string process(const std::filesystem::path &path, const ShaderDefines &defines);
+
+  static std::string toDefineBlock(const ShaderDefines &defines);
+  static void setVersion(std::string &source, const std::string &version);
+
+private:
+  std::unordered_map<std::string, std::string> fileCache;
+
+  const std::string *readFile(const std::filesystem::path &path);
+  void expandIncludes(const std::filesystem::path &path, std::string &output, std::unordered_set<std::string> &included, int depth);
+};
\ No newline at end of file
@@ -7,34 +7,66 @@
 
 #include "ShaderProvider.h"
 
+#include <bit>
+
+#include "renderer/light/LightData.h"
+#include "renderer/shadow/CascadedShadowMap.h"
+
 ShaderProvider::ShaderProvider()
 {
-  addShader(ShaderType::Surface, "../assets/shaders/block-shader.vert", "../assets/shaders/surface-shader.frag");
-  addShader(ShaderType::LightBlock, "../assets/shaders/block-shader.vert", "../assets/shaders/light-source-shader.frag");
+  ShaderCompileScheduler::getInstance().initialize();
+
+  addShader(ShaderType::Surface, "../assets/shaders/block-shader.vert", "../assets/shaders/surface-shader.frag",
+            ShaderFeature::Emissive | ShaderFeature::SpecularMap | ShaderFeature::BlinnPhong | ShaderFeature::PackedVertices | ShaderFeature::LayeredTextures |
+                ShaderFeature::IndirectDraw | ShaderFeature::AlphaTest | ShaderFeature::AlphaBlend | ShaderFeature::WeightedBlend |
+                ShaderFeature::FacePulling);
+  addShader(ShaderType::LightBlock, "../assets/shaders/block-shader.vert", "../assets/shaders/light-source-shader.frag",
+            ShaderFeature::PackedVertices | ShaderFeature::FacePulling | ShaderFeature::IndirectDraw);
+  addShader(ShaderType::ShadowDepth, "../assets/shaders/shadow-depth.vert", "../assets/shaders/shadow-depth.frag",
+            ShaderFeature::PackedVertices | ShaderFeature::FacePulling);
+  addShader(ShaderType::DepthPrepass, "../assets/shaders/depth-prepass.vert", "../assets/shaders/shadow-depth.frag",
+            ShaderFeature::PackedVertices | ShaderFeature::FacePulling | ShaderFeature::IndirectDraw);
+  addShader(ShaderType::TransparencyComposite, "../assets/shaders/fullscreen.vert", "../assets/shaders/transparency-composite.frag",
+            ShaderFeature::None);
 }
 
-Shader &ShaderProvider::getShader(ShaderType type)
+/// @brief Get the permutation of a shader type for a set of features. Permutations are submitted for compilation
+/// on first use and shared by every material requesting the same type and features. The returned shader may still
+/// be compiling, use resolve() to get a program that can be drawn with right now.
+/// @param type the shader type
+/// @param features feature bits, bits the type does not support are ignored
+/// @return the shader permutation
+Shader &ShaderProvider::getShader(ShaderType type, ShaderFeatures features)
 {
-  auto result = this->shaders.find(type);
+  auto source = this->sources.find(type);
 
-  if (result != shaders.end())
-    return result->second;
-  else
+  if (source == sources.end())
   {
     std::cout << "[ShaderProvider] Key '" << type << "' does not have a shader associated in the registry." << std::endl;
     throw std::runtime_error("No shader registered for key.");
   }
+
+  features &= source->second.supportedFeatures;
+
+  auto result = variants.find(getVariantKey(type, features));
+  if (result != variants.end())
+    return result->second;
+
+  return compileVariant(type, source->second, features);
 }
 
-void ShaderProvider::addShader(ShaderType type, const char *vertPath, const char *fragPath)
+/// @brief Register the sources of a shader type. Nothing is compiled until a permutation is requested.
+/// @param type the shader type
+/// @param vertPath path to the vertex shader
+/// @param fragPath path to the fragment shader
+/// @param supportedFeatures feature bits the sources react to
+void ShaderProvider::addShader(ShaderType type, const char *vertPath, const char *fragPath, ShaderFeatures supportedFeatures)
 {
   if (!hasShader(type))
   {
-    Shader shader(vertPath, fragPath);
+    std::cout << "[ShaderProvider] Registering Shader " << type << std::endl;
 
-    std::cout << "[ShaderProvider] Registering Shader " << type << " with  id " << shader.ID << std::endl;
-
-    shaders.emplace(type, std::move(shader));
+    sources.emplace(type, ShaderSource{vertPath, fragPath, supportedFeatures});
   }
   else
     std::cout << "[ShaderProvider] Key '" << type << "' already exists in shaders. Skipping adding." << std::endl;
@@ -42,5 +74,150 @@ void ShaderProvider::addShader(ShaderType type, const char *vertPath, const char
 
 bool ShaderProvider::hasShader(ShaderType type)
 {
-  return shaders.find(type) != shaders.end();
+  return sources.find(type) != sources.end();
+}
+
+/// @brief Get a program that can be drawn with right now in place of the requested one. While a permutation is still
+/// compiling, the closest ready permutation with fewer features and the same vertex format, sampler types and alpha mode is used instead.
+/// Only blocks if not even the plain permutation of the type is ready yet.
+/// @param requested a permutation handed out by getShader
+/// @return the requested shader if it is ready, a fallback otherwise
+Shader &ShaderProvider::resolve(Shader &requested)
+{
+  if (requested.getStatus() != ShaderStatus::Pending)
+    return requested;
+
+  ShaderType type = requested.getType();
+  ShaderFeatures features = requested.getFeatures();
+
+  Shader *fallback = nullptr;
+  int fallbackFeatureCount = -1;
+
+  for (auto &[key, shader] : variants)
+  {
+    ShaderFeatures candidateFeatures = shader.getFeatures();
+
+    bool sameType = static_cast<ShaderType>(key >> 32) == type;
+    bool isSubset = (candidateFeatures & ~features) == 0;
+    bool sameRequired = (candidateFeatures & FALLBACK_FEATURES) == (features & FALLBACK_FEATURES);
+
+    if (!sameType || !isSubset || !sameRequired || !shader.isReady())
+      continue;
+
+    int featureCount = std::popcount(candidateFeatures);
+    if (featureCount > fallbackFeatureCount)
+    {
+      fallback = &shader;
+      fallbackFeatureCount = featureCount;
+    }
+  }
+
+  if (fallback)
+    return *fallback;
+
+  // nothing to fall back to, wait for the plain permutation
+  Shader &plain = getShader(type, features & FALLBACK_FEATURES);
+  plain.finish();
+  return plain;
+}
+
+/// @brief Get the permutation of the same type as a shader with additional features, e.g. the indirect draw
+/// variant of a material's shader
+/// @param shader a permutation handed out by getShader
+/// @param addedFeatures features to add to the ones of the shader
+/// @return the permutation, may still be compiling
+Shader &ShaderProvider::getPermutation(Shader &shader, ShaderFeatures addedFeatures)
+{
+  ShaderFeatures features = shader.getFeatures() | addedFeatures;
+  if (features == shader.getFeatures())
+    return shader;
+
+  return getShader(shader.getType(), features);
+}
+
+/// @brief Get all ready permutations of a type, e.g. to set per-frame uniforms on all of them
+/// @param resource memory for the returned list, e.g. the frame arena
+std::pmr::vector<Shader *> ShaderProvider::getVariants(ShaderType type, std::pmr::memory_resource *resource)
+{
+  std::pmr::vector<Shader *> result(resource);
+
+  for (auto &[key, shader] : variants)
+  {
+    if (static_cast<ShaderType>(key >> 32) == type && shader.isReady())
+      result.push_back(&shader);
+  }
+
+  return result;
 }
+
+// ------- private ------- //
+
+Shader &ShaderProvider::compileVariant(ShaderType type, const ShaderSource &source, ShaderFeatures features)
+{
+  auto defines = getDefines(features);
+
+  std::string vertexCode = preprocessor.process(source.vertexPath, defines);
+  std::string fragmentCode = preprocessor.process(source.fragmentPath, defines);
+
+  // storage buffers need GLSL 430, only requested once the context is known to support it
+  if (features & ShaderFeature::IndirectDraw)
+  {
+    ShaderPreprocessor::setVersion(vertexCode, "430 core");
+    ShaderPreprocessor::setVersion(fragmentCode, "430 core");
+  }
+
+  std::string name = std::to_string(type) + ":" + std::to_string(features);
+  auto [variant, inserted] = variants.try_emplace(getVariantKey(type, features),
+                                                  name, vertexCode, fragmentCode, ShaderPreprocessor::toDefineBlock(defines), features, type);
+
+  Shader &shader = variant->second; // iterators do not survive the insert below, references do
+  std::cout << "[ShaderProvider] Submitted permutation " << name << " with id " << shader.ID << std::endl;
+
+  ShaderCompileScheduler::getInstance().submit(&shader);
+
+  // make sure the plain permutation is on its way as well, it is the fallback while this one compiles
+  ShaderFeatures plainFeatures = features & FALLBACK_FEATURES;
+  if (plainFeatures != features && variants.find(getVariantKey(type, plainFeatures)) == variants.end())
+    compileVariant(type, source, plainFeatures);
+
+  return shader;
+}
+
+/// @brief Shared limits are injected so shaders and the CPU side can not go out of sync
+ShaderDefines ShaderProvider::getDefines(ShaderFeatures features) const
+{
+  ShaderDefines defines = {
+      {"MAX_DIRECTIONAL_LIGHTS", std::to_string(MAX_DIRECTIONAL_LIGHTS)},
+      {"MAX_POINT_LIGHTS", std::to_string(MAX_POINT_LIGHTS)},
+      {"MAX_SPOT_LIGHTS", std::to_string(MAX_SPOT_LIGHTS)},
+      {"SHADOW_CASCADE_COUNT", std::to_string(CascadedShadowMap::CASCADE_COUNT)},
+  };
+
+  if (features & ShaderFeature::Emissive)
+    defines.emplace_back("FEATURE_EMISSIVE", "");
+  if (features & ShaderFeature::SpecularMap)
+    defines.emplace_back("FEATURE_SPECULAR_MAP", "");
+  if (features & ShaderFeature::BlinnPhong)
+    defines.emplace_back("LIGHT_MODEL_BLINN_PHONG", "");
+  if (features & ShaderFeature::PackedVertices)
+    defines.emplace_back("FEATURE_PACKED_VERTICES", "");
+  if (features & ShaderFeature::LayeredTextures)
+    defines.emplace_back("FEATURE_TEXTURE_ARRAY", "");
+  if (features & ShaderFeature::IndirectDraw)
+    defines.emplace_back("FEATURE_INDIRECT_DRAW", "");
+  if (features & ShaderFeature::AlphaTest)
+    defines.emplace_back("FEATURE_ALPHA_TEST", "");
+  if (features & ShaderFeature::AlphaBlend)
+    defines.emplace_back("FEATURE_ALPHA_BLEND", "");
+  if (features & ShaderFeature::WeightedBlend)
+    defines.emplace_back("FEATURE_WEIGHTED_BLEND", "");
+  if (features & ShaderFeature::FacePulling)
+    defines.emplace_back("FEATURE_FACE_PULLING", "");
+
+  return defines;
+}
+
+uint64_t ShaderProvider::getVariantKey(ShaderType type, ShaderFeatures features)
+{
+  return (static_cast<uint64_t>(type) << 32) | features;
+}
\ No newline at end of file
@@ -7,10 +7,24 @@
 
 #pragma once
 
+#include <memory_resource>
+#include <string>
+#include <vector>
 #include <unordered_map>
 
 #include "renderer/shader/Shader.h"
 #include "renderer/shader/ShaderType.h"
+#include "renderer/shader/ShaderFeatures.h"
+#include "renderer/shader/ShaderPreprocessor.h"
+#include "renderer/shader/ShaderCompileScheduler.h"
+
+/// @brief Sources of a shader type and the feature bits its permutations may differ in
+struct ShaderSource
+{
+  std::string vertexPath;
+  std::string fragmentPath;
+  ShaderFeatures supportedFeatures;
+};
 
 class ShaderProvider
 {
@@ -21,11 +35,31 @@ public:
     return instance;
   }
 
-  Shader &getShader(ShaderType type);
-  void addShader(ShaderType type, const char *vertPath, const char *fragPath);
+  Shader &getShader(ShaderType type, ShaderFeatures features = ShaderFeature::None);
+  void addShader(ShaderType type, const char *vertPath, const char *fragPath, ShaderFeatures supportedFeatures = ShaderFeature::None);
   bool hasShader(ShaderType type);
 
+  Shader &resolve(Shader &requested);
+  Shader &getPermutation(Shader &shader, ShaderFeatures addedFeatures);
+  std::pmr::vector<Shader *> getVariants(ShaderType type, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
 private:
   ShaderProvider();
-  std::unordered_map<ShaderType, Shader> shaders;
+
+  std::unordered_map<ShaderType, ShaderSource> sources;
+  std::unordered_map<uint64_t, Shader> variants; // node based, references handed out stay valid
+  ShaderPreprocessor preprocessor;
+
+  Shader &compileVariant(ShaderType type, const ShaderSource &source, ShaderFeatures features);
+  ShaderDefines getDefines(ShaderFeatures features) const;
+
+  static uint64_t getVariantKey(ShaderType type, ShaderFeatures features);
+
+  // features that change the vertex input, fragment outputs, sampler types or GLSL version
+  static constexpr ShaderFeatures INTERFACE_FEATURES = ShaderFeature::PackedVertices | ShaderFeature::LayeredTextures | ShaderFeature::IndirectDraw |
+                                                        ShaderFeature::WeightedBlend | ShaderFeature::FacePulling;
+  // features that decide which fragments are kept, without them cutout and translucent surfaces would draw opaque
+  static constexpr ShaderFeatures COVERAGE_FEATURES = ShaderFeature::AlphaTest | ShaderFeature::AlphaBlend;
+  // a fallback program must share these with the requested one
+  static constexpr ShaderFeatures FALLBACK_FEATURES = INTERFACE_FEATURES | COVERAGE_FEATURES;
 };
\ No newline at end of file
@@ -11,4 +11,7 @@ enum ShaderType
 {
   Surface,
   LightBlock,
+  ShadowDepth,
+  DepthPrepass,
+  TransparencyComposite,
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+/*
+  File: UniformBlocks.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+/// @brief Binding points of the uniform blocks shared by all programs. GLSL 330 can not declare them,
+/// programs bind their blocks by name once they are ready.
+enum UniformBlockBinding : unsigned int
+{
+  LightDataBinding = 0, // LightData in lights.glsl
+  FrameDataBinding = 1, // FrameData in frame-data.glsl
+};
+
+// texture unit of the faceRecords buffer texture of pulled meshes, bound with their arena page.
+// Material textures use units 0 to 2 and 4, the shadow map unit 3
+constexpr unsigned int FACE_RECORD_TEXTURE_UNIT = 5;
+
+/// @brief Per frame camera data, laid out to match frame-data.glsl (std140)
+struct FrameData
+{
+  glm::mat4 view;       // rotation only, positions are camera relative
+  glm::mat4 projection;
+};
\ No newline at end of file
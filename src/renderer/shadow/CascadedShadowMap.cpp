@@ -0,0 +1,352 @@
+/*
+  File: CascadedShadowMap.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "CascadedShadowMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+
+CascadedShadowMap::CascadedShadowMap(int resolution, int maxCascadeUpdatesPerFrame)
+    : resolution(resolution), maxCascadeUpdatesPerFrame(maxCascadeUpdatesPerFrame)
+{
+  initializeTargets();
+}
+
+CascadedShadowMap::~CascadedShadowMap()
+{
+  if (framebuffer)
+    glDeleteFramebuffers(1, &framebuffer);
+  if (depthTextureArray)
+    glDeleteTextures(1, &depthTextureArray);
+}
+
+/// @brief Decides which cascades have to be re-rendered this frame. Cascades that are up to date keep their cached layer.
+/// @param light the directional light casting the shadows
+/// @param camera the camera the cascades are fitted to, cascades are placed in the scene space of the snapshot
+/// @param resource memory for the returned list, e.g. the frame arena
+/// @return indices of the cascades to render this frame, limited by the per-frame budget
+std::pmr::vector<int> CascadedShadowMap::prepare(const DirectionalLight &light, const CameraSnapshot &camera, std::pmr::memory_resource *resource)
+{
+  std::pmr::vector<int> refresh(resource);
+  lastFrameUpdateCount = 0;
+
+  if (!enabled)
+    return refresh;
+
+  glm::vec3 direction = glm::normalize(light.direction);
+  glm::mat4 rotation = getLightRotation(direction);
+
+  updateSplits(camera);
+
+  std::pmr::vector<int> candidates(resource);
+  for (int i = 0; i < CASCADE_COUNT; ++i)
+  {
+    auto &cascade = cascades[i];
+
+    glm::vec3 center;
+    float radius;
+    getSliceBounds(camera, cascade.splitNear, cascade.splitFar, center, radius);
+
+    // snap the cascade origin to a grid of whole texels in light space, so the cached layer stays
+    // valid (and does not shimmer) until the camera crosses a cell boundary
+    float step = getSnapStep(radius);
+    glm::vec3 lightSpaceCenter = glm::vec3(rotation * glm::vec4(center, 1.0f));
+
+    cascade.targetOrigin = glm::ivec3(glm::floor(lightSpaceCenter / step));
+    cascade.targetRadius = radius;
+    cascade.targetDirection = direction;
+
+    if (needsUpdate(cascade))
+      candidates.push_back(i);
+  }
+
+  // the nearest cascade is the most visible one, the rest are refreshed oldest first, ties in cascade order
+  // (not stable_sort, it allocates a temporary buffer even for a handful of elements)
+  std::sort(candidates.begin(), candidates.end(), [&](int a, int b)
+            {
+              if (a == 0 || b == 0)
+                return a == 0 && b != 0;
+              if (cascades[a].framesStale != cascades[b].framesStale)
+                return cascades[a].framesStale > cascades[b].framesStale;
+              return a < b; });
+
+  for (int index : candidates)
+  {
+    if (static_cast<int>(refresh.size()) < maxCascadeUpdatesPerFrame)
+      refresh.push_back(index);
+    else
+      ++cascades[index].framesStale;
+  }
+
+  lastFrameUpdateCount = static_cast<int>(refresh.size());
+  return refresh;
+}
+
+/// @brief Commits the target state of a cascade and binds its depth layer as render target
+/// @param index the cascade to render
+void CascadedShadowMap::beginCascade(int index)
+{
+  auto &cascade = cascades[index];
+
+  cascade.lightDirection = cascade.targetDirection;
+  cascade.snappedOrigin = cascade.targetOrigin;
+  cascade.radius = cascade.targetRadius;
+
+  float step = getSnapStep(cascade.radius);
+  float halfExtent = cascade.radius + step * 0.5f;
+  glm::vec3 center = (glm::vec3(cascade.snappedOrigin) + glm::vec3(0.5f)) * step;
+
+  // the light looks down -z, occluders between the sun and the cascade sit at larger z
+  cascade.lightView = getLightRotation(cascade.lightDirection);
+  cascade.boundsMin = center - glm::vec3(halfExtent);
+  cascade.boundsMax = center + glm::vec3(halfExtent, halfExtent, halfExtent + casterReach);
+
+  glm::mat4 projection = glm::ortho(cascade.boundsMin.x, cascade.boundsMax.x,
+                                    cascade.boundsMin.y, cascade.boundsMax.y,
+                                    -cascade.boundsMax.z, -cascade.boundsMin.z);
+  cascade.lightSpaceMatrix = projection * cascade.lightView;
+
+  cascade.valid = true;
+  cascade.dirty = false;
+  cascade.framesStale = 0;
+
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTextureArray, 0, index);
+  glViewport(0, 0, resolution, resolution);
+  glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void CascadedShadowMap::endPass() const
+{
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/// @brief Checks whether a bounding sphere overlaps the volume a cascade was rendered with
+bool CascadedShadowMap::cascadeContains(int index, const glm::vec3 &center, float radius) const
+{
+  const auto &cascade = cascades[index];
+  glm::vec3 lightSpaceCenter = glm::vec3(cascade.lightView * glm::vec4(center, 1.0f));
+
+  return lightSpaceCenter.x + radius >= cascade.boundsMin.x && lightSpaceCenter.x - radius <= cascade.boundsMax.x &&
+         lightSpaceCenter.y + radius >= cascade.boundsMin.y && lightSpaceCenter.y - radius <= cascade.boundsMax.y &&
+         lightSpaceCenter.z + radius >= cascade.boundsMin.z && lightSpaceCenter.z - radius <= cascade.boundsMax.z;
+}
+
+/// @brief Marks every cached cascade overlapping a world space box as dirty, e.g. after geometry inside it was remeshed
+/// @param min minimum corner of the changed region
+/// @param max maximum corner of the changed region
+void CascadedShadowMap::invalidateRegion(const glm::vec3 &min, const glm::vec3 &max)
+{
+  for (auto &cascade : cascades)
+  {
+    if (!cascade.valid || cascade.dirty)
+      continue;
+
+    glm::vec3 regionMin(std::numeric_limits<float>::max());
+    glm::vec3 regionMax(-std::numeric_limits<float>::max());
+
+    for (int corner = 0; corner < 8; ++corner)
+    {
+      glm::vec3 point((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z);
+      glm::vec3 lightSpacePoint = glm::vec3(cascade.lightView * glm::vec4(point, 1.0f));
+      regionMin = glm::min(regionMin, lightSpacePoint);
+      regionMax = glm::max(regionMax, lightSpacePoint);
+    }
+
+    bool overlaps = regionMax.x >= cascade.boundsMin.x && regionMin.x <= cascade.boundsMax.x &&
+                    regionMax.y >= cascade.boundsMin.y && regionMin.y <= cascade.boundsMax.y &&
+                    regionMax.z >= cascade.boundsMin.z && regionMin.z <= cascade.boundsMax.z;
+
+    if (overlaps)
+      cascade.dirty = true;
+  }
+}
+
+void CascadedShadowMap::invalidateAll()
+{
+  for (auto &cascade : cascades)
+    cascade.dirty = true;
+}
+
+void CascadedShadowMap::bind(unsigned int textureUnit) const
+{
+  glActiveTexture(GL_TEXTURE0 + textureUnit);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, depthTextureArray);
+}
+
+/// @brief Set the cascade matrices and splits on a shader sampling the shadow map
+/// @param shader the shader to set the uniforms on
+/// @param textureUnit the texture unit the shadow map is bound to
+/// @param sceneOffset offset of the scene origin to the camera, see CameraSnapshot
+void CascadedShadowMap::setUniforms(Shader &shader, unsigned int textureUnit, const glm::vec3 &sceneOffset) const
+{
+  // cascades stay in scene space so they can be cached, the shader looks them up with camera relative positions
+  glm::mat4 toSceneSpace = glm::translate(glm::mat4(1.0f), -sceneOffset);
+
+  shader.setInt("shadowMap", textureUnit);
+  shader.setBool("shadowsEnabled", enabled && hasLight);
+
+  std::array<glm::mat4, CASCADE_COUNT> lightSpaceMatrices;
+  std::array<float, CASCADE_COUNT> splits;
+  std::array<int, CASCADE_COUNT> valid;
+  for (int i = 0; i < CASCADE_COUNT; ++i)
+  {
+    lightSpaceMatrices[i] = cascades[i].lightSpaceMatrix * toSceneSpace;
+    splits[i] = cascades[i].splitFar;
+    valid[i] = cascades[i].valid;
+  }
+
+  // whole arrays at once, instead of building a uniform name per element
+  shader.setMat4Array("lightSpaceMatrices", lightSpaceMatrices.data(), CASCADE_COUNT);
+  shader.setFloatArray("cascadeSplits", splits.data(), CASCADE_COUNT);
+  shader.setIntArray("cascadeValid", valid.data(), CASCADE_COUNT);
+}
+
+// setters
+void CascadedShadowMap::setEnabled(bool enabled)
+{
+  this->enabled = enabled;
+}
+
+/// @brief Set every frame, unlike setEnabled() this does not switch shadows off once the light comes back
+void CascadedShadowMap::setHasLight(bool hasLight)
+{
+  this->hasLight = hasLight;
+}
+
+void CascadedShadowMap::setMaxCascadeUpdatesPerFrame(int budget)
+{
+  this->maxCascadeUpdatesPerFrame = std::max(1, budget);
+}
+
+void CascadedShadowMap::setShadowDistance(float distance)
+{
+  this->shadowDistance = distance;
+}
+
+// getters
+bool CascadedShadowMap::isEnabled() const
+{
+  return enabled;
+}
+
+int CascadedShadowMap::getResolution() const
+{
+  return resolution;
+}
+
+int CascadedShadowMap::getLastFrameUpdateCount() const
+{
+  return lastFrameUpdateCount;
+}
+
+const glm::mat4 &CascadedShadowMap::getLightSpaceMatrix(int index) const
+{
+  return cascades[index].lightSpaceMatrix;
+}
+
+// ------- private ------- //
+
+void CascadedShadowMap::initializeTargets()
+{
+  glGenTextures(1, &depthTextureArray);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, depthTextureArray);
+
+  glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, resolution, resolution, CASCADE_COUNT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+
+  // linear filtering with compare mode gives us hardware 2x2 pcf
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+
+  float borderColor[] = {1.0f, 1.0f, 1.0f, 1.0f};
+  glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+  glGenFramebuffers(1, &framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTextureArray, 0, 0);
+  glDrawBuffer(GL_NONE);
+  glReadBuffer(GL_NONE);
+
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+  {
+    std::cerr << "[CascadedShadowMap] Shadow framebuffer is incomplete, disabling shadows" << std::endl;
+    enabled = false;
+  }
+
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+/// @brief Practical split scheme, blending logarithmic and uniform splits of the shadowed view distance
+void CascadedShadowMap::updateSplits(const CameraSnapshot &camera)
+{
+  float nearPlane = camera.nearPlane;
+  float farPlane = std::min(camera.farPlane, shadowDistance);
+
+  float splitNear = nearPlane;
+  for (int i = 0; i < CASCADE_COUNT; ++i)
+  {
+    float p = static_cast<float>(i + 1) / CASCADE_COUNT;
+    float logSplit = nearPlane * std::pow(farPlane / nearPlane, p);
+    float uniformSplit = nearPlane + (farPlane - nearPlane) * p;
+
+    cascades[i].splitNear = splitNear;
+    cascades[i].splitFar = splitLambda * logSplit + (1.0f - splitLambda) * uniformSplit;
+    splitNear = cascades[i].splitFar;
+  }
+}
+
+/// @brief Smallest bounding sphere of a frustum slice. Its radius only depends on the projection,
+/// so it does not change while the camera moves or rotates.
+void CascadedShadowMap::getSliceBounds(const CameraSnapshot &camera, float splitNear, float splitFar, glm::vec3 &center, float &radius) const
+{
+  float tanHalfFov = std::tan(glm::radians(camera.fov) * 0.5f);
+  // squared tangent of the angle between view axis and frustum corner
+  float cornerSlope = tanHalfFov * tanHalfFov * (1.0f + camera.aspectRatio * camera.aspectRatio);
+
+  float centerDistance = std::min(0.5f * (splitNear + splitFar) * (1.0f + cornerSlope), splitFar);
+  float nearOffset = centerDistance - splitNear;
+  float farOffset = splitFar - centerDistance;
+
+  radius = std::sqrt(std::max(nearOffset * nearOffset + splitNear * splitNear * cornerSlope,
+                              farOffset * farOffset + splitFar * splitFar * cornerSlope));
+  radius = std::ceil(radius * 16.0f) / 16.0f; // round to avoid flickering texel sizes from float noise
+
+  center = camera.scenePosition + camera.front * centerDistance;
+}
+
+float CascadedShadowMap::getSnapStep(float radius) const
+{
+  float texelSize = 2.0f * radius / static_cast<float>(resolution - snapTexels);
+  return texelSize * snapTexels;
+}
+
+bool CascadedShadowMap::needsUpdate(const ShadowCascade &cascade) const
+{
+  if (!cascade.valid || cascade.dirty)
+    return true;
+
+  bool sunMoved = 1.0f - glm::dot(cascade.lightDirection, cascade.targetDirection) > directionEpsilon;
+  bool crossedCell = cascade.snappedOrigin != cascade.targetOrigin;
+  bool resized = cascade.radius != cascade.targetRadius;
+
+  return sunMoved || crossedCell || resized;
+}
+
+/// @brief Rotation-only view matrix of the light. Using a fixed origin keeps the texel grid world-stable.
+glm::mat4 CascadedShadowMap::getLightRotation(const glm::vec3 &direction) const
+{
+  glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+  return glm::lookAt(glm::vec3(0.0f), direction, up);
+}
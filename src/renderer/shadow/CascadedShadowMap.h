@@ -0,0 +1,113 @@
+/*
+  File: CascadedShadowMap.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <array>
+#include <memory_resource>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "renderer/camera/CameraSnapshot.h"
+#include "renderer/shader/Shader.h"
+#include "renderer/light/lights/DirectionalLight.h"
+
+/// @brief One slice of the view frustum with its own cached depth layer.
+/// The light space matrix is the one the cached layer was rendered with, so sampling stays
+/// consistent even while the cascade is waiting for a refresh.
+struct ShadowCascade
+{
+  float splitNear = 0.0f, splitFar = 0.0f;
+
+  // state of the cached depth layer
+  glm::mat4 lightSpaceMatrix = glm::mat4(1.0f);
+  glm::mat4 lightView = glm::mat4(1.0f);
+  glm::vec3 boundsMin = glm::vec3(0.0f), boundsMax = glm::vec3(0.0f); // light view space
+  glm::vec3 lightDirection = glm::vec3(0.0f);
+  glm::ivec3 snappedOrigin = glm::ivec3(0);
+  float radius = 0.0f;
+
+  // state the layer should have for the current camera and sun
+  glm::vec3 targetDirection = glm::vec3(0.0f);
+  glm::ivec3 targetOrigin = glm::ivec3(0);
+  float targetRadius = 0.0f;
+
+  bool valid = false; // layer holds rendered depth
+  bool dirty = true;  // geometry inside the cascade changed
+  unsigned int framesStale = 0;
+};
+
+/// @brief Cascaded shadow maps for the primary directional light with static geometry caching.
+/// A cascade is only re-rendered when the sun direction changes, the camera crosses a texel-snapped
+/// boundary of the cascade or geometry inside the cascade was invalidated. A per-frame budget limits
+/// how many cascades are refreshed in a single frame.
+class CascadedShadowMap
+{
+public:
+  CascadedShadowMap(int resolution = 2048, int maxCascadeUpdatesPerFrame = 1);
+  ~CascadedShadowMap();
+
+  CascadedShadowMap(const CascadedShadowMap &) = delete;
+  CascadedShadowMap &operator=(const CascadedShadowMap &) = delete;
+
+  // layers of the depth array, injected into the shaders as SHADOW_CASCADE_COUNT
+  static constexpr int CASCADE_COUNT = 3;
+
+  std::pmr::vector<int> prepare(const DirectionalLight &light, const CameraSnapshot &camera,
+                                std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  void beginCascade(int index);
+  void endPass() const;
+
+  bool cascadeContains(int index, const glm::vec3 &center, float radius) const;
+
+  void invalidateRegion(const glm::vec3 &min, const glm::vec3 &max);
+  void invalidateAll();
+
+  void bind(unsigned int textureUnit) const;
+  void setUniforms(Shader &shader, unsigned int textureUnit, const glm::vec3 &sceneOffset = glm::vec3(0.0f)) const;
+
+  // setters
+  void setEnabled(bool enabled);
+  void setHasLight(bool hasLight);
+  void setMaxCascadeUpdatesPerFrame(int budget);
+  void setShadowDistance(float distance);
+
+  // getters
+  bool isEnabled() const;
+  int getResolution() const;
+  int getLastFrameUpdateCount() const;
+  const glm::mat4 &getLightSpaceMatrix(int index) const;
+
+private:
+  unsigned int depthTextureArray = 0;
+  unsigned int framebuffer = 0;
+
+  int resolution;
+  int maxCascadeUpdatesPerFrame;
+  int lastFrameUpdateCount = 0;
+
+  bool enabled = true;
+  bool hasLight = true; // the scene had a directional light this frame, shaders skip the lookup otherwise
+
+  float shadowDistance = 64.0f;
+  float splitLambda = 0.75f;     // blend between logarithmic (1) and uniform (0) splits
+  float casterReach = 64.0f;     // how far behind a cascade occluders are still captured
+  int snapTexels = 8;            // size of a snapping cell in texels
+  float directionEpsilon = 1e-4f; // 1 - cos(angle) the sun may turn before cascades refresh
+
+  std::array<ShadowCascade, CASCADE_COUNT> cascades;
+
+  void initializeTargets();
+  void updateSplits(const CameraSnapshot &camera);
+  void getSliceBounds(const CameraSnapshot &camera, float splitNear, float splitFar, glm::vec3 &center, float &radius) const;
+  float getSnapStep(float radius) const;
+  bool needsUpdate(const ShadowCascade &cascade) const;
+  glm::mat4 getLightRotation(const glm::vec3 &direction) const;
+};
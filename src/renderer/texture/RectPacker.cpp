@@ -0,0 +1,156 @@
+/*
+  File: RectPacker.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "RectPacker.h"
+
+#include <algorithm>
+#include <limits>
+
+RectPacker::RectPacker(int width, int height)
+{
+  this->reset(width, height);
+}
+
+/// @brief Clear the packer, optionally with a new size
+void RectPacker::reset(int width, int height)
+{
+  this->width = width;
+  this->height = height;
+  this->usedArea = 0;
+
+  skyline.clear();
+  skyline.push_back({0, 0, width});
+}
+
+/// @brief Place a rectangle
+/// @param width width of the rectangle
+/// @param height height of the rectangle
+/// @param rect receives the position if the rectangle fits
+/// @return false if there is no room left for the rectangle
+bool RectPacker::insert(int width, int height, PackedRect &rect)
+{
+  size_t bestIndex = skyline.size();
+  int bestY = std::numeric_limits<int>::max();
+  int bestWaste = std::numeric_limits<int>::max();
+
+  for (size_t i = 0; i < skyline.size(); ++i)
+  {
+    int y, waste;
+    if (!this->fit(i, width, height, y, waste))
+      continue;
+
+    if (y < bestY || (y == bestY && waste < bestWaste))
+    {
+      bestIndex = i;
+      bestY = y;
+      bestWaste = waste;
+    }
+  }
+
+  if (bestIndex == skyline.size())
+    return false;
+
+  rect = {skyline[bestIndex].x, bestY, width, height};
+  this->place(bestIndex, rect);
+  usedArea += static_cast<size_t>(width) * height;
+
+  return true;
+}
+
+// getters
+int RectPacker::getWidth() const
+{
+  return width;
+}
+
+int RectPacker::getHeight() const
+{
+  return height;
+}
+
+size_t RectPacker::getUsedArea() const
+{
+  return usedArea;
+}
+
+/// @return share of the area covered by rectangles, 0 to 1
+float RectPacker::getOccupancy() const
+{
+  return static_cast<float>(usedArea) / (static_cast<float>(width) * static_cast<float>(height));
+}
+
+// ------- private ------- //
+
+/// @brief Whether a rectangle starting at a skyline node fits, it rests on the highest node it spans
+/// @param y receives the resting height
+/// @param waste receives the area left empty below the rectangle
+bool RectPacker::fit(size_t index, int width, int height, int &y, int &waste) const
+{
+  int x = skyline[index].x;
+  if (x + width > this->width)
+    return false;
+
+  y = 0;
+  int remaining = width;
+  for (size_t i = index; remaining > 0; ++i)
+  {
+    if (i == skyline.size())
+      return false;
+
+    y = std::max(y, skyline[i].y);
+    remaining -= skyline[i].width;
+  }
+
+  if (y + height > this->height)
+    return false;
+
+  waste = 0;
+  remaining = width;
+  for (size_t i = index; remaining > 0; ++i)
+  {
+    int spanned = std::min(remaining, skyline[i].width);
+    waste += spanned * (y - skyline[i].y);
+    remaining -= spanned;
+  }
+
+  return true;
+}
+
+/// @brief Raise the skyline over a placed rectangle
+void RectPacker::place(size_t index, const PackedRect &rect)
+{
+  skyline.insert(skyline.begin() + index, {rect.x, rect.y + rect.height, rect.width});
+
+  // shrink or drop the nodes now covered by the new one
+  int right = rect.x + rect.width;
+  size_t i = index + 1;
+  while (i < skyline.size() && skyline[i].x < right)
+  {
+    int overlap = right - skyline[i].x;
+    if (overlap >= skyline[i].width)
+    {
+      skyline.erase(skyline.begin() + i);
+      continue;
+    }
+
+    skyline[i].x += overlap;
+    skyline[i].width -= overlap;
+    break;
+  }
+
+  // merge neighbours at the same height
+  for (size_t j = 0; j + 1 < skyline.size();)
+  {
+    if (skyline[j].y == skyline[j + 1].y)
+    {
+      skyline[j].width += skyline[j + 1].width;
+      skyline.erase(skyline.begin() + j + 1);
+    }
+    else
+      ++j;
+  }
+}
\ No newline at end of file
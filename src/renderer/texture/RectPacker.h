@@ -0,0 +1,46 @@
+/*
+  File: RectPacker.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+struct PackedRect
+{
+  int x = 0, y = 0, width = 0, height = 0;
+};
+
+/// @brief Skyline bottom-left rectangle packer. Tracks the upper outline of everything placed so far and drops each
+/// new rectangle where it rests lowest, ties broken by the least waste under it. Rectangles are never rotated.
+class RectPacker
+{
+public:
+  RectPacker(int width, int height);
+
+  bool insert(int width, int height, PackedRect &rect);
+  void reset(int width, int height);
+
+  // getters
+  int getWidth() const;
+  int getHeight() const;
+  size_t getUsedArea() const;
+  float getOccupancy() const;
+
+private:
+  struct SkylineNode
+  {
+    int x, y, width;
+  };
+
+  std::vector<SkylineNode> skyline;
+  int width, height;
+  size_t usedArea = 0;
+
+  bool fit(size_t index, int width, int height, int &y, int &waste) const;
+  void place(size_t index, const PackedRect &rect);
+};
\ No newline at end of file
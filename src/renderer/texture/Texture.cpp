@@ -14,6 +14,7 @@ Texture::Texture(const char *imagePath, GLenum colorProfile, bool flipped)
   }
 
   glGenTextures(1, &textureId);
+  ownsTexture = true;
   glBindTexture(GL_TEXTURE_2D, textureId);
 
   // apply default scaling and wrapping
@@ -23,13 +24,21 @@ Texture::Texture(const char *imagePath, GLenum colorProfile, bool flipped)
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-  glTexImage2D(GL_TEXTURE_2D, 0, colorProfile, width, height, 0, colorProfile, GL_UNSIGNED_BYTE, imageData);
-  glGenerateMipmap(GL_TEXTURE_2D);
-
   glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxUnits);
 
   glBindTexture(GL_TEXTURE_2D, 0);
-  stbi_image_free(imageData);
+
+  // the pixels go up with the next scheduled uploads, the texture samples black until then
+  std::shared_ptr<stbi_uc> pixels(imageData, stbi_image_free);
+  size_t bytes = static_cast<size_t>(width) * height * nrChannels;
+  GLuint id = textureId;
+
+  uploadTicket = UploadScheduler::getInstance().schedule(UploadKind::Texture, bytes, UploadPriority::High, [id, colorProfile, width, height, pixels]()
+                                                         {
+                                                           glBindTexture(GL_TEXTURE_2D, id);
+                                                           glTexImage2D(GL_TEXTURE_2D, 0, colorProfile, width, height, 0, colorProfile, GL_UNSIGNED_BYTE, pixels.get());
+                                                           glGenerateMipmap(GL_TEXTURE_2D);
+                                                           glBindTexture(GL_TEXTURE_2D, 0); });
 }
 
 /// @brief This constructor takes an already prepared texture.
@@ -54,10 +63,23 @@ Texture::Texture(GLuint textureId)
   glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+/// @brief Wraps a fully prepared texture of any target, e.g. a GL_TEXTURE_2D_ARRAY.
+/// Neither parameters nor mipmaps are touched and the texture is not deleted with the wrapper.
+/// @param textureId textureId of a generated and prepared texture
+/// @param target the target the texture was created for
+Texture::Texture(GLuint textureId, GLenum target)
+{
+  this->textureId = textureId;
+  this->target = target;
+
+  glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxUnits);
+}
+
 Texture::~Texture()
 {
-  if (textureId != 0)
+  if (textureId != 0 && ownsTexture)
   {
+    UploadScheduler::getInstance().cancel(uploadTicket);
     glDeleteTextures(1, &textureId);
   }
 }
@@ -65,25 +87,25 @@ Texture::~Texture()
 void Texture::bind(unsigned int unit)
 {
   glActiveTexture(GL_TEXTURE0 + unit);
-  glBindTexture(GL_TEXTURE_2D, textureId);
+  glBindTexture(target, textureId);
 }
 
 void Texture::unbind()
 {
-  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindTexture(target, 0);
 }
 
 // setters
 void Texture::setWrappingMode(GLenum modeS, GLenum modeT)
 {
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, modeS);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, modeT);
+  glTexParameteri(target, GL_TEXTURE_WRAP_S, modeS);
+  glTexParameteri(target, GL_TEXTURE_WRAP_T, modeT);
 }
 
 void Texture::setScalingFilter(GLenum minFilter, GLenum magFilter)
 {
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+  glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter);
+  glTexParameteri(target, GL_TEXTURE_MAG_FILTER, magFilter);
 }
 
 // getters
@@ -3,12 +3,16 @@
 #include <iostream>
 #include <glad/glad.h>
 #include <stbi/stb_image.h>
+#include <memory>
+
+#include "renderer/memory/UploadScheduler.h"
 
 class Texture
 {
 public:
   Texture(const char *imagePath, GLenum colorProfile, bool flipped = true);
   Texture(GLuint textureId);
+  Texture(GLuint textureId, GLenum target);
   ~Texture();
 
   void bind(unsigned int textureUnit = 0);
@@ -22,5 +26,8 @@ public:
 
 private:
   unsigned int textureId = 0;
+  GLenum target = GL_TEXTURE_2D;
+  bool ownsTexture = false; // wrapped textures belong to whoever created them (atlas, array)
+  UploadTicket uploadTicket = NO_UPLOAD; // pixels of file textures are uploaded by the UploadScheduler
   GLint maxUnits;
 };
\ No newline at end of file
@@ -0,0 +1,118 @@
+/*
+  File: TextureAnimator.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "TextureAnimator.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+#include "renderer/memory/UploadRing.h"
+
+/// @param layerNames layer order of the texture arrays the animations run on
+/// @param animations texture name to its frames, animations with missing frame layers are skipped
+TextureAnimator::TextureAnimator(const std::vector<std::string> &layerNames, const std::vector<std::pair<std::string, TextureAnimation>> &animations)
+    : layerFrames(std::max<size_t>(layerNames.size(), 1))
+{
+  std::iota(layerFrames.begin(), layerFrames.end(), 0);
+
+  auto findLayer = [&layerNames](const std::string &name)
+  {
+    return static_cast<int>(std::find(layerNames.begin(), layerNames.end(), name) - layerNames.begin());
+  };
+
+  for (const auto &[textureName, animation] : animations)
+  {
+    int baseLayer = findLayer(textureName);
+    LayerAnimation layerAnimation{static_cast<uint16_t>(baseLayer), {}, std::max(animation.frameTime, 0.001f)};
+
+    for (const auto &frame : animation.frames)
+    {
+      int layer = findLayer(frame);
+      if (layer == static_cast<int>(layerNames.size()))
+      {
+        std::cerr << "[TextureAnimator] Frame " << frame << " of " << textureName << " is not a texture layer" << std::endl;
+        break;
+      }
+      layerAnimation.frameLayers.push_back(static_cast<uint16_t>(layer));
+    }
+
+    if (baseLayer == static_cast<int>(layerNames.size()) || layerAnimation.frameLayers.size() != animation.frames.size() || animation.frames.empty())
+    {
+      std::cerr << "[TextureAnimator] Skipping animation of " << textureName << std::endl;
+      continue;
+    }
+
+    this->animations.push_back(std::move(layerAnimation));
+  }
+
+  glGenBuffers(1, &bufferID);
+  glBindBuffer(GL_TEXTURE_BUFFER, bufferID);
+  glBufferData(GL_TEXTURE_BUFFER, layerFrames.size() * sizeof(uint16_t), layerFrames.data(), GL_DYNAMIC_DRAW);
+
+  glGenTextures(1, &textureID);
+  glBindTexture(GL_TEXTURE_BUFFER, textureID);
+  glTexBuffer(GL_TEXTURE_BUFFER, GL_R16UI, bufferID);
+
+  glBindTexture(GL_TEXTURE_BUFFER, 0);
+  glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+  std::cout << "[TextureAnimator] " << this->animations.size() << " animated textures over " << layerNames.size() << " layers" << std::endl;
+}
+
+TextureAnimator::~TextureAnimator()
+{
+  if (textureID)
+    glDeleteTextures(1, &textureID);
+  if (bufferID)
+    glDeleteBuffers(1, &bufferID);
+}
+
+/// @brief Advance all animations, the frame table is only uploaded if a frame changed
+/// @param time seconds since start, all animations share the same clock
+void TextureAnimator::update(double time)
+{
+  size_t first = layerFrames.size(), last = 0;
+
+  for (const auto &animation : animations)
+  {
+    auto frame = static_cast<size_t>(time / animation.frameTime) % animation.frameLayers.size();
+    uint16_t layer = animation.frameLayers[frame];
+
+    if (layerFrames[animation.baseLayer] == layer)
+      continue;
+
+    layerFrames[animation.baseLayer] = layer;
+    first = std::min<size_t>(first, animation.baseLayer);
+    last = std::max<size_t>(last, animation.baseLayer);
+  }
+
+  if (first > last)
+    return;
+
+  // the table is sampled by the draws of the last frames, the changed range is staged and copied on the GPU
+  size_t bytes = (last - first + 1) * sizeof(uint16_t);
+  auto staged = UploadRing::getInstance().upload(layerFrames.data() + first, bytes, sizeof(uint16_t));
+
+  glBindBuffer(GL_COPY_READ_BUFFER, staged.buffer);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, bufferID);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, staged.offset, first * sizeof(uint16_t), bytes);
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+// getters
+unsigned int TextureAnimator::getTextureID() const
+{
+  return textureID;
+}
+
+size_t TextureAnimator::getAnimationCount() const
+{
+  return animations.size();
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+/*
+  File: TextureAnimator.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @brief Frames of an animated texture, each frame is a layer of the texture arrays
+struct TextureAnimation
+{
+  std::vector<std::string> frames; // layer names, the first is the texture blocks reference
+  float frameTime = 0.1f;          // seconds per frame
+};
+
+/// @brief Animates texture array layers without touching their images. Meshes keep referencing the first frame's layer,
+/// a buffer texture maps every layer to the layer of its current frame and the block vertex shader resolves it.
+/// Advancing any number of animations costs one small buffer update per frame.
+class TextureAnimator
+{
+public:
+  TextureAnimator(const std::vector<std::string> &layerNames, const std::vector<std::pair<std::string, TextureAnimation>> &animations);
+  ~TextureAnimator();
+
+  TextureAnimator(const TextureAnimator &) = delete;
+  TextureAnimator &operator=(const TextureAnimator &) = delete;
+
+  void update(double time);
+
+  // getters
+  unsigned int getTextureID() const;
+  size_t getAnimationCount() const;
+
+private:
+  struct LayerAnimation
+  {
+    uint16_t baseLayer;
+    std::vector<uint16_t> frameLayers;
+    double frameTime;
+  };
+
+  std::vector<uint16_t> layerFrames; // layer -> layer of its current frame, identity for still textures
+  std::vector<LayerAnimation> animations;
+  unsigned int bufferID = 0, textureID = 0;
+};
\ No newline at end of file
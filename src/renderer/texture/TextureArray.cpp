@@ -0,0 +1,308 @@
+/*
+  File: TextureArray.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "TextureArray.h"
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+/// @param layerNames layer order, arrays built from the same names share their layer indices
+/// @param texturePaths layer name to image path
+/// @param textureSize width and height of every layer
+/// @param decoder shared decoder, so arrays referencing the same files decode them once. A temporary one is used if null
+TextureArray::TextureArray(const std::vector<std::string> &layerNames, const std::unordered_map<std::string, std::string> &texturePaths, int textureSize,
+                           TextureDecoder *decoder)
+    : layerNames(layerNames), texturePaths(texturePaths), textureSize(textureSize)
+{
+  this->mipLevels = static_cast<int>(std::floor(std::log2(textureSize))) + 1;
+
+  for (size_t i = 0; i < layerNames.size(); ++i)
+    this->layers[layerNames[i]] = static_cast<int>(i);
+
+  TextureDecoder localDecoder;
+  this->buildArray(decoder ? *decoder : localDecoder);
+}
+
+/// @brief Upload pre-mipmapped layers as they are, e.g. straight from the mapped asset bundle. Block compressed data is
+/// uploaded compressed if the driver supports the format and decoded on the CPU otherwise.
+/// @param layerNames layer order of the data
+/// @param textureSize width and height of every layer
+/// @param mipLevels data per mip level, all layers of a level back to back. Missing RGBA8 levels are generated
+/// @param encoding the encoding of the data
+TextureArray::TextureArray(const std::vector<std::string> &layerNames, int textureSize, const std::vector<const unsigned char *> &mipLevels,
+                           TextureEncoding encoding)
+    : layerNames(layerNames), textureSize(textureSize), preBaked(true)
+{
+  this->mipLevels = static_cast<int>(std::floor(std::log2(textureSize))) + 1;
+
+  for (size_t i = 0; i < layerNames.size(); ++i)
+    this->layers[layerNames[i]] = static_cast<int>(i);
+
+  auto layerCount = static_cast<GLsizei>(layerNames.size());
+  int providedLevels = std::min(this->mipLevels, static_cast<int>(mipLevels.size()));
+  bool uploadCompressed = encoding != TextureEncoding::RGBA8 && isEncodingSupported(encoding);
+
+  std::cout << "[TextureArray] uploading " << layerNames.size() << " pre-baked layers (encoding " << static_cast<int>(encoding)
+            << (encoding != TextureEncoding::RGBA8 && !uploadCompressed ? ", not supported by the driver, decoding on the CPU)." : ").") << std::endl;
+
+  if (uploadCompressed)
+  {
+    this->createTexture();
+
+    // compressed levels can not be generated, the chain ends at the last provided level
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, providedLevels - 1);
+
+    for (int level = 0; level < providedLevels; ++level)
+    {
+      int levelSize = std::max(1, textureSize >> level);
+      auto levelBytes = static_cast<GLsizei>(TextureCompressor::getEncodedSize(encoding, levelSize, levelSize) * layerNames.size());
+      glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, getGLFormat(encoding), levelSize, levelSize, layerCount, 0, levelBytes, mipLevels[level]);
+    }
+
+    // single channel maps are sampled as gray, like their uncompressed RGB counterparts
+    if (encoding == TextureEncoding::BC4)
+    {
+      glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_G, GL_RED);
+      glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_B, GL_RED);
+    }
+  }
+  else
+  {
+    this->allocateStorage();
+
+    for (int level = 0; level < providedLevels; ++level)
+    {
+      int levelSize = std::max(1, textureSize >> level);
+
+      if (encoding == TextureEncoding::RGBA8)
+      {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, 0, levelSize, levelSize, layerCount, GL_RGBA, GL_UNSIGNED_BYTE, mipLevels[level]);
+        continue;
+      }
+
+      size_t encodedLayerBytes = TextureCompressor::getEncodedSize(encoding, levelSize, levelSize);
+      std::vector<unsigned char> decoded;
+      decoded.reserve(static_cast<size_t>(levelSize) * levelSize * 4 * layerNames.size());
+
+      for (size_t layer = 0; layer < layerNames.size(); ++layer)
+      {
+        auto pixels = TextureCompressor::decode(encoding, mipLevels[level] + layer * encodedLayerBytes, levelSize, levelSize);
+        decoded.insert(decoded.end(), pixels.begin(), pixels.end());
+      }
+
+      glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, 0, levelSize, levelSize, layerCount, GL_RGBA, GL_UNSIGNED_BYTE, decoded.data());
+    }
+
+    if (providedLevels < this->mipLevels)
+      glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+  }
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+  this->isBuilt = true;
+}
+
+TextureArray::~TextureArray()
+{
+  std::cout << "Destroying TextureArray and removing texture from GPU" << std::endl;
+  if (arrayTextureID)
+    glDeleteTextures(1, &arrayTextureID);
+}
+
+void TextureArray::buildArray(TextureDecoder &decoder)
+{
+  std::cout << "[TextureArray] building " << layerNames.size() << " layers." << std::endl;
+
+  this->allocateStorage();
+  this->uploadLayers(decoder);
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+  this->isBuilt = true;
+}
+
+/// @brief Replace the images of existing layers, e.g. when switching texture packs. Layer indices stay the same,
+/// so meshes referencing them do not have to be rebuilt.
+/// @param texturePaths layer name to image path, names that are not a layer of this array are ignored
+/// @param decoder shared decoder, a temporary one is used if null. A shared decoder's cache must not hold outdated images of the paths
+void TextureArray::reload(const std::unordered_map<std::string, std::string> &texturePaths, TextureDecoder *decoder)
+{
+  if (!this->validateArray())
+    return;
+
+  // re-uploading from paths would clear every layer not in the map and drop the compressed encoding
+  if (preBaked)
+  {
+    std::cerr << "[TextureArray] Can not reload an array uploaded from pre-baked data, rebuild the asset bundle instead" << std::endl;
+    return;
+  }
+
+  for (const auto &[name, path] : texturePaths)
+  {
+    if (layers.find(name) == layers.end())
+    {
+      std::cerr << "[TextureArray] Ignoring " << name << ", adding layers requires rebuilding meshes" << std::endl;
+      continue;
+    }
+    this->texturePaths[name] = path;
+  }
+
+  TextureDecoder localDecoder;
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTextureID);
+  this->uploadLayers(decoder ? *decoder : localDecoder);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TextureArray::bind(unsigned int textureUnit) const
+{
+  glActiveTexture(GL_TEXTURE0 + textureUnit);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTextureID);
+}
+
+// getters
+unsigned int TextureArray::getTextureID() const
+{
+  this->validateArray();
+  return arrayTextureID;
+}
+
+int TextureArray::getLayer(const std::string &name) const
+{
+  if (!this->validateArray())
+    return 0;
+
+  auto layer = this->layers.find(name);
+
+  if (layer == layers.end())
+  {
+    std::cerr << "Unable to find key " << name << " in the texture array layers" << std::endl;
+    return 0;
+  }
+
+  return layer->second;
+}
+
+int TextureArray::getLayerCount() const
+{
+  return static_cast<int>(layerNames.size());
+}
+
+int TextureArray::getTextureSize() const
+{
+  return textureSize;
+}
+
+/// @brief Whether the driver can sample an encoding directly, without decoding it on the CPU first
+bool TextureArray::isEncodingSupported(TextureEncoding encoding)
+{
+  switch (encoding)
+  {
+  case TextureEncoding::RGBA8:
+    return true;
+  case TextureEncoding::BC1:
+    return GLAD_GL_EXT_texture_compression_s3tc;
+  case TextureEncoding::BC4:
+    return true; // RGTC is core since 3.0
+  case TextureEncoding::BC7:
+    return GLAD_GL_VERSION_4_2 || GLAD_GL_ARB_texture_compression_bptc;
+  }
+  return false;
+}
+
+// ------- private ------- //
+
+/// @brief Create the texture with RGBA8 storage for every layer and level, leaves it bound
+void TextureArray::allocateStorage()
+{
+  this->createTexture();
+
+  // allocate every level up front, glGenerateMipmap then fills each layer's chain on its own, so neighbouring textures never bleed
+  for (int level = 0; level < mipLevels; ++level)
+  {
+    int levelSize = std::max(1, textureSize >> level);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, levelSize, levelSize, static_cast<GLsizei>(layerNames.size()), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  }
+}
+
+/// @brief Create the texture and set up sampling, leaves it bound without storage
+void TextureArray::createTexture()
+{
+  glGenTextures(1, &arrayTextureID);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTextureID);
+
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, mipLevels - 1);
+}
+
+/// @brief Decode all layers in parallel into one staging image, upload it with a single call and regenerate the mip chains.
+/// Expects the array to be bound.
+void TextureArray::uploadLayers(TextureDecoder &decoder)
+{
+  std::vector<std::string> paths;
+  paths.reserve(layerNames.size());
+
+  for (const auto &textureName : layerNames)
+  {
+    auto path = texturePaths.find(textureName);
+    paths.push_back(path != texturePaths.end() ? path->second : std::string());
+  }
+
+  auto images = decoder.decode(paths);
+
+  // layers without a usable image stay cleared, so stale or undefined texels never show up
+  size_t layerBytes = static_cast<size_t>(textureSize) * textureSize * 4;
+  std::vector<unsigned char> staging(layerBytes * layerNames.size(), 0);
+
+  for (size_t layer = 0; layer < layerNames.size(); ++layer)
+  {
+    const auto &image = images[layer];
+
+    if (!image || !image->isValid() || image->width != textureSize || image->height != textureSize)
+    {
+      std::cerr << "Error loading texture: " << layerNames[layer] << std::endl;
+      continue;
+    }
+
+    std::copy(image->pixels.begin(), image->pixels.end(), staging.begin() + layer * layerBytes);
+  }
+
+  glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, textureSize, textureSize, static_cast<GLsizei>(layerNames.size()), GL_RGBA, GL_UNSIGNED_BYTE, staging.data());
+  glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+  std::cout << "[TextureArray] uploaded " << layerNames.size() << " layers" << std::endl;
+}
+
+GLenum TextureArray::getGLFormat(TextureEncoding encoding)
+{
+  switch (encoding)
+  {
+  case TextureEncoding::BC1:
+    return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+  case TextureEncoding::BC4:
+    return GL_COMPRESSED_RED_RGTC1;
+  case TextureEncoding::BC7:
+    return GL_COMPRESSED_RGBA_BPTC_UNORM;
+  default:
+    return GL_RGBA8;
+  }
+}
+
+bool TextureArray::validateArray() const
+{
+  if (!isBuilt)
+  {
+    std::cerr << "[Error] Texture Array has not been built yet!" << std::endl;
+    return false;
+  }
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+/*
+  File: TextureArray.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <glad/glad.h>
+
+#include "renderer/texture/TextureDecoder.h"
+#include "renderer/texture/TextureCompressor.h"
+
+/// @brief GL_TEXTURE_2D_ARRAY with one layer per texture and a full mip chain per layer.
+/// Layers are assigned in the order of the layer names, so arrays built from the same names
+/// (diffuse, specular, emissive) share their layer indices and can be sampled with the same coordinate.
+class TextureArray
+{
+public:
+  TextureArray(const std::vector<std::string> &layerNames, const std::unordered_map<std::string, std::string> &texturePaths, int textureSize,
+               TextureDecoder *decoder = nullptr);
+  TextureArray(const std::vector<std::string> &layerNames, int textureSize, const std::vector<const unsigned char *> &mipLevels,
+               TextureEncoding encoding = TextureEncoding::RGBA8);
+  ~TextureArray();
+
+  TextureArray(const TextureArray &) = delete;
+  TextureArray &operator=(const TextureArray &) = delete;
+
+  void buildArray(TextureDecoder &decoder);
+  void reload(const std::unordered_map<std::string, std::string> &texturePaths, TextureDecoder *decoder = nullptr);
+
+  void bind(unsigned int textureUnit = 0) const;
+
+  // getters
+  unsigned int getTextureID() const;
+  int getLayer(const std::string &name) const;
+  int getLayerCount() const;
+  int getTextureSize() const;
+
+  static bool isEncodingSupported(TextureEncoding encoding);
+
+private:
+  std::vector<std::string> layerNames;
+  std::unordered_map<std::string, std::string> texturePaths;
+  std::unordered_map<std::string, int> layers;
+  int textureSize;
+  int mipLevels;
+  unsigned int arrayTextureID = 0;
+  bool isBuilt = false;
+  bool preBaked = false; // uploaded from pre-mipmapped data, there are no image paths to re-upload the other layers from
+
+  void createTexture();
+  void allocateStorage();
+  void uploadLayers(TextureDecoder &decoder);
+  bool validateArray() const;
+
+  static GLenum getGLFormat(TextureEncoding encoding);
+};
\ No newline at end of file
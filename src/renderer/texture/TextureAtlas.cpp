@@ -8,14 +8,53 @@
 #include "TextureAtlas.h"
 
 #include <glad/glad.h>
-#include <stbi/stb_image.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
-TextureAtlas::TextureAtlas(const std::unordered_map<std::string, std::string> &texturePaths, int textureSize)
-    : texturePaths(texturePaths), textureSize(textureSize), atlasSize(0), atlasTextureID(0)
+/// @param texturePaths texture name to image path, images may have any size
+/// @param gutter texels of repeated edge around every tile, mipmaps are generated down to the level the gutter still covers
+/// @param decoder shared decoder, a temporary one is used if null
+TextureAtlas::TextureAtlas(const std::unordered_map<std::string, std::string> &texturePaths, int gutter, TextureDecoder *decoder)
+    : packer(0, 0), gutter(std::max(0, gutter))
 {
-  this->gridSize = static_cast<int>(std::ceil(std::sqrt(texturePaths.size())));
-  this->atlasSize = gridSize * textureSize;
+  // at level n a gutter of g texels shrinks to g >> n, tiles are aligned so no mip texel spans two of them
+  this->mipLevels = this->gutter > 0 ? static_cast<int>(std::floor(std::log2(this->gutter))) + 1 : 1;
+  this->alignment = 1 << (mipLevels - 1);
+
+  std::vector<std::string> names, paths;
+  for (const auto &[textureName, path] : texturePaths)
+  {
+    names.push_back(textureName);
+    paths.push_back(path);
+  }
+
+  TextureDecoder localDecoder;
+  auto images = (decoder ? *decoder : localDecoder).decode(paths);
+
+  size_t paddedArea = 0;
+  int largest = 1;
+  for (size_t i = 0; i < images.size(); ++i)
+  {
+    if (!images[i] || !images[i]->isValid())
+    {
+      std::cerr << "Error loading texture: " << names[i] << std::endl;
+      continue;
+    }
+
+    int width = this->getPaddedSize(images[i]->width), height = this->getPaddedSize(images[i]->height);
+    paddedArea += static_cast<size_t>(width) * height;
+    largest = std::max({largest, width, height});
+
+    this->tiles[names[i]] = {images[i], {}};
+  }
+
+  // start with the smallest power of two square that could hold everything, packing grows it if needed
+  int size = 1;
+  while (static_cast<size_t>(size) * size < paddedArea || size < largest)
+    size *= 2;
+  this->packer.reset(size, size);
+
   this->buildAtlas();
 }
 
@@ -26,79 +65,257 @@ TextureAtlas::~TextureAtlas()
     glDeleteTextures(1, &atlasTextureID);
 }
 
-void TextureAtlas::buildAtlas()
+/// @brief Pack all textures and (re)create the atlas texture, growing the atlas until everything fits
+/// @return false if some tiles did not fit into the largest supported atlas, they are left without a rect
+bool TextureAtlas::buildAtlas()
 {
-  std::cout << "[TextureAtlas] stitching textures." << std::endl;
+  std::cout << "[TextureAtlas] packing " << tiles.size() << " textures." << std::endl;
 
-  glGenTextures(1, &atlasTextureID);
-  glBindTexture(GL_TEXTURE_2D, atlasTextureID);
-
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, atlasSize, atlasSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-  int i = 0;
-  for (const auto &[textureName, path] : texturePaths)
+  bool packed = this->packTiles();
+  while (!packed)
   {
-    int width, height, channels;
-    unsigned char *imageData = stbi_load(path.c_str(), &width, &height, &channels, 0);
-
-    if (!imageData || width != textureSize || height != textureSize)
+    if (!this->grow())
     {
-      std::cerr << "Error loading texture: " << textureName << std::endl;
-      stbi_image_free(imageData);
-      continue;
+      std::cerr << "[TextureAtlas] Unable to fit all textures into the largest supported atlas" << std::endl;
+      break;
     }
+    packed = this->packTiles();
+  }
 
-    int gridX = i % (atlasSize / textureSize); // calculate the x-position on the atlas grid
-    int gridY = i / (atlasSize / textureSize); // calculate the y position on the atlas grid
+  if (atlasTextureID)
+    glDeleteTextures(1, &atlasTextureID);
 
-    int xOffset = gridX * textureSize;
-    int yOffset = gridY * textureSize;
+  this->allocateTexture();
 
-    glTexSubImage2D(GL_TEXTURE_2D, 0, xOffset, yOffset, textureSize, textureSize, GL_RGBA, GL_UNSIGNED_BYTE, imageData);
+  for (const auto &[textureName, tile] : tiles)
+    if (tile.rect.width > 0)
+      this->uploadTile(tile);
 
-    // store uv coordinates
-    float uvWidth = 1.0f / gridSize;
-    float uvHeight = uvWidth;
+  if (mipLevels > 1)
+    glGenerateMipmap(GL_TEXTURE_2D);
 
-    this->uvRegions[textureName] = glm::vec4(gridX * uvWidth, gridY * uvHeight, (gridX + 1) * uvWidth, (gridY + 1) * uvHeight);
+  glBindTexture(GL_TEXTURE_2D, 0);
 
-    stbi_image_free(imageData);
+  this->isBuilt = true;
+  this->logStats();
+  return packed;
+}
 
-    ++i;
+/// @brief Add a texture at runtime. It goes into free space if there is any, otherwise the atlas grows and is repacked,
+/// so UV regions queried before have to be queried again.
+/// @param name texture name, must not be in the atlas yet
+/// @param path image path
+/// @param decoder shared decoder, a temporary one is used if null
+/// @return false if the image could not be loaded or does not fit into the largest supported atlas
+bool TextureAtlas::addTexture(const std::string &name, const std::string &path, TextureDecoder *decoder)
+{
+  TextureDecoder localDecoder;
+  auto images = (decoder ? *decoder : localDecoder).decode({path});
 
-    std::cout << "[TextureAtlas] stitching texture " << i << " of " << texturePaths.size() << " (" << textureName << ")" << std::endl;
+  if (images.empty() || !images[0] || !images[0]->isValid())
+  {
+    std::cerr << "Error loading texture: " << name << std::endl;
+    return false;
   }
 
-  glBindTexture(GL_TEXTURE_2D, 0);
+  return this->addImage(name, images[0]);
+}
 
-  this->isBuilt = true;
+/// @brief Log the atlas size, memory use and how much of it is covered by textures
+void TextureAtlas::logStats() const
+{
+  size_t imageBytes = 0;
+  for (const auto &[textureName, tile] : tiles)
+    imageBytes += tile.image->pixels.size();
+
+  std::cout << "[TextureAtlas] " << tiles.size() << " textures in " << packer.getWidth() << "x" << packer.getHeight() << ", "
+            << static_cast<int>(this->getPackingEfficiency() * 100.0f) << "% textures, "
+            << static_cast<int>(packer.getOccupancy() * 100.0f) << "% with gutters, "
+            << this->getMemoryUsage() / 1024 << " KiB on the GPU, " << imageBytes / 1024 << " KiB kept for repacking" << std::endl;
 }
 
+// getters
 unsigned int TextureAtlas::getTextureID() const
 {
   this->validateAtlas();
   return atlasTextureID;
 }
 
+/// @return (u0, v0, u1, v1) of the texture without its gutter
 glm::vec4 TextureAtlas::getUVRegion(std::string name) const
 {
   if (!this->validateAtlas())
     return glm::vec4(0.0f);
 
-  auto pair = this->uvRegions.find(name);
+  auto pair = this->tiles.find(name);
 
-  if (pair == uvRegions.end())
+  if (pair == tiles.end() || pair->second.rect.width == 0)
   {
     std::cerr << "Unable to find key " << name << " in the texture atlas UV regions" << std::endl;
     return glm::vec4(0.0f);
   }
 
-  return pair->second;
+  const auto &tile = pair->second;
+  float width = static_cast<float>(packer.getWidth()), height = static_cast<float>(packer.getHeight());
+  float x = static_cast<float>(tile.rect.x + gutter), y = static_cast<float>(tile.rect.y + gutter);
+
+  return glm::vec4(x / width, y / height, (x + tile.image->width) / width, (y + tile.image->height) / height);
+}
+
+int TextureAtlas::getWidth() const
+{
+  return packer.getWidth();
+}
+
+int TextureAtlas::getHeight() const
+{
+  return packer.getHeight();
+}
+
+/// @return bytes of texture memory, all mip levels included
+size_t TextureAtlas::getMemoryUsage() const
+{
+  size_t bytes = 0;
+  for (int level = 0; level < mipLevels; ++level)
+    bytes += static_cast<size_t>(std::max(1, packer.getWidth() >> level)) * std::max(1, packer.getHeight() >> level) * 4;
+  return bytes;
+}
+
+/// @return share of the atlas covered by texture texels, gutters and alignment not counted
+float TextureAtlas::getPackingEfficiency() const
+{
+  size_t area = 0;
+  for (const auto &[textureName, tile] : tiles)
+    if (tile.rect.width > 0)
+      area += static_cast<size_t>(tile.image->width) * tile.image->height;
+
+  return static_cast<float>(area) / (static_cast<float>(packer.getWidth()) * static_cast<float>(packer.getHeight()));
+}
+
+// ------- private ------- //
+
+bool TextureAtlas::addImage(const std::string &name, const sDecodedImagePtr &image)
+{
+  if (!this->validateAtlas())
+    return false;
+
+  if (tiles.find(name) != tiles.end())
+  {
+    std::cerr << "[TextureAtlas] " << name << " is already in the atlas" << std::endl;
+    return false;
+  }
+
+  AtlasTile tile{image, {}};
+
+  // free space left, the other tiles stay where they are
+  if (packer.insert(this->getPaddedSize(image->width), this->getPaddedSize(image->height), tile.rect))
+  {
+    tiles[name] = tile;
+
+    glBindTexture(GL_TEXTURE_2D, atlasTextureID);
+    this->uploadTile(tile);
+    if (mipLevels > 1)
+      glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    this->logStats();
+    return true;
+  }
+
+  std::cout << "[TextureAtlas] no room for " << name << ", repacking." << std::endl;
+
+  tiles[name] = tile;
+  if (this->buildAtlas())
+    return true;
+
+  // repacking with the new tile may have pushed out a tile that fit before, go back to the tiles the atlas had
+  tiles.erase(name);
+  this->buildAtlas();
+  return false;
+}
+
+/// @brief Pack every tile from scratch at the current atlas size, tallest first
+/// @return false if a tile did not fit, it is left without a rect
+bool TextureAtlas::packTiles()
+{
+  std::vector<AtlasTile *> order;
+  for (auto &[textureName, tile] : tiles)
+    order.push_back(&tile);
+
+  std::sort(order.begin(), order.end(), [](const AtlasTile *a, const AtlasTile *b)
+            { return a->image->height != b->image->height ? a->image->height > b->image->height : a->image->width > b->image->width; });
+
+  packer.reset(packer.getWidth(), packer.getHeight());
+
+  bool packed = true;
+  for (auto *tile : order)
+  {
+    if (!packer.insert(this->getPaddedSize(tile->image->width), this->getPaddedSize(tile->image->height), tile->rect))
+    {
+      tile->rect = {};
+      packed = false;
+    }
+  }
+
+  return packed;
+}
+
+/// @brief Double the shorter side of the atlas
+/// @return false if the atlas is already as large as the driver allows
+bool TextureAtlas::grow()
+{
+  GLint maxSize = 0;
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+
+  int width = packer.getWidth(), height = packer.getHeight();
+  (width <= height ? width : height) *= 2;
+
+  if (width > maxSize || height > maxSize)
+    return false;
+
+  packer.reset(width, height);
+  return true;
+}
+
+/// @brief Create the atlas texture at the packer's size, leaves it bound
+void TextureAtlas::allocateTexture()
+{
+  glGenTextures(1, &atlasTextureID);
+  glBindTexture(GL_TEXTURE_2D, atlasTextureID);
+
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, packer.getWidth(), packer.getHeight(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipLevels > 1 ? GL_NEAREST_MIPMAP_LINEAR : GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipLevels - 1);
+}
+
+/// @brief Upload a tile with its gutter to the bound atlas, the gutter repeats the image's edge texels
+void TextureAtlas::uploadTile(const AtlasTile &tile) const
+{
+  const auto &image = *tile.image;
+  std::vector<unsigned char> padded(static_cast<size_t>(tile.rect.width) * tile.rect.height * 4);
+
+  for (int y = 0; y < tile.rect.height; ++y)
+  {
+    int sourceY = std::clamp(y - gutter, 0, image.height - 1);
+    for (int x = 0; x < tile.rect.width; ++x)
+    {
+      int sourceX = std::clamp(x - gutter, 0, image.width - 1);
+      std::copy_n(&image.pixels[(static_cast<size_t>(sourceY) * image.width + sourceX) * 4], 4, &padded[(static_cast<size_t>(y) * tile.rect.width + x) * 4]);
+    }
+  }
+
+  glTexSubImage2D(GL_TEXTURE_2D, 0, tile.rect.x, tile.rect.y, tile.rect.width, tile.rect.height, GL_RGBA, GL_UNSIGNED_BYTE, padded.data());
+}
+
+/// @brief Size of a tile side with gutters, rounded up to the mip alignment
+int TextureAtlas::getPaddedSize(int size) const
+{
+  return (size + 2 * gutter + alignment - 1) / alignment * alignment;
 }
 
 bool TextureAtlas::validateAtlas() const
@@ -109,4 +326,4 @@ bool TextureAtlas::validateAtlas() const
     return false;
   }
   return true;
-}
+}
\ No newline at end of file
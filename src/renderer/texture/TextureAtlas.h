@@ -12,22 +12,52 @@
 #include <string>
 #include <glm/glm.hpp>
 
+#include "renderer/texture/RectPacker.h"
+#include "renderer/texture/TextureDecoder.h"
+
+/// @brief Textures of any size packed into a single GL_TEXTURE_2D. Every tile is surrounded by a gutter of repeated edge
+/// texels, and the mip chain is cut off where the gutter would shrink below a texel, so mipmapped sampling never bleeds
+/// into a neighbour. Textures can be added at runtime; if they no longer fit the atlas grows and everything is repacked,
+/// which moves the UV regions of textures added before.
 class TextureAtlas
 {
 public:
-  TextureAtlas(const std::unordered_map<std::string, std::string> &texturePaths, int textureSize);
+  TextureAtlas(const std::unordered_map<std::string, std::string> &texturePaths, int gutter = 2, TextureDecoder *decoder = nullptr);
   ~TextureAtlas();
 
-  void buildAtlas();
+  TextureAtlas(const TextureAtlas &) = delete;
+  TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+  bool buildAtlas();
+  bool addTexture(const std::string &name, const std::string &path, TextureDecoder *decoder = nullptr);
+  void logStats() const;
+
+  // getters
   unsigned int getTextureID() const;
   glm::vec4 getUVRegion(std::string name) const;
+  int getWidth() const;
+  int getHeight() const;
+  size_t getMemoryUsage() const;
+  float getPackingEfficiency() const;
 
 private:
-  std::unordered_map<std::string, std::string> texturePaths;
-  std::unordered_map<std::string, glm::vec4> uvRegions;
-  int textureSize, atlasSize, gridSize;
-  unsigned int atlasTextureID;
+  struct AtlasTile
+  {
+    sDecodedImagePtr image;
+    PackedRect rect; // including the gutter
+  };
+
+  std::unordered_map<std::string, AtlasTile> tiles;
+  RectPacker packer;
+  int gutter, mipLevels, alignment;
+  unsigned int atlasTextureID = 0;
   bool isBuilt = false;
 
+  bool addImage(const std::string &name, const sDecodedImagePtr &image);
+  bool packTiles();
+  bool grow();
+  void allocateTexture();
+  void uploadTile(const AtlasTile &tile) const;
+  int getPaddedSize(int size) const;
   bool validateAtlas() const;
 };
\ No newline at end of file
@@ -0,0 +1,603 @@
+/*
+  File: TextureCompressor.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "TextureCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+  // interpolation weights of 4 bit BC7 indices
+  constexpr int BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+  /// @brief Fit a line through the block's colors, the endpoints are where the extreme pixels project onto it
+  void fitEndpoints(const unsigned char block[64], int channels, float low[4], float high[4])
+  {
+    float mean[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 16; ++i)
+      for (int c = 0; c < channels; ++c)
+        mean[c] += block[i * 4 + c] / 16.0f;
+
+    float covariance[4][4] = {};
+    for (int i = 0; i < 16; ++i)
+      for (int a = 0; a < channels; ++a)
+        for (int b = 0; b < channels; ++b)
+          covariance[a][b] += (block[i * 4 + a] - mean[a]) * (block[i * 4 + b] - mean[b]);
+
+    // power iteration for the principal axis
+    float axis[4] = {1, 1, 1, 1};
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+      float next[4] = {0, 0, 0, 0};
+      for (int a = 0; a < channels; ++a)
+        for (int b = 0; b < channels; ++b)
+          next[a] += covariance[a][b] * axis[b];
+
+      float length = 0.0f;
+      for (int c = 0; c < channels; ++c)
+        length += next[c] * next[c];
+      length = std::sqrt(length);
+
+      if (length < 1e-6f)
+        break;
+      for (int c = 0; c < channels; ++c)
+        axis[c] = next[c] / length;
+    }
+
+    float minProjection = std::numeric_limits<float>::max(), maxProjection = std::numeric_limits<float>::lowest();
+    for (int i = 0; i < 16; ++i)
+    {
+      float projection = 0.0f;
+      for (int c = 0; c < channels; ++c)
+        projection += (block[i * 4 + c] - mean[c]) * axis[c];
+      minProjection = std::min(minProjection, projection);
+      maxProjection = std::max(maxProjection, projection);
+    }
+
+    for (int c = 0; c < 4; ++c)
+    {
+      low[c] = c < channels ? std::clamp(mean[c] + minProjection * axis[c], 0.0f, 255.0f) : 255.0f;
+      high[c] = c < channels ? std::clamp(mean[c] + maxProjection * axis[c], 0.0f, 255.0f) : 255.0f;
+    }
+  }
+
+  template <int Count>
+  void selectIndices(const unsigned char block[64], int channels, const int palette[Count][4], int indices[16])
+  {
+    for (int i = 0; i < 16; ++i)
+    {
+      int bestError = std::numeric_limits<int>::max();
+      for (int entry = 0; entry < Count; ++entry)
+      {
+        int error = 0;
+        for (int c = 0; c < channels; ++c)
+        {
+          int difference = block[i * 4 + c] - palette[entry][c];
+          error += difference * difference;
+        }
+        if (error < bestError)
+        {
+          bestError = error;
+          indices[i] = entry;
+        }
+      }
+    }
+  }
+
+  /// @brief Least squares refit of the endpoints for fixed interpolation weights, then re-encode while it keeps improving.
+  /// encodeCandidate(low, high, out, weights) encodes a block and returns its squared error, weights receives each pixel's
+  /// position between low (0) and high (1).
+  template <typename EncodeCandidate>
+  void refineEndpoints(const unsigned char block[64], int channels, float low[4], float high[4], size_t blockBytes, unsigned char *out, EncodeCandidate encodeCandidate)
+  {
+    float weights[16];
+    unsigned char candidate[16];
+    int bestError = encodeCandidate(low, high, out, weights);
+
+    for (int iteration = 0; iteration < 4 && bestError > 0; ++iteration)
+    {
+      float a = 0.0f, b = 0.0f, c = 0.0f;
+      for (float w : weights)
+      {
+        a += (1.0f - w) * (1.0f - w);
+        b += (1.0f - w) * w;
+        c += w * w;
+      }
+
+      float determinant = a * c - b * b;
+      if (std::abs(determinant) < 1e-6f)
+        break;
+
+      float refinedLow[4], refinedHigh[4];
+      for (int channel = 0; channel < 4; ++channel)
+      {
+        if (channel >= channels)
+        {
+          refinedLow[channel] = low[channel];
+          refinedHigh[channel] = high[channel];
+          continue;
+        }
+
+        float lowSum = 0.0f, highSum = 0.0f;
+        for (int i = 0; i < 16; ++i)
+        {
+          lowSum += (1.0f - weights[i]) * block[i * 4 + channel];
+          highSum += weights[i] * block[i * 4 + channel];
+        }
+        refinedLow[channel] = std::clamp((c * lowSum - b * highSum) / determinant, 0.0f, 255.0f);
+        refinedHigh[channel] = std::clamp((a * highSum - b * lowSum) / determinant, 0.0f, 255.0f);
+      }
+
+      float candidateWeights[16];
+      int error = encodeCandidate(refinedLow, refinedHigh, candidate, candidateWeights);
+      if (error >= bestError)
+        break;
+
+      bestError = error;
+      std::memcpy(out, candidate, blockBytes);
+      std::memcpy(low, refinedLow, sizeof(refinedLow));
+      std::memcpy(high, refinedHigh, sizeof(refinedHigh));
+      std::memcpy(weights, candidateWeights, sizeof(weights));
+    }
+  }
+
+  template <int Count>
+  int getPaletteError(const unsigned char block[64], int channels, const int palette[Count][4], const int indices[16])
+  {
+    int error = 0;
+    for (int i = 0; i < 16; ++i)
+      for (int c = 0; c < channels; ++c)
+      {
+        int difference = block[i * 4 + c] - palette[indices[i]][c];
+        error += difference * difference;
+      }
+    return error;
+  }
+
+  uint16_t packRGB565(const float color[4])
+  {
+    auto r = static_cast<uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+    auto g = static_cast<uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+    auto b = static_cast<uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+  }
+
+  void unpackRGB565(uint16_t color, int out[4])
+  {
+    int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+    out[3] = 255;
+  }
+
+  void writeBits(unsigned char *out, int &position, uint32_t value, int count)
+  {
+    for (int i = 0; i < count; ++i, ++position)
+    {
+      if (value & (1u << i))
+        out[position >> 3] |= static_cast<unsigned char>(1u << (position & 7));
+    }
+  }
+
+  uint32_t readBits(const unsigned char *data, int &position, int count)
+  {
+    uint32_t value = 0;
+    for (int i = 0; i < count; ++i, ++position)
+    {
+      if (data[position >> 3] & (1u << (position & 7)))
+        value |= 1u << i;
+    }
+    return value;
+  }
+
+  size_t getBlockBytes(TextureEncoding encoding)
+  {
+    return encoding == TextureEncoding::BC7 ? 16 : 8;
+  }
+}
+
+/// @brief Encode an RGBA8 image
+/// @return the encoded blocks in row order, or a copy of the pixels for RGBA8
+std::vector<unsigned char> TextureCompressor::encode(TextureEncoding encoding, const unsigned char *pixels, int width, int height)
+{
+  if (encoding == TextureEncoding::RGBA8)
+    return std::vector<unsigned char>(pixels, pixels + static_cast<size_t>(width) * height * 4);
+
+  std::vector<unsigned char> out(getEncodedSize(encoding, width, height), 0);
+  size_t blockBytes = getBlockBytes(encoding);
+  size_t blockIndex = 0;
+
+  for (int blockY = 0; blockY < height; blockY += 4)
+  {
+    for (int blockX = 0; blockX < width; blockX += 4, ++blockIndex)
+    {
+      // edge blocks repeat the last row / column, so padding never drags the endpoints
+      unsigned char block[64];
+      for (int y = 0; y < 4; ++y)
+        for (int x = 0; x < 4; ++x)
+        {
+          int sourceX = std::min(blockX + x, width - 1), sourceY = std::min(blockY + y, height - 1);
+          std::memcpy(block + (y * 4 + x) * 4, pixels + (static_cast<size_t>(sourceY) * width + sourceX) * 4, 4);
+        }
+
+      unsigned char *target = out.data() + blockIndex * blockBytes;
+      switch (encoding)
+      {
+      case TextureEncoding::BC1:
+        encodeBC1(block, target);
+        break;
+      case TextureEncoding::BC4:
+        encodeBC4(block, target);
+        break;
+      case TextureEncoding::BC7:
+        encodeBC7(block, target);
+        break;
+      default:
+        break;
+      }
+    }
+  }
+
+  return out;
+}
+
+/// @brief Decode blocks back to RGBA8. BC4 is expanded to gray, like the red swizzle used when sampling it on the GPU.
+std::vector<unsigned char> TextureCompressor::decode(TextureEncoding encoding, const unsigned char *data, int width, int height)
+{
+  if (encoding == TextureEncoding::RGBA8)
+    return std::vector<unsigned char>(data, data + static_cast<size_t>(width) * height * 4);
+
+  std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+  size_t blockBytes = getBlockBytes(encoding);
+  size_t blockIndex = 0;
+
+  for (int blockY = 0; blockY < height; blockY += 4)
+  {
+    for (int blockX = 0; blockX < width; blockX += 4, ++blockIndex)
+    {
+      unsigned char block[64];
+      const unsigned char *source = data + blockIndex * blockBytes;
+
+      switch (encoding)
+      {
+      case TextureEncoding::BC1:
+        decodeBC1(source, block);
+        break;
+      case TextureEncoding::BC4:
+        decodeBC4(source, block);
+        break;
+      case TextureEncoding::BC7:
+        decodeBC7(source, block);
+        break;
+      default:
+        break;
+      }
+
+      for (int y = 0; y < 4 && blockY + y < height; ++y)
+        for (int x = 0; x < 4 && blockX + x < width; ++x)
+          std::memcpy(pixels.data() + (static_cast<size_t>(blockY + y) * width + blockX + x) * 4, block + (y * 4 + x) * 4, 4);
+    }
+  }
+
+  return pixels;
+}
+
+size_t TextureCompressor::getEncodedSize(TextureEncoding encoding, int width, int height)
+{
+  if (encoding == TextureEncoding::RGBA8)
+    return static_cast<size_t>(width) * height * 4;
+
+  size_t blocksX = (std::max(1, width) + 3) / 4, blocksY = (std::max(1, height) + 3) / 4;
+  return blocksX * blocksY * getBlockBytes(encoding);
+}
+
+/// @brief Peak signal to noise ratio over the first channels of two RGBA8 images
+/// @return PSNR in dB, infinity for identical images
+double TextureCompressor::computePSNR(const unsigned char *a, const unsigned char *b, int width, int height, int channels)
+{
+  double squaredError = 0.0;
+  size_t pixelCount = static_cast<size_t>(width) * height;
+
+  for (size_t i = 0; i < pixelCount; ++i)
+    for (int c = 0; c < channels; ++c)
+    {
+      double difference = static_cast<double>(a[i * 4 + c]) - b[i * 4 + c];
+      squaredError += difference * difference;
+    }
+
+  double meanSquaredError = squaredError / (static_cast<double>(pixelCount) * channels);
+  if (meanSquaredError == 0.0)
+    return std::numeric_limits<double>::infinity();
+
+  return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+}
+
+/// @return the channels an encoding preserves, the rest is not compared in round-trip checks
+int TextureCompressor::getComparedChannels(TextureEncoding encoding)
+{
+  switch (encoding)
+  {
+  case TextureEncoding::BC1:
+    return 3;
+  case TextureEncoding::BC4:
+    return 1;
+  default:
+    return 4;
+  }
+}
+
+// ------- private ------- //
+
+void TextureCompressor::encodeBC1(const unsigned char block[64], unsigned char *out)
+{
+  float low[4], high[4];
+  fitEndpoints(block, 3, low, high);
+
+  refineEndpoints(block, 3, low, high, 8, out, [&](const float *low, const float *high, unsigned char *target, float *weights)
+                  {
+    uint16_t color0 = packRGB565(high), color1 = packRGB565(low);
+
+    // color0 > color1 selects the four color mode, equal endpoints leave every index at 0
+    bool swapped = color0 < color1;
+    if (swapped)
+      std::swap(color0, color1);
+
+    int palette[4][4];
+    unpackRGB565(color0, palette[0]);
+    unpackRGB565(color1, palette[1]);
+    for (int c = 0; c < 3; ++c)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    int indices[16] = {};
+    if (color0 != color1)
+      selectIndices<4>(block, 3, palette, indices);
+
+    static constexpr float INDEX_WEIGHTS[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f}; // towards color0
+    uint32_t packedIndices = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+      packedIndices |= static_cast<uint32_t>(indices[i]) << (i * 2);
+      weights[i] = swapped ? 1.0f - INDEX_WEIGHTS[indices[i]] : INDEX_WEIGHTS[indices[i]];
+    }
+
+    std::memcpy(target, &color0, 2);
+    std::memcpy(target + 2, &color1, 2);
+    std::memcpy(target + 4, &packedIndices, 4);
+
+    return getPaletteError<4>(block, 3, palette, indices); });
+}
+
+void TextureCompressor::encodeBC4(const unsigned char block[64], unsigned char *out)
+{
+  float low[4] = {255.0f, 0, 0, 0}, high[4] = {0.0f, 0, 0, 0};
+  for (int i = 0; i < 16; ++i)
+  {
+    low[0] = std::min<float>(low[0], block[i * 4]);
+    high[0] = std::max<float>(high[0], block[i * 4]);
+  }
+
+  refineEndpoints(block, 1, low, high, 8, out, [&](const float *low, const float *high, unsigned char *target, float *weights)
+                  {
+    int maximum = static_cast<int>(std::lround(high[0])), minimum = static_cast<int>(std::lround(low[0]));
+    if (maximum < minimum)
+      std::swap(maximum, minimum);
+
+    // red0 > red1 selects the eight value mode
+    int palette[8][4] = {};
+    palette[0][0] = maximum;
+    palette[1][0] = minimum;
+    for (int i = 2; i < 8; ++i)
+      palette[i][0] = ((8 - i) * maximum + (i - 1) * minimum) / 7;
+
+    int indices[16] = {};
+    if (maximum != minimum)
+      selectIndices<8>(block, 1, palette, indices);
+
+    std::memset(target, 0, 8);
+    target[0] = static_cast<unsigned char>(maximum);
+    target[1] = static_cast<unsigned char>(minimum);
+
+    int position = 16;
+    for (int i = 0; i < 16; ++i)
+    {
+      writeBits(target, position, static_cast<uint32_t>(indices[i]), 3);
+      weights[i] = indices[i] == 0 ? 1.0f : indices[i] == 1 ? 0.0f : (8 - indices[i]) / 7.0f;
+    }
+
+    return getPaletteError<8>(block, 1, palette, indices); });
+}
+
+/// @brief BC7 mode 6 only: one subset, 7 bit RGBA endpoints with a unique p-bit each and 4 bit indices.
+/// Block textures rarely need the partitioned modes and mode 6 keeps the encoder small.
+void TextureCompressor::encodeBC7(const unsigned char block[64], unsigned char *out)
+{
+  float low[4], high[4];
+  fitEndpoints(block, 4, low, high);
+
+  refineEndpoints(block, 4, low, high, 16, out, [&](const float *low, const float *high, unsigned char *target, float *weights)
+                  {
+    const float *endpoints[2] = {low, high};
+
+    // quantize each endpoint with the p-bit that lands closer to it
+    int quantized[2][4], pBits[2];
+    for (int e = 0; e < 2; ++e)
+    {
+      float bestError = std::numeric_limits<float>::max();
+      for (int p = 0; p < 2; ++p)
+      {
+        int candidate[4];
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c)
+        {
+          candidate[c] = std::clamp(static_cast<int>(std::lround((endpoints[e][c] - p) / 2.0f)), 0, 127);
+          float difference = static_cast<float>((candidate[c] << 1) | p) - endpoints[e][c];
+          error += difference * difference;
+        }
+        if (error < bestError)
+        {
+          bestError = error;
+          pBits[e] = p;
+          std::memcpy(quantized[e], candidate, sizeof(candidate));
+        }
+      }
+    }
+
+    int palette[16][4];
+    for (int i = 0; i < 16; ++i)
+      for (int c = 0; c < 4; ++c)
+      {
+        int e0 = (quantized[0][c] << 1) | pBits[0], e1 = (quantized[1][c] << 1) | pBits[1];
+        palette[i][c] = ((64 - BC7_WEIGHTS[i]) * e0 + BC7_WEIGHTS[i] * e1 + 32) >> 6;
+      }
+
+    int indices[16];
+    selectIndices<16>(block, 4, palette, indices);
+    int error = getPaletteError<16>(block, 4, palette, indices);
+
+    for (int i = 0; i < 16; ++i)
+      weights[i] = BC7_WEIGHTS[indices[i]] / 64.0f;
+
+    // the anchor index is stored without its top bit, flip the palette if it would need it
+    if (indices[0] & 8)
+    {
+      std::swap(quantized[0], quantized[1]);
+      std::swap(pBits[0], pBits[1]);
+      for (int &index : indices)
+        index = 15 - index;
+    }
+
+    std::memset(target, 0, 16);
+    int position = 0;
+    writeBits(target, position, 1u << 6, 7); // mode 6
+
+    for (int c = 0; c < 4; ++c)
+    {
+      writeBits(target, position, static_cast<uint32_t>(quantized[0][c]), 7);
+      writeBits(target, position, static_cast<uint32_t>(quantized[1][c]), 7);
+    }
+
+    writeBits(target, position, static_cast<uint32_t>(pBits[0]), 1);
+    writeBits(target, position, static_cast<uint32_t>(pBits[1]), 1);
+
+    writeBits(target, position, static_cast<uint32_t>(indices[0]), 3);
+    for (int i = 1; i < 16; ++i)
+      writeBits(target, position, static_cast<uint32_t>(indices[i]), 4);
+
+    return error; });
+}
+
+void TextureCompressor::decodeBC1(const unsigned char *data, unsigned char block[64])
+{
+  uint16_t color0, color1;
+  uint32_t packedIndices;
+  std::memcpy(&color0, data, 2);
+  std::memcpy(&color1, data + 2, 2);
+  std::memcpy(&packedIndices, data + 4, 4);
+
+  int palette[4][4];
+  unpackRGB565(color0, palette[0]);
+  unpackRGB565(color1, palette[1]);
+
+  for (int c = 0; c < 3; ++c)
+  {
+    if (color0 > color1)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+    else
+    {
+      palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+      palette[3][c] = 0;
+    }
+  }
+  palette[2][3] = 255;
+  palette[3][3] = color0 > color1 ? 255 : 0;
+
+  for (int i = 0; i < 16; ++i)
+  {
+    int index = (packedIndices >> (i * 2)) & 3;
+    for (int c = 0; c < 4; ++c)
+      block[i * 4 + c] = static_cast<unsigned char>(palette[index][c]);
+  }
+}
+
+void TextureCompressor::decodeBC4(const unsigned char *data, unsigned char block[64])
+{
+  int red0 = data[0], red1 = data[1];
+  int palette[8];
+  palette[0] = red0;
+  palette[1] = red1;
+
+  if (red0 > red1)
+  {
+    for (int i = 2; i < 8; ++i)
+      palette[i] = ((8 - i) * red0 + (i - 1) * red1) / 7;
+  }
+  else
+  {
+    for (int i = 2; i < 6; ++i)
+      palette[i] = ((6 - i) * red0 + (i - 1) * red1) / 5;
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+
+  int position = 16;
+  for (int i = 0; i < 16; ++i)
+  {
+    auto value = static_cast<unsigned char>(palette[readBits(data, position, 3)]);
+    block[i * 4 + 0] = value;
+    block[i * 4 + 1] = value;
+    block[i * 4 + 2] = value;
+    block[i * 4 + 3] = 255;
+  }
+}
+
+/// @brief Decodes the mode 6 blocks the encoder writes, blocks of other modes decode to magenta
+void TextureCompressor::decodeBC7(const unsigned char *data, unsigned char block[64])
+{
+  int position = 0;
+  if (readBits(data, position, 7) != (1u << 6))
+  {
+    for (int i = 0; i < 16; ++i)
+    {
+      block[i * 4 + 0] = 255;
+      block[i * 4 + 1] = 0;
+      block[i * 4 + 2] = 255;
+      block[i * 4 + 3] = 255;
+    }
+    return;
+  }
+
+  int endpoints[2][4];
+  for (int c = 0; c < 4; ++c)
+  {
+    endpoints[0][c] = static_cast<int>(readBits(data, position, 7));
+    endpoints[1][c] = static_cast<int>(readBits(data, position, 7));
+  }
+
+  int pBit0 = static_cast<int>(readBits(data, position, 1)), pBit1 = static_cast<int>(readBits(data, position, 1));
+  for (int c = 0; c < 4; ++c)
+  {
+    endpoints[0][c] = (endpoints[0][c] << 1) | pBit0;
+    endpoints[1][c] = (endpoints[1][c] << 1) | pBit1;
+  }
+
+  for (int i = 0; i < 16; ++i)
+  {
+    int index = static_cast<int>(readBits(data, position, i == 0 ? 3 : 4));
+    for (int c = 0; c < 4; ++c)
+      block[i * 4 + c] = static_cast<unsigned char>(((64 - BC7_WEIGHTS[index]) * endpoints[0][c] + BC7_WEIGHTS[index] * endpoints[1][c] + 32) >> 6);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+/*
+  File: TextureCompressor.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Storage format of texture data. Values are written to the asset bundle, do not reorder.
+enum class TextureEncoding : uint32_t
+{
+  RGBA8 = 0,
+  BC1 = 1, // 4 bpp RGB, opaque maps (emissive)
+  BC4 = 2, // 4 bpp single channel, grayscale maps (specular)
+  BC7 = 3, // 8 bpp RGBA, color maps (diffuse)
+};
+
+/// @brief CPU encoder and decoder for the block compressed formats. The encoder runs offline in the bundler,
+/// the decoder is the fallback for drivers without support for a format and the reference for round-trip checks.
+/// Images are RGBA8, dimensions do not have to be multiples of 4.
+class TextureCompressor
+{
+public:
+  static std::vector<unsigned char> encode(TextureEncoding encoding, const unsigned char *pixels, int width, int height);
+  static std::vector<unsigned char> decode(TextureEncoding encoding, const unsigned char *data, int width, int height);
+
+  static size_t getEncodedSize(TextureEncoding encoding, int width, int height);
+  static double computePSNR(const unsigned char *a, const unsigned char *b, int width, int height, int channels);
+  static int getComparedChannels(TextureEncoding encoding);
+
+private:
+  static void encodeBC1(const unsigned char block[64], unsigned char *out);
+  static void encodeBC4(const unsigned char block[64], unsigned char *out);
+  static void encodeBC7(const unsigned char block[64], unsigned char *out);
+
+  static void decodeBC1(const unsigned char *data, unsigned char block[64]);
+  static void decodeBC4(const unsigned char *data, unsigned char block[64]);
+  static void decodeBC7(const unsigned char *data, unsigned char block[64]);
+};
\ No newline at end of file
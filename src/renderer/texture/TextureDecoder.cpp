@@ -0,0 +1,114 @@
+/*
+  File: TextureDecoder.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "TextureDecoder.h"
+
+#include <stbi/stb_image.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+/// @param threadCount worker threads per decode call, 0 uses one per hardware thread
+TextureDecoder::TextureDecoder(unsigned int threadCount)
+    : threadCount(threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+/// @brief Decode a batch of images in parallel. Paths already decoded by an earlier call are taken from the cache,
+/// duplicates within the batch are decoded once.
+/// @param paths image file paths
+/// @return one image per path, in the order of the paths
+std::vector<sDecodedImagePtr> TextureDecoder::decode(const std::vector<std::string> &paths)
+{
+  std::vector<std::string> pending;
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (const auto &path : paths)
+    {
+      // reserve the slot so duplicates are only queued once
+      if (cache.try_emplace(path, nullptr).second)
+        pending.push_back(path);
+    }
+  }
+
+  if (!pending.empty())
+  {
+    std::atomic<size_t> next = 0;
+    auto worker = [&]()
+    {
+      for (size_t i = next++; i < pending.size(); i = next++)
+      {
+        auto image = decodeFile(pending[i]);
+
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        cache[pending[i]] = std::move(image);
+      }
+    };
+
+    unsigned int workerCount = std::min<unsigned int>(threadCount, static_cast<unsigned int>(pending.size()));
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount - 1);
+
+    // the calling thread works along instead of idling in join
+    for (unsigned int i = 1; i < workerCount; ++i)
+      workers.emplace_back(worker);
+    worker();
+
+    for (auto &thread : workers)
+      thread.join();
+
+    std::cout << "[TextureDecoder] decoded " << pending.size() << " images on " << workerCount << " threads" << std::endl;
+  }
+
+  std::vector<sDecodedImagePtr> images;
+  images.reserve(paths.size());
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  for (const auto &path : paths)
+    images.push_back(cache[path]);
+
+  return images;
+}
+
+/// @brief Release all cached images, e.g. once every texture set sharing them has been uploaded
+void TextureDecoder::clear()
+{
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  cache.clear();
+}
+
+// getters
+unsigned int TextureDecoder::getThreadCount() const
+{
+  return threadCount;
+}
+
+// ------- private ------- //
+
+sDecodedImagePtr TextureDecoder::decodeFile(const std::string &path)
+{
+  auto image = std::make_shared<DecodedImage>();
+  if (path.empty())
+    return image;
+
+  int channels = 0;
+  unsigned char *imageData = stbi_load(path.c_str(), &image->width, &image->height, &channels, 4);
+
+  if (!imageData)
+  {
+    std::cerr << "[TextureDecoder] Unable to decode " << path << ": " << stbi_failure_reason() << std::endl;
+    return image;
+  }
+
+  image->pixels.resize(static_cast<size_t>(image->width) * image->height * 4);
+  std::memcpy(image->pixels.data(), imageData, image->pixels.size());
+  stbi_image_free(imageData);
+
+  return image;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+/*
+  File: TextureDecoder.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief An RGBA8 image decoded on the CPU, empty pixels if decoding failed
+struct DecodedImage
+{
+  int width = 0, height = 0;
+  std::vector<unsigned char> pixels;
+
+  bool isValid() const { return !pixels.empty(); }
+};
+
+using sDecodedImagePtr = std::shared_ptr<const DecodedImage>;
+
+/// @brief Decodes image files on worker threads. Decoded images are cached by path, so texture sets
+/// referencing the same file (e.g. specular and emissive maps) decode it only once.
+class TextureDecoder
+{
+public:
+  TextureDecoder(unsigned int threadCount = 0);
+
+  TextureDecoder(const TextureDecoder &) = delete;
+  TextureDecoder &operator=(const TextureDecoder &) = delete;
+
+  std::vector<sDecodedImagePtr> decode(const std::vector<std::string> &paths);
+  void clear();
+
+  // getters
+  unsigned int getThreadCount() const;
+
+private:
+  unsigned int threadCount;
+  std::unordered_map<std::string, sDecodedImagePtr> cache;
+  std::mutex cacheMutex;
+
+  static sDecodedImagePtr decodeFile(const std::string &path);
+};
\ No newline at end of file
@@ -0,0 +1,130 @@
+/*
+  File: TaskPool.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "TaskPool.h"
+
+#include <algorithm>
+#include <iostream>
+
+TaskPool::TaskPool()
+{
+  // the calling thread is one of the workers
+  unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+  for (unsigned int i = 1; i < hardwareThreads; ++i)
+    workers.emplace_back(&TaskPool::workerLoop, this);
+
+  std::cout << "[TaskPool] started " << workers.size() << " worker threads" << std::endl;
+}
+
+TaskPool::~TaskPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+
+  for (auto &worker : workers)
+    worker.join();
+}
+
+/// @brief Run a task over [0, count) split into chunks
+/// @param count number of items
+/// @param minChunkSize items per chunk at least, small counts run on the calling thread only
+/// @param task called with [begin, end) of every chunk, concurrently from several threads
+void TaskPool::parallelFor(size_t count, size_t minChunkSize, const std::function<void(size_t begin, size_t end)> &task)
+{
+  if (count == 0)
+    return;
+
+  size_t threads = workers.size() + 1;
+  size_t chunkSize = std::max(minChunkSize, (count + threads - 1) / threads);
+
+  if (workers.empty() || chunkSize >= count)
+  {
+    task(0, count);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->task = &task;
+    this->count = count;
+    this->chunkSize = chunkSize;
+    this->chunkCount = (count + chunkSize - 1) / chunkSize;
+    nextChunk = 0;
+    remainingChunks = chunkCount;
+    ++generation;
+  }
+  wake.notify_all();
+
+  runChunks();
+
+  // workers must have left the job before the next one may replace it
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [this]
+            { return remainingChunks == 0 && activeWorkers == 0; });
+  this->task = nullptr;
+}
+
+// getters
+unsigned int TaskPool::getWorkerCount() const
+{
+  return static_cast<unsigned int>(workers.size());
+}
+
+// ------- private ------- //
+
+void TaskPool::workerLoop()
+{
+  uint64_t seenGeneration = 0;
+
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [&]
+                { return stopping || generation != seenGeneration; });
+
+      if (stopping)
+        return;
+
+      seenGeneration = generation;
+      if (!task)
+        continue;
+      ++activeWorkers;
+    }
+
+    runChunks();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      --activeWorkers;
+    }
+    done.notify_all();
+  }
+}
+
+void TaskPool::runChunks()
+{
+  while (true)
+  {
+    size_t chunk = nextChunk++;
+    if (chunk >= chunkCount)
+      return;
+
+    size_t begin = chunk * chunkSize;
+    (*task)(begin, std::min(begin + chunkSize, count));
+
+    if (--remainingChunks == 0)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      done.notify_all();
+    }
+  }
+}
\ No newline at end of file
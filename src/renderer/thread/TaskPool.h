@@ -0,0 +1,56 @@
+/*
+  File: TaskPool.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Persistent worker threads for splitting per-frame work, so hot loops don't pay for spawning threads every frame.
+/// parallelFor() blocks until all chunks ran, the calling thread works on chunks as well.
+class TaskPool
+{
+public:
+  static TaskPool &getInstance()
+  {
+    static TaskPool instance;
+    return instance;
+  }
+
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  void parallelFor(size_t count, size_t minChunkSize, const std::function<void(size_t begin, size_t end)> &task);
+
+  // getters
+  unsigned int getWorkerCount() const;
+
+private:
+  TaskPool();
+  ~TaskPool();
+
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wake, done;
+
+  // the running job, only changed while no worker is inside it
+  const std::function<void(size_t, size_t)> *task = nullptr;
+  size_t count = 0, chunkSize = 0, chunkCount = 0;
+  std::atomic<size_t> nextChunk{0}, remainingChunks{0};
+  unsigned int activeWorkers = 0;
+  uint64_t generation = 0;
+  bool stopping = false;
+
+  void workerLoop();
+  void runChunks();
+};
\ No newline at end of file
@@ -8,70 +8,103 @@
 #include "Transform.h"
 
 Transform::Transform()
+    : handle(TransformStore::getInstance().create())
 {
-  updateRotationQuaternion();
 }
 
 Transform::Transform(glm::vec3 pos, glm::vec3 rot, glm::vec3 scl)
-    : position(pos), rotation(rot), scale(scl)
+    : Transform()
 {
-  updateRotationQuaternion();
+  setPosition(pos);
+  setRotation(rot);
+  setScale(scl);
 }
 
-glm::mat4 Transform::getModelMatrix()
+Transform::~Transform()
 {
-  if (dirty)
+  if (handle != INVALID_TRANSFORM)
+    TransformStore::getInstance().destroy(handle);
+}
+
+Transform::Transform(Transform &&other) noexcept
+    : handle(other.handle)
+{
+  other.handle = INVALID_TRANSFORM;
+}
+
+Transform &Transform::operator=(Transform &&other) noexcept
+{
+  if (this != &other)
   {
-    updateModelMatrix();
-    dirty = false;
+    if (handle != INVALID_TRANSFORM)
+      TransformStore::getInstance().destroy(handle);
+    handle = other.handle;
+    other.handle = INVALID_TRANSFORM;
   }
-  return modelMatrixCache;
+  return *this;
+}
+
+/// @brief The world model matrix, rebuilt by the store's per-frame batch update or on demand if the transform changed since
+glm::mat4 Transform::getModelMatrix() const
+{
+  return TransformStore::getInstance().getModelMatrix(handle);
 }
 
-void Transform::updateRotationQuaternion()
+TransformHandle Transform::getHandle() const
 {
-  rotationQuaternion = glm::quat(glm::radians(rotation));
+  return handle;
 }
 
-void Transform::updateModelMatrix()
+TransformHandle Transform::getParent() const
 {
-  glm::mat4 model = glm::mat4(1.0f);
-  model = glm::translate(model, position);
-  model *= glm::mat4(rotationQuaternion);
-  model = glm::scale(model, scale);
-  modelMatrixCache = model;
+  return TransformStore::getInstance().getParent(handle);
+}
+
+/// @brief Attach this transform to another one, it then follows the parent's world transform
+/// @param parent the parent, nullptr to detach
+/// @return false if the parent is this transform or one of its descendants
+bool Transform::setParent(const Transform *parent)
+{
+  return TransformStore::getInstance().setParent(handle, parent ? parent->handle : INVALID_TRANSFORM);
 }
 
 void Transform::setPosition(const glm::vec3 &pos)
 {
-  position = pos;
-  dirty = true;
+  TransformStore::getInstance().setPosition(handle, pos);
 }
 
 void Transform::setRotation(const glm::vec3 &rot)
 {
-  rotation = rot;
-  updateRotationQuaternion();
-  dirty = true;
+  TransformStore::getInstance().setRotation(handle, rot);
 }
 
 void Transform::setScale(const glm::vec3 &scl)
 {
-  scale = scl;
-  dirty = true;
+  TransformStore::getInstance().setScale(handle, scl);
 }
 
 glm::vec3 Transform::getPosition() const
 {
-  return position;
+  return TransformStore::getInstance().getPosition(handle);
 }
 
 glm::vec3 Transform::getRotation() const
 {
-  return rotation;
+  return TransformStore::getInstance().getRotation(handle);
 }
 
 glm::vec3 Transform::getScale() const
 {
-  return scale;
+  return TransformStore::getInstance().getScale(handle);
+}
+
+glm::vec3 Transform::getWorldPosition() const
+{
+  return glm::vec3(getModelMatrix()[3]);
+}
+
+glm::vec3 Transform::getWorldScale() const
+{
+  glm::mat4 model = getModelMatrix();
+  return glm::vec3(glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2])));
 }
\ No newline at end of file
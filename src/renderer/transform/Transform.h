@@ -12,35 +12,39 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/mat4x4.hpp>
 
+#include "renderer/transform/TransformStore.h"
+
+/// @brief Handle to a slot in the TransformStore, the data itself lives in the store's contiguous arrays.
+/// Owns its slot, so it can be moved but not copied. Position, rotation and scale are relative to the parent if there is one.
 class Transform
 {
 
 public:
   Transform();
+  ~Transform();
+
+  Transform(const Transform &) = delete;
+  Transform &operator=(const Transform &) = delete;
+  Transform(Transform &&other) noexcept;
+  Transform &operator=(Transform &&other) noexcept;
 
   void setPosition(const glm::vec3 &pos);
   void setRotation(const glm::vec3 &rot);
   void setScale(const glm::vec3 &scl);
+  bool setParent(const Transform *parent);
 
   glm::vec3 getPosition() const;
   glm::vec3 getRotation() const;
   glm::vec3 getScale() const;
+  glm::vec3 getWorldPosition() const;
+  glm::vec3 getWorldScale() const;
 
-  glm::mat4 getModelMatrix();
+  glm::mat4 getModelMatrix() const;
+  TransformHandle getHandle() const;
+  TransformHandle getParent() const;
 
 private:
-  glm::vec3 position{0.0f, 0.0f, 0.0f};
-  // rotation in euler angles (x, y, z)
-  glm::vec3 rotation{0.0f, 0.0f, 0.0f};
-  glm::vec3 scale{1.0f, 1.0f, 1.0f};
-
-  glm::quat rotationQuaternion;
-  glm::mat4 modelMatrixCache;
-
-  bool dirty = true;
+  TransformHandle handle;
 
   Transform(glm::vec3 pos, glm::vec3 rot, glm::vec3 scl);
-
-  void updateRotationQuaternion();
-  void updateModelMatrix();
 };
\ No newline at end of file
@@ -0,0 +1,416 @@
+/*
+  File: TransformStore.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "TransformStore.h"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+
+#include "renderer/thread/TaskPool.h"
+
+// SSE2 is part of every x86-64 target, other architectures use the scalar path
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define X0V_TRANSFORM_SSE
+#include <xmmintrin.h>
+#endif
+
+constexpr size_t GROUP_SIZE = 4;
+
+/// @brief Get a slot for a new root transform, initialized to the identity
+TransformHandle TransformStore::create()
+{
+  if (freeSlots.empty())
+  {
+    // grow by a whole group, the batch update always works on four slots
+    size_t first = localMatrices.size();
+    size_t size = first + GROUP_SIZE;
+
+    for (auto *array : {&positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &rotationW, &scaleX, &scaleY, &scaleZ})
+      array->resize(size);
+    localMatrices.resize(size);
+    worldMatrices.resize(size);
+    eulerRotations.resize(size);
+    worldChanged.resize(size);
+    parents.resize(size, INVALID_TRANSFORM);
+    children.resize(size);
+    depths.resize(size);
+    levelPositions.resize(size);
+    dirtyBits.resize((size + 63) / 64);
+
+    for (size_t i = size; i-- > first;)
+    {
+      reset(static_cast<TransformHandle>(i));
+      freeSlots.push_back(static_cast<TransformHandle>(i));
+    }
+  }
+
+  TransformHandle handle = freeSlots.back();
+  freeSlots.pop_back();
+  ++count;
+
+  parents[handle] = INVALID_TRANSFORM;
+  addToLevel(handle, 0);
+
+  return handle;
+}
+
+/// @brief Release a slot, the handle must not be used afterwards. Children become roots and keep their local transform.
+void TransformStore::destroy(TransformHandle handle)
+{
+  for (TransformHandle child : std::vector<TransformHandle>(children[handle]))
+    setParent(child, INVALID_TRANSFORM);
+  setParent(handle, INVALID_TRANSFORM);
+
+  removeFromLevel(handle);
+  reset(handle);
+  dirtyBits[handle / 64] &= ~(1ull << (handle % 64));
+  freeSlots.push_back(handle);
+  --count;
+}
+
+/// @brief Rebuild the local matrices of all transforms changed since the last update, then propagate world matrices
+/// down the levels below them. Call once per frame before rendering.
+void TransformStore::updateMatrices()
+{
+  // the flags of the last update stay readable through hasWorldChanged() until now
+  if (worldChangesKept)
+  {
+    std::fill(worldChanged.begin(), worldChanged.end(), 0);
+    worldChangesKept = false;
+  }
+
+  if (!pendingChanges)
+    return;
+
+  for (size_t word = 0; word < dirtyBits.size(); ++word)
+  {
+    uint64_t bits = dirtyBits[word];
+
+    for (uint64_t changed = bits; changed; changed &= changed - 1)
+      worldChanged[word * 64 + std::countr_zero(changed)] = 1;
+
+    while (bits)
+    {
+      // a group is four aligned bits, updating its clean neighbours as well is cheaper than picking them out
+      size_t group = static_cast<size_t>(std::countr_zero(bits)) & ~(GROUP_SIZE - 1);
+      updateGroup(word * 64 + group);
+      bits &= ~(0xfull << group);
+    }
+
+    dirtyBits[word] = 0;
+  }
+
+  // a level needs a sweep if one of its transforms changed or the level above it was swept
+  bool levelAboveSwept = false;
+  for (size_t depth = 0; depth < levels.size(); ++depth)
+  {
+    if (!levelDirty[depth] && !levelAboveSwept)
+      continue;
+
+    const Level &level = levels[depth];
+    if (level.nodes.size() >= PARALLEL_LEVEL_SIZE)
+      TaskPool::getInstance().parallelFor(level.nodes.size(), PARALLEL_LEVEL_SIZE / 4, [this, &level](size_t begin, size_t end)
+                                          { propagateLevel(level, begin, end); });
+    else
+      propagateLevel(level, 0, level.nodes.size());
+
+    levelDirty[depth] = 0;
+    levelAboveSwept = true;
+  }
+
+  worldChangesKept = true;
+  pendingChanges = false;
+}
+
+// setters
+void TransformStore::setPosition(TransformHandle handle, const glm::vec3 &position)
+{
+  positionX[handle] = position.x;
+  positionY[handle] = position.y;
+  positionZ[handle] = position.z;
+  markDirty(handle);
+}
+
+/// @param eulerRotation rotation in degrees around x, y and z
+void TransformStore::setRotation(TransformHandle handle, const glm::vec3 &eulerRotation)
+{
+  glm::quat rotation = glm::quat(glm::radians(eulerRotation));
+
+  eulerRotations[handle] = eulerRotation;
+  rotationX[handle] = rotation.x;
+  rotationY[handle] = rotation.y;
+  rotationZ[handle] = rotation.z;
+  rotationW[handle] = rotation.w;
+  markDirty(handle);
+}
+
+void TransformStore::setScale(TransformHandle handle, const glm::vec3 &scale)
+{
+  scaleX[handle] = scale.x;
+  scaleY[handle] = scale.y;
+  scaleZ[handle] = scale.z;
+  markDirty(handle);
+}
+
+/// @brief Attach a transform to a parent, its local transform is then relative to the parent's world transform
+/// @param handle the child
+/// @param parent the new parent, INVALID_TRANSFORM to make the transform a root
+/// @return false if the parent is part of the transform's own subtree
+bool TransformStore::setParent(TransformHandle handle, TransformHandle parent)
+{
+  if (parents[handle] == parent)
+    return true;
+
+  for (TransformHandle ancestor = parent; ancestor != INVALID_TRANSFORM; ancestor = parents[ancestor])
+  {
+    if (ancestor == handle)
+    {
+      std::cerr << "[TransformStore] Refusing to parent transform " << handle << " into its own subtree" << std::endl;
+      return false;
+    }
+  }
+
+  if (parents[handle] != INVALID_TRANSFORM)
+  {
+    auto &siblings = children[parents[handle]];
+    siblings.erase(std::find(siblings.begin(), siblings.end(), handle));
+  }
+
+  parents[handle] = parent;
+  if (parent != INVALID_TRANSFORM)
+    children[parent].push_back(handle);
+
+  moveSubtree(handle, parent != INVALID_TRANSFORM ? depths[parent] + 1 : 0);
+  markDirty(handle);
+
+  return true;
+}
+
+// getters
+glm::vec3 TransformStore::getPosition(TransformHandle handle) const
+{
+  return glm::vec3(positionX[handle], positionY[handle], positionZ[handle]);
+}
+
+glm::vec3 TransformStore::getRotation(TransformHandle handle) const
+{
+  return eulerRotations[handle];
+}
+
+glm::quat TransformStore::getRotationQuaternion(TransformHandle handle) const
+{
+  return glm::quat(rotationW[handle], rotationX[handle], rotationY[handle], rotationZ[handle]);
+}
+
+glm::vec3 TransformStore::getScale(TransformHandle handle) const
+{
+  return glm::vec3(scaleX[handle], scaleY[handle], scaleZ[handle]);
+}
+
+TransformHandle TransformStore::getParent(TransformHandle handle) const
+{
+  return parents[handle];
+}
+
+const std::vector<TransformHandle> &TransformStore::getChildren(TransformHandle handle) const
+{
+  return children[handle];
+}
+
+/// @brief The world matrix of a transform. Normally rebuilt by the batch update, if something changed since,
+/// the transform's chain of parents is recomputed on the spot.
+const glm::mat4 &TransformStore::getModelMatrix(TransformHandle handle)
+{
+  if (pendingChanges)
+    return computeWorldMatrix(handle);
+
+  return worldMatrices[handle];
+}
+
+size_t TransformStore::getCount() const
+{
+  return count;
+}
+
+/// @return number of levels in the hierarchy, 1 if there are only roots
+size_t TransformStore::getDepth() const
+{
+  return levels.size();
+}
+
+/// @return whether any world matrix changed in the last updateMatrices()
+bool TransformStore::hasWorldChanges() const
+{
+  return worldChangesKept;
+}
+
+/// @return whether the world matrix of a transform changed in the last updateMatrices(), e.g. to refresh bounds
+bool TransformStore::hasWorldChanged(TransformHandle handle) const
+{
+  return worldChangesKept && worldChanged[handle];
+}
+
+// ------- private ------- //
+
+void TransformStore::reset(TransformHandle handle)
+{
+  positionX[handle] = positionY[handle] = positionZ[handle] = 0.0f;
+  rotationX[handle] = rotationY[handle] = rotationZ[handle] = 0.0f;
+  rotationW[handle] = 1.0f;
+  scaleX[handle] = scaleY[handle] = scaleZ[handle] = 1.0f;
+  eulerRotations[handle] = glm::vec3(0.0f);
+  localMatrices[handle] = glm::mat4(1.0f);
+  worldMatrices[handle] = glm::mat4(1.0f);
+}
+
+void TransformStore::markDirty(TransformHandle handle)
+{
+  dirtyBits[handle / 64] |= 1ull << (handle % 64);
+  levelDirty[depths[handle]] = 1;
+  pendingChanges = true;
+}
+
+/// @brief translate * rotate * scale of a single transform
+void TransformStore::updateMatrix(size_t index)
+{
+  float x = rotationX[index], y = rotationY[index], z = rotationZ[index], w = rotationW[index];
+  float sx = scaleX[index], sy = scaleY[index], sz = scaleZ[index];
+
+  glm::mat4 &model = localMatrices[index];
+  model[0] = glm::vec4((1.0f - 2.0f * (y * y + z * z)) * sx, 2.0f * (x * y + w * z) * sx, 2.0f * (x * z - w * y) * sx, 0.0f);
+  model[1] = glm::vec4(2.0f * (x * y - w * z) * sy, (1.0f - 2.0f * (x * x + z * z)) * sy, 2.0f * (y * z + w * x) * sy, 0.0f);
+  model[2] = glm::vec4(2.0f * (x * z + w * y) * sz, 2.0f * (y * z - w * x) * sz, (1.0f - 2.0f * (x * x + y * y)) * sz, 0.0f);
+  model[3] = glm::vec4(positionX[index], positionY[index], positionZ[index], 1.0f);
+}
+
+/// @brief translate * rotate * scale of four consecutive transforms, starting at a multiple of four
+void TransformStore::updateGroup(size_t first)
+{
+#ifdef X0V_TRANSFORM_SSE
+  const __m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f), zero = _mm_setzero_ps();
+
+  __m128 x = _mm_loadu_ps(&rotationX[first]), y = _mm_loadu_ps(&rotationY[first]);
+  __m128 z = _mm_loadu_ps(&rotationZ[first]), w = _mm_loadu_ps(&rotationW[first]);
+  __m128 sx = _mm_loadu_ps(&scaleX[first]), sy = _mm_loadu_ps(&scaleY[first]), sz = _mm_loadu_ps(&scaleZ[first]);
+
+  __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+  __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+  __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+  // one register per matrix element, lane n belongs to transform first + n
+  __m128 columns[4][4] = {
+      {_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+       _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+       _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+       zero},
+      {_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+       _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+       _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+       zero},
+      {_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+       _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+       _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+       zero},
+      {_mm_loadu_ps(&positionX[first]), _mm_loadu_ps(&positionY[first]), _mm_loadu_ps(&positionZ[first]), one},
+  };
+
+  // transposing a column's four element registers yields that column of each of the four matrices
+  for (int column = 0; column < 4; ++column)
+  {
+    auto &c = columns[column];
+    _MM_TRANSPOSE4_PS(c[0], c[1], c[2], c[3]);
+
+    for (size_t lane = 0; lane < GROUP_SIZE; ++lane)
+      _mm_storeu_ps(&localMatrices[first + lane][column][0], c[lane]);
+  }
+#else
+  for (size_t lane = 0; lane < GROUP_SIZE; ++lane)
+    updateMatrix(first + lane);
+#endif
+}
+
+/// @brief World matrices of a range of a level, the level above is already up to date
+void TransformStore::propagateLevel(const Level &level, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    TransformHandle node = level.nodes[i];
+    TransformHandle parent = level.parents[i];
+
+    if (parent == INVALID_TRANSFORM)
+    {
+      if (worldChanged[node])
+        worldMatrices[node] = localMatrices[node];
+    }
+    else if (worldChanged[node] || worldChanged[parent])
+    {
+      worldMatrices[node] = worldMatrices[parent] * localMatrices[node];
+      worldChanged[node] = 1;
+    }
+  }
+}
+
+/// @brief World matrix of a single transform outside the batch. Dirty flags are kept, the batch still has to
+/// propagate the change to the rest of the subtree.
+const glm::mat4 &TransformStore::computeWorldMatrix(TransformHandle handle)
+{
+  if (dirtyBits[handle / 64] & (1ull << (handle % 64)))
+    updateMatrix(handle);
+
+  if (parents[handle] == INVALID_TRANSFORM)
+    worldMatrices[handle] = localMatrices[handle];
+  else
+    worldMatrices[handle] = computeWorldMatrix(parents[handle]) * localMatrices[handle];
+
+  return worldMatrices[handle];
+}
+
+void TransformStore::addToLevel(TransformHandle handle, uint32_t depth)
+{
+  if (levels.size() <= depth)
+  {
+    levels.resize(depth + 1);
+    levelDirty.resize(depth + 1);
+  }
+
+  Level &level = levels[depth];
+  depths[handle] = depth;
+  levelPositions[handle] = static_cast<uint32_t>(level.nodes.size());
+  level.nodes.push_back(handle);
+  level.parents.push_back(parents[handle]);
+}
+
+void TransformStore::removeFromLevel(TransformHandle handle)
+{
+  Level &level = levels[depths[handle]];
+  uint32_t position = levelPositions[handle];
+
+  // swap with the last transform of the level, order within a level does not matter for the sweep
+  TransformHandle last = level.nodes.back();
+  level.nodes[position] = last;
+  level.parents[position] = level.parents.back();
+  levelPositions[last] = position;
+  level.nodes.pop_back();
+  level.parents.pop_back();
+
+  while (!levels.empty() && levels.back().nodes.empty())
+  {
+    levels.pop_back();
+    levelDirty.pop_back();
+  }
+}
+
+/// @brief Re-list a transform and everything below it under a new depth
+void TransformStore::moveSubtree(TransformHandle handle, uint32_t depth)
+{
+  removeFromLevel(handle);
+  addToLevel(handle, depth);
+
+  for (TransformHandle child : children[handle])
+    moveSubtree(child, depth + 1);
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+/*
+  File: TransformStore.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+using TransformHandle = uint32_t;
+
+constexpr TransformHandle INVALID_TRANSFORM = ~TransformHandle(0);
+
+/// @brief Positions, rotations, scales and matrices of all transforms in contiguous structure-of-arrays storage.
+/// Setters only flag a transform in the dirty bitset, updateMatrices() then rebuilds every dirty local matrix in one pass,
+/// four transforms per SSE instruction. Slots are handed out in groups of four so the batch never reads past the arrays.
+///
+/// Transforms can have a parent. Besides the slot arrays, every transform is listed in the level of its depth in the
+/// hierarchy, so world matrices are propagated top-down with one linear sweep per level. Only subtrees below a changed
+/// transform are recomputed, and wide levels are split across the TaskPool.
+class TransformStore
+{
+public:
+  static TransformStore &getInstance()
+  {
+    static TransformStore instance;
+    return instance;
+  }
+
+  TransformStore(const TransformStore &) = delete;
+  TransformStore &operator=(const TransformStore &) = delete;
+
+  TransformHandle create();
+  void destroy(TransformHandle handle);
+
+  void updateMatrices();
+
+  // setters
+  void setPosition(TransformHandle handle, const glm::vec3 &position);
+  void setRotation(TransformHandle handle, const glm::vec3 &eulerRotation);
+  void setScale(TransformHandle handle, const glm::vec3 &scale);
+  bool setParent(TransformHandle handle, TransformHandle parent);
+
+  // getters
+  glm::vec3 getPosition(TransformHandle handle) const;
+  glm::vec3 getRotation(TransformHandle handle) const;
+  glm::quat getRotationQuaternion(TransformHandle handle) const;
+  glm::vec3 getScale(TransformHandle handle) const;
+  TransformHandle getParent(TransformHandle handle) const;
+  const std::vector<TransformHandle> &getChildren(TransformHandle handle) const;
+  const glm::mat4 &getModelMatrix(TransformHandle handle);
+  size_t getCount() const;
+  size_t getDepth() const;
+  bool hasWorldChanges() const;
+  bool hasWorldChanged(TransformHandle handle) const;
+
+  // levels at least this wide are propagated on several threads
+  static constexpr size_t PARALLEL_LEVEL_SIZE = 4096;
+
+private:
+  TransformStore() = default;
+  ~TransformStore() = default;
+
+  /// @brief All transforms at one depth of the hierarchy, with their parents alongside for the sweep
+  struct Level
+  {
+    std::vector<TransformHandle> nodes;
+    std::vector<TransformHandle> parents;
+  };
+
+  // hot data, read by the batch update
+  std::vector<float> positionX, positionY, positionZ;
+  std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+  std::vector<float> scaleX, scaleY, scaleZ;
+  std::vector<glm::mat4> localMatrices;
+  std::vector<glm::mat4> worldMatrices;
+  std::vector<uint64_t> dirtyBits;
+  std::vector<uint8_t> worldChanged; // bytes instead of bits, level sweeps write them from several threads
+  std::vector<Level> levels;
+  std::vector<uint8_t> levelDirty;
+  bool pendingChanges = false;
+  bool worldChangesKept = false; // worldChanged still holds the flags of the last update
+
+  // cold data
+  std::vector<glm::vec3> eulerRotations; // as set, for getRotation()
+  std::vector<TransformHandle> parents;
+  std::vector<std::vector<TransformHandle>> children;
+  std::vector<uint32_t> depths, levelPositions;
+  std::vector<TransformHandle> freeSlots;
+  size_t count = 0;
+
+  void reset(TransformHandle handle);
+  void markDirty(TransformHandle handle);
+  void updateMatrix(size_t index);
+  void updateGroup(size_t first);
+  void propagateLevel(const Level &level, size_t begin, size_t end);
+  const glm::mat4 &computeWorldMatrix(TransformHandle handle);
+
+  void addToLevel(TransformHandle handle, uint32_t depth);
+  void removeFromLevel(TransformHandle handle);
+  void moveSubtree(TransformHandle handle, uint32_t depth);
+};
\ No newline at end of file
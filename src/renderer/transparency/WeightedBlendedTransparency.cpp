@@ -0,0 +1,190 @@
+/*
+  File: WeightedBlendedTransparency.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#include "WeightedBlendedTransparency.h"
+
+#include <iostream>
+
+#include "renderer/shader/ShaderProvider.h"
+
+WeightedBlendedTransparency::WeightedBlendedTransparency()
+{
+  glGenVertexArrays(1, &emptyVAO);
+}
+
+WeightedBlendedTransparency::~WeightedBlendedTransparency()
+{
+  releaseTargets();
+  glDeleteVertexArrays(1, &emptyVAO);
+}
+
+/// @brief Bind and clear the accumulation targets and set their blend state. The opaque depth of the default
+/// framebuffer is copied over, so translucent surfaces behind opaque ones are still rejected.
+/// Draw the translucent surfaces with the WeightedBlend permutation of their shader and depth writes off afterwards.
+/// @param viewport the viewport of the frame, the targets follow its size
+/// @return false if the targets can't be used, draw the translucent surfaces sorted instead
+bool WeightedBlendedTransparency::begin(const GLint viewport[4])
+{
+  if (!available)
+    return false;
+
+  if (viewport[2] != width || viewport[3] != height)
+    createTargets(viewport[2], viewport[3]);
+
+  if (!available)
+    return false;
+
+  this->viewport = {viewport[0], viewport[1], viewport[2], viewport[3]};
+
+  // depth blits need matching formats, only known once the default framebuffer was copied from,
+  // errors queued by earlier calls are dropped so they aren't taken for a failed copy
+  if (!depthCopyChecked)
+  {
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+  }
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+  glBlitFramebuffer(viewport[0], viewport[1], viewport[0] + width, viewport[1] + height,
+                    0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+  if (!depthCopyChecked)
+  {
+    depthCopyChecked = true;
+    if (glGetError() != GL_NO_ERROR)
+    {
+      std::cerr << "[WeightedBlendedTransparency] Can't copy the default depth buffer, falling back to sorted blending" << std::endl;
+      glBindFramebuffer(GL_FRAMEBUFFER, 0);
+      available = false;
+      return false;
+    }
+  }
+
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glViewport(0, 0, width, height);
+
+  const GLfloat clearAccumulation[] = {0.0f, 0.0f, 0.0f, 1.0f}; // revealage starts at 1, nothing covers the opaque image yet
+  const GLfloat clearWeight[] = {0.0f, 0.0f, 0.0f, 0.0f};
+  glClearBufferfv(GL_COLOR, 0, clearAccumulation);
+  glClearBufferfv(GL_COLOR, 1, clearWeight);
+
+  // rgb: sum of colors, alpha: product of (1 - alpha), the weight target sums through its red channel
+  glEnable(GL_BLEND);
+  glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+  glDepthMask(GL_FALSE);
+
+  return true;
+}
+
+/// @brief Blend the averaged translucent color over the opaque image in the default framebuffer
+void WeightedBlendedTransparency::composite()
+{
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+  auto &shaderProvider = ShaderProvider::getInstance();
+  Shader &shader = shaderProvider.resolve(shaderProvider.getShader(ShaderType::TransparencyComposite));
+  shader.setInt("accumulation", ACCUMULATION_TEXTURE_UNIT);
+  shader.setInt("weights", WEIGHT_TEXTURE_UNIT);
+  glUniform2i(glGetUniformLocation(shader.ID, "viewportOrigin"), viewport[0], viewport[1]);
+
+  glActiveTexture(GL_TEXTURE0 + ACCUMULATION_TEXTURE_UNIT);
+  glBindTexture(GL_TEXTURE_2D, accumulationTexture);
+  glActiveTexture(GL_TEXTURE0 + WEIGHT_TEXTURE_UNIT);
+  glBindTexture(GL_TEXTURE_2D, weightTexture);
+
+  // the fullscreen triangle is counter-clockwise, blocks are wound clockwise and the pass culls back faces
+  GLboolean culling = glIsEnabled(GL_CULL_FACE);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  glDisable(GL_DEPTH_TEST);
+  glDisable(GL_CULL_FACE);
+
+  glBindVertexArray(emptyVAO);
+  glDrawArrays(GL_TRIANGLES, 0, 3);
+  glBindVertexArray(0);
+
+  glEnable(GL_DEPTH_TEST);
+  if (culling)
+    glEnable(GL_CULL_FACE);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glActiveTexture(GL_TEXTURE0 + ACCUMULATION_TEXTURE_UNIT);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// getters
+bool WeightedBlendedTransparency::isAvailable() const
+{
+  return available;
+}
+
+// ------- private ------- //
+
+void WeightedBlendedTransparency::createTargets(int width, int height)
+{
+  releaseTargets();
+
+  this->width = width;
+  this->height = height;
+
+  auto createTexture = [&](GLint internalFormat, GLenum format)
+  {
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_HALF_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return texture;
+  };
+
+  accumulationTexture = createTexture(GL_RGBA16F, GL_RGBA);
+  weightTexture = createTexture(GL_R16F, GL_RED);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  // the window requests a 24 bit depth, 8 bit stencil buffer, blits only work between matching formats
+  glGenRenderbuffers(1, &depthBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glGenFramebuffers(1, &framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, accumulationTexture, 0);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, weightTexture, 0);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+  const GLenum drawBuffers[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+  glDrawBuffers(2, drawBuffers);
+
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+  {
+    std::cerr << "[WeightedBlendedTransparency] Accumulation framebuffer is incomplete, falling back to sorted blending" << std::endl;
+    available = false;
+  }
+
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  std::cout << "[WeightedBlendedTransparency] Created " << width << "x" << height << " accumulation targets" << std::endl;
+}
+
+void WeightedBlendedTransparency::releaseTargets()
+{
+  if (framebuffer)
+    glDeleteFramebuffers(1, &framebuffer);
+  if (accumulationTexture)
+    glDeleteTextures(1, &accumulationTexture);
+  if (weightTexture)
+    glDeleteTextures(1, &weightTexture);
+  if (depthBuffer)
+    glDeleteRenderbuffers(1, &depthBuffer);
+
+  framebuffer = accumulationTexture = weightTexture = depthBuffer = 0;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+/*
+  File: WeightedBlendedTransparency.h
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+#pragma once
+
+#include <array>
+#include <glad/glad.h>
+
+/// @brief How the translucent pass blends overlapping surfaces
+enum class TransparencyMode
+{
+  Sorted,          // back to front sorted alpha blending, exact between separate meshes
+  WeightedBlended, // order independent, unsorted and batched, approximate where many layers overlap
+  Compare,         // sorted on the left half of the screen, weighted blended on the right half
+};
+
+/// @brief Weighted blended order independent transparency (McGuire and Bavoil, 2013).
+/// Translucent surfaces are drawn in any order into an accumulation target, a depth weighted sum of their colors,
+/// and a revealage, the product of their transparencies. One fullscreen pass then composites the weighted average
+/// color over the opaque image. Nothing has to be sorted and intersecting meshes don't pop, at the cost of colors
+/// being an approximation where many similar layers overlap.
+///
+/// Stays within GL 3.3, which has no per target blend functions: the accumulation target sums the color in rgb and
+/// multiplies the revealage in alpha with one separate blend function, the weight target sums the weighted alphas.
+class WeightedBlendedTransparency
+{
+public:
+  WeightedBlendedTransparency();
+  ~WeightedBlendedTransparency();
+
+  WeightedBlendedTransparency(const WeightedBlendedTransparency &) = delete;
+  WeightedBlendedTransparency &operator=(const WeightedBlendedTransparency &) = delete;
+
+  bool begin(const GLint viewport[4]);
+  void composite();
+
+  // getters
+  bool isAvailable() const;
+
+  // texture units of the composite pass, it doesn't bind any material
+  static constexpr unsigned int ACCUMULATION_TEXTURE_UNIT = 0;
+  static constexpr unsigned int WEIGHT_TEXTURE_UNIT = 1;
+
+private:
+  unsigned int framebuffer = 0;
+  unsigned int accumulationTexture = 0; // RGBA16F
+  unsigned int weightTexture = 0;       // R16F
+  unsigned int depthBuffer = 0;         // copy of the opaque depth, same format as the default framebuffer's
+  unsigned int emptyVAO = 0;            // the composite triangle has no vertex buffer, core profiles still need a VAO
+
+  int width = 0, height = 0;
+  std::array<GLint, 4> viewport{}; // of the frame, restored by composite()
+  bool available = true;
+  bool depthCopyChecked = false;
+
+  void createTargets(int width, int height);
+  void releaseTargets();
+};
\ No newline at end of file
@@ -12,8 +12,6 @@ GLWindow::~GLWindow()
 GLFWwindow *GLWindow::create(const char *title, unsigned int width, unsigned int height)
 {
   glfwInit();
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
   glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
   // for macos only, we need to set GLFW_OPENGL_FORWARD_COMPAT
@@ -21,7 +19,25 @@ GLFWwindow *GLWindow::create(const char *title, unsigned int width, unsigned int
   glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
-  window = glfwCreateWindow(width, height, title, NULL, NULL);
+  // weighted blended transparency copies this depth buffer, it creates its own with the same format
+  glfwWindowHint(GLFW_DEPTH_BITS, 24);
+  glfwWindowHint(GLFW_STENCIL_BITS, 8);
+
+  // 4.3 enables multi draw indirect and storage buffers, everything else runs on 3.3
+  const int versions[][2] = {{4, 3}, {3, 3}};
+  for (const auto &version : versions)
+  {
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version[0]);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version[1]);
+
+    window = glfwCreateWindow(width, height, title, NULL, NULL);
+    if (window != NULL)
+    {
+      std::cout << "Created OpenGL " << version[0] << "." << version[1] << " core context" << std::endl;
+      break;
+    }
+  }
+
   if (window == NULL)
   {
     std::cout << "Failed to create GLFW window" << std::endl;
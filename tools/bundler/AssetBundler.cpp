@@ -0,0 +1,501 @@
+/*
+  File: AssetBundler.cpp
+  Author: Daniel H. Rauhut (0ti)
+  GitHub: https://github.com/0tii
+  Created: 10/19/2026
+*/
+
+// Offline tool baking the block table, texture animations, the block texture arrays (decoded and mipmapped) and all shader sources
+// into a single bundle the renderer maps at startup. Run it from the build directory like the renderer itself:
+//   X0VBundler [--uncompressed] [--min-psnr <dB>] [output path, defaults to ../assets/x0v.bundle]
+//   X0VBundler --selftest
+// Texture sets are block compressed (diffuse BC7, specular BC4, emissive BC1). A set whose encoding loses too much
+// on any layer (PSNR below --min-psnr, default 30 dB) is stored as RGBA8 instead. --selftest round-trips synthetic
+// images and the block textures through the CPU encoder and decoder and fails on quality regressions, no GPU needed.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "renderer/asset/BundleFormat.h"
+#include "renderer/asset/AssetBundle.h"
+#include "renderer/block/BlockDefinitions.h"
+#include "renderer/texture/TextureCompressor.h"
+#include "renderer/texture/TextureDecoder.h"
+
+namespace
+{
+  using Bytes = std::vector<unsigned char>;
+
+  struct PendingSection
+  {
+    BundleFormat::SectionType type;
+    Bytes data;
+  };
+
+  struct Options
+  {
+    std::filesystem::path output = AssetBundle::DEFAULT_PATH;
+    bool compress = true;
+    double minPSNR = 30.0;
+    bool selfTest = false;
+  };
+
+  /// @brief Encoding each texture kind is compressed to
+  TextureEncoding getEncoding(BundleFormat::TextureKind kind)
+  {
+    switch (kind)
+    {
+    case BundleFormat::Diffuse:
+      return TextureEncoding::BC7;
+    case BundleFormat::Specular:
+      return TextureEncoding::BC4;
+    case BundleFormat::Emissive:
+      return TextureEncoding::BC1;
+    }
+    return TextureEncoding::RGBA8;
+  }
+
+  /// @brief Encode every layer of a level, the layers stay back to back
+  Bytes encodeLevel(TextureEncoding encoding, const Bytes &level, int size, int layerCount)
+  {
+    Bytes result;
+    size_t layerBytes = static_cast<size_t>(size) * size * 4;
+
+    for (int layer = 0; layer < layerCount; ++layer)
+    {
+      auto encoded = TextureCompressor::encode(encoding, level.data() + layer * layerBytes, size, size);
+      result.insert(result.end(), encoded.begin(), encoded.end());
+    }
+
+    return result;
+  }
+
+  /// @brief Lowest PSNR over the layers of a level after an encode/decode round trip
+  double getWorstPSNR(TextureEncoding encoding, const Bytes &level, const Bytes &encoded, int size, int layerCount)
+  {
+    double worst = std::numeric_limits<double>::infinity();
+    size_t layerBytes = static_cast<size_t>(size) * size * 4;
+    size_t encodedLayerBytes = TextureCompressor::getEncodedSize(encoding, size, size);
+
+    for (int layer = 0; layer < layerCount; ++layer)
+    {
+      auto decoded = TextureCompressor::decode(encoding, encoded.data() + layer * encodedLayerBytes, size, size);
+      worst = std::min(worst, TextureCompressor::computePSNR(level.data() + layer * layerBytes, decoded.data(), size, size,
+                                                             TextureCompressor::getComparedChannels(encoding)));
+    }
+
+    return worst;
+  }
+
+  template <typename T>
+  void write(Bytes &out, const T &value)
+  {
+    const auto *bytes = reinterpret_cast<const unsigned char *>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+  }
+
+  void writeString(Bytes &out, const std::string &value)
+  {
+    write(out, static_cast<uint32_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+  }
+
+  void align(Bytes &out)
+  {
+    out.resize((out.size() + BundleFormat::SECTION_ALIGNMENT - 1) / BundleFormat::SECTION_ALIGNMENT * BundleFormat::SECTION_ALIGNMENT, 0);
+  }
+
+  /// @brief 2x2 box filter of every layer of a level, the CPU equivalent of glGenerateMipmap on an array
+  Bytes downsample(const Bytes &level, int size, int layerCount)
+  {
+    int half = std::max(1, size / 2);
+    Bytes result(static_cast<size_t>(half) * half * 4 * layerCount);
+
+    for (int layer = 0; layer < layerCount; ++layer)
+    {
+      const unsigned char *source = level.data() + static_cast<size_t>(layer) * size * size * 4;
+      unsigned char *target = result.data() + static_cast<size_t>(layer) * half * half * 4;
+
+      for (int y = 0; y < half; ++y)
+        for (int x = 0; x < half; ++x)
+          for (int channel = 0; channel < 4; ++channel)
+          {
+            int x0 = std::min(x * 2, size - 1), x1 = std::min(x * 2 + 1, size - 1);
+            int y0 = std::min(y * 2, size - 1), y1 = std::min(y * 2 + 1, size - 1);
+
+            int sum = source[(y0 * size + x0) * 4 + channel] + source[(y0 * size + x1) * 4 + channel] +
+                      source[(y1 * size + x0) * 4 + channel] + source[(y1 * size + x1) * 4 + channel];
+            target[(y * half + x) * 4 + channel] = static_cast<unsigned char>((sum + 2) / 4);
+          }
+    }
+
+    return result;
+  }
+
+  Bytes buildBlockTable()
+  {
+    Bytes out;
+    auto blocks = BlockDefinitions::getBlocks();
+
+    write(out, static_cast<uint32_t>(blocks.size()));
+    for (const auto &[blockId, blockType] : blocks)
+    {
+      writeString(out, blockId);
+      for (const auto *face : {&blockType.top, &blockType.bottom, &blockType.north, &blockType.east, &blockType.south, &blockType.west})
+        writeString(out, *face);
+      write(out, static_cast<uint32_t>(blockType.shaderType));
+      write(out, static_cast<uint32_t>(blockType.emit ? 1 : 0));
+      write(out, static_cast<uint32_t>(blockType.renderLayer));
+    }
+
+    return out;
+  }
+
+  Bytes buildLayerTable()
+  {
+    Bytes out;
+
+    write(out, static_cast<uint32_t>(BlockDefinitions::TEXTURE_NAMES.size()));
+    for (const auto &name : BlockDefinitions::TEXTURE_NAMES)
+      writeString(out, name);
+
+    return out;
+  }
+
+  Bytes buildAnimationTable()
+  {
+    Bytes out;
+
+    write(out, static_cast<uint32_t>(BlockDefinitions::ANIMATIONS.size()));
+    for (const auto &[textureName, animation] : BlockDefinitions::ANIMATIONS)
+    {
+      writeString(out, textureName);
+      write(out, animation.frameTime);
+      write(out, static_cast<uint32_t>(animation.frames.size()));
+      for (const auto &frame : animation.frames)
+        writeString(out, frame);
+    }
+
+    return out;
+  }
+
+  Bytes buildTextureSet(BundleFormat::TextureKind kind, const std::unordered_map<std::string, std::string> &texturePaths, TextureDecoder &decoder,
+                        const Options &options, bool &complete)
+  {
+    const auto &names = BlockDefinitions::TEXTURE_NAMES;
+    const int size = BlockDefinitions::TEXTURE_SIZE;
+    const int layerCount = static_cast<int>(names.size());
+    const int mipLevels = static_cast<int>(std::log2(size)) + 1;
+
+    std::vector<std::string> paths;
+    for (const auto &name : names)
+    {
+      auto path = texturePaths.find(name);
+      paths.push_back(path != texturePaths.end() ? path->second : std::string());
+    }
+
+    auto images = decoder.decode(paths);
+
+    // base level, missing or mismatching images stay cleared like in the loose-file path
+    size_t layerBytes = static_cast<size_t>(size) * size * 4;
+    std::vector<Bytes> levels(1, Bytes(layerBytes * layerCount, 0));
+
+    for (int layer = 0; layer < layerCount; ++layer)
+    {
+      const auto &image = images[layer];
+      if (!image || !image->isValid() || image->width != size || image->height != size)
+      {
+        std::cerr << "[AssetBundler] Unable to use " << paths[layer] << " for layer " << names[layer] << std::endl;
+        complete = false;
+        continue;
+      }
+      std::copy(image->pixels.begin(), image->pixels.end(), levels[0].begin() + layer * layerBytes);
+    }
+
+    for (int level = 1; level < mipLevels; ++level)
+      levels.push_back(downsample(levels[level - 1], std::max(1, size >> (level - 1)), layerCount));
+
+    // mips are filtered from the uncompressed levels, then every level is encoded on its own
+    TextureEncoding encoding = options.compress ? getEncoding(kind) : TextureEncoding::RGBA8;
+    if (encoding != TextureEncoding::RGBA8)
+    {
+      std::vector<Bytes> encodedLevels;
+      for (int level = 0; level < mipLevels; ++level)
+        encodedLevels.push_back(encodeLevel(encoding, levels[level], std::max(1, size >> level), layerCount));
+
+      double psnr = getWorstPSNR(encoding, levels[0], encodedLevels[0], size, layerCount);
+      if (psnr < options.minPSNR)
+      {
+        std::cout << "[AssetBundler] texture set " << kind << " keeps RGBA8, encoding " << static_cast<int>(encoding) << " reaches only "
+                  << psnr << " dB" << std::endl;
+        encoding = TextureEncoding::RGBA8;
+      }
+      else
+      {
+        std::cout << "[AssetBundler] texture set " << kind << " encoded as " << static_cast<int>(encoding) << ", worst layer " << psnr << " dB" << std::endl;
+        levels = std::move(encodedLevels);
+      }
+    }
+
+    Bytes out;
+    write(out, BundleFormat::TextureSetHeader{kind, static_cast<uint32_t>(size), static_cast<uint32_t>(layerCount), static_cast<uint32_t>(mipLevels),
+                                              static_cast<uint32_t>(encoding)});
+
+    // level table first, then the data, each level aligned for the upload
+    uint64_t offset = out.size() + mipLevels * 2 * sizeof(uint64_t);
+    for (const auto &level : levels)
+    {
+      offset = (offset + BundleFormat::SECTION_ALIGNMENT - 1) / BundleFormat::SECTION_ALIGNMENT * BundleFormat::SECTION_ALIGNMENT;
+      write(out, offset);
+      write(out, static_cast<uint64_t>(level.size()));
+      offset += level.size();
+    }
+
+    for (const auto &level : levels)
+    {
+      align(out);
+      out.insert(out.end(), level.begin(), level.end());
+    }
+
+    return out;
+  }
+
+  Bytes buildShaderTable(const std::filesystem::path &shaderDirectory)
+  {
+    struct ShaderFile
+    {
+      std::string key;
+      std::string source;
+    };
+    std::vector<ShaderFile> files;
+
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(shaderDirectory))
+    {
+      auto extension = entry.path().extension().string();
+      if (!entry.is_regular_file() || (extension != ".vert" && extension != ".frag" && extension != ".glsl"))
+        continue;
+
+      std::ifstream file(entry.path(), std::ios::binary);
+      std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+      // same key the preprocessor looks sources up with
+      files.push_back({entry.path().lexically_normal().generic_string(), std::move(source)});
+    }
+
+    // stable output for identical inputs
+    std::sort(files.begin(), files.end(), [](const ShaderFile &a, const ShaderFile &b)
+              { return a.key < b.key; });
+
+    Bytes table;
+    write(table, static_cast<uint32_t>(files.size()));
+
+    size_t tableSize = sizeof(uint32_t);
+    for (const auto &file : files)
+      tableSize += sizeof(uint32_t) + file.key.size() + 3 * sizeof(uint64_t);
+
+    uint64_t offset = tableSize;
+    for (const auto &file : files)
+    {
+      writeString(table, file.key);
+      write(table, BundleFormat::hash(file.source.data(), file.source.size()));
+      write(table, offset);
+      write(table, static_cast<uint64_t>(file.source.size()));
+      offset += file.source.size();
+    }
+
+    for (const auto &file : files)
+      table.insert(table.end(), file.source.begin(), file.source.end());
+
+    std::cout << "[AssetBundler] bundled " << files.size() << " shader sources" << std::endl;
+    return table;
+  }
+
+  /// @brief Round trip one image through an encoding, checking sizes and quality
+  bool checkRoundTrip(const char *name, TextureEncoding encoding, const Bytes &pixels, int width, int height, double minPSNR)
+  {
+    auto encoded = TextureCompressor::encode(encoding, pixels.data(), width, height);
+    if (encoded.size() != TextureCompressor::getEncodedSize(encoding, width, height))
+    {
+      std::cerr << "[AssetBundler] " << name << ": encoded size " << encoded.size() << " does not match the expected size" << std::endl;
+      return false;
+    }
+
+    auto decoded = TextureCompressor::decode(encoding, encoded.data(), width, height);
+    if (decoded.size() != pixels.size())
+    {
+      std::cerr << "[AssetBundler] " << name << ": decoded size " << decoded.size() << " does not match the source" << std::endl;
+      return false;
+    }
+
+    double psnr = TextureCompressor::computePSNR(pixels.data(), decoded.data(), width, height, TextureCompressor::getComparedChannels(encoding));
+    bool passed = psnr >= minPSNR;
+    (passed ? std::cout : std::cerr) << "[AssetBundler] " << name << " encoding " << static_cast<int>(encoding) << ": " << psnr << " dB"
+                                     << (passed ? "" : ", below the minimum") << std::endl;
+    return passed;
+  }
+
+  /// @brief CPU round trip of synthetic images and the block textures through every encoding
+  int runSelfTest()
+  {
+    bool passed = true;
+    const TextureEncoding encodings[] = {TextureEncoding::BC1, TextureEncoding::BC4, TextureEncoding::BC7};
+
+    // smooth gradients, including sizes that are not multiples of the block size
+    for (auto [width, height] : {std::pair{16, 16}, std::pair{13, 7}, std::pair{1, 1}, std::pair{64, 32}})
+    {
+      Bytes gradient(static_cast<size_t>(width) * height * 4);
+      for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+        {
+          unsigned char value = static_cast<unsigned char>(255 * (x + y) / std::max(1, width + height - 2));
+          unsigned char *pixel = &gradient[(static_cast<size_t>(y) * width + x) * 4];
+          pixel[0] = pixel[1] = pixel[2] = value;
+          pixel[3] = 255;
+        }
+
+      for (auto encoding : encodings)
+        passed &= checkRoundTrip("gradient", encoding, gradient, width, height, 30.0);
+    }
+
+    // solid colours must survive almost exactly
+    for (unsigned int color : {0xff0000ffu, 0x00ff00ffu, 0x3a7bd5ffu, 0x808080ffu})
+    {
+      Bytes solid(8 * 8 * 4);
+      for (size_t i = 0; i < solid.size(); i += 4)
+        for (int channel = 0; channel < 4; ++channel)
+          solid[i + channel] = static_cast<unsigned char>(color >> (24 - channel * 8));
+
+      passed &= checkRoundTrip("solid", TextureEncoding::BC1, solid, 8, 8, 35.0);
+      passed &= checkRoundTrip("solid", TextureEncoding::BC7, solid, 8, 8, 40.0);
+    }
+
+    // the real textures, report only, the bundler decides per set whether an encoding is good enough
+    TextureDecoder decoder;
+    std::vector<std::string> paths;
+    for (const auto &name : BlockDefinitions::TEXTURE_NAMES)
+      paths.push_back(BlockDefinitions::DIFFUSE_PATHS.at(name));
+
+    auto images = decoder.decode(paths);
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+      if (!images[i] || !images[i]->isValid())
+        continue;
+
+      for (auto encoding : encodings)
+      {
+        auto encoded = TextureCompressor::encode(encoding, images[i]->pixels.data(), images[i]->width, images[i]->height);
+        auto decoded = TextureCompressor::decode(encoding, encoded.data(), images[i]->width, images[i]->height);
+        std::cout << "[AssetBundler] " << BlockDefinitions::TEXTURE_NAMES[i] << " encoding " << static_cast<int>(encoding) << ": "
+                  << TextureCompressor::computePSNR(images[i]->pixels.data(), decoded.data(), images[i]->width, images[i]->height,
+                                                    TextureCompressor::getComparedChannels(encoding))
+                  << " dB" << std::endl;
+      }
+    }
+
+    std::cout << "[AssetBundler] self test " << (passed ? "passed" : "failed") << std::endl;
+    return passed ? 0 : 1;
+  }
+
+  bool parseOptions(int argc, char **argv, Options &options)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      std::string argument = argv[i];
+      if (argument == "--uncompressed")
+        options.compress = false;
+      else if (argument == "--selftest")
+        options.selfTest = true;
+      else if (argument == "--min-psnr" && i + 1 < argc)
+        options.minPSNR = std::atof(argv[++i]);
+      else if (argument.rfind("--", 0) == 0)
+      {
+        std::cerr << "[AssetBundler] Unknown option " << argument << std::endl;
+        return false;
+      }
+      else
+        options.output = argument;
+    }
+    return true;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  Options options;
+  if (!parseOptions(argc, argv, options))
+    return 1;
+
+  if (options.selfTest)
+    return runSelfTest();
+
+  const auto &output = options.output;
+
+  TextureDecoder decoder; // shared, the specular and emissive sets mostly reference the same files
+  bool complete = true;
+
+  std::vector<PendingSection> sections;
+  sections.push_back({BundleFormat::BlockTable, buildBlockTable()});
+  sections.push_back({BundleFormat::LayerTable, buildLayerTable()});
+  sections.push_back({BundleFormat::AnimationTable, buildAnimationTable()});
+  sections.push_back({BundleFormat::TextureSet, buildTextureSet(BundleFormat::Diffuse, BlockDefinitions::DIFFUSE_PATHS, decoder, options, complete)});
+  sections.push_back({BundleFormat::TextureSet, buildTextureSet(BundleFormat::Specular, BlockDefinitions::SPECULAR_PATHS, decoder, options, complete)});
+  sections.push_back({BundleFormat::TextureSet, buildTextureSet(BundleFormat::Emissive, BlockDefinitions::EMISSIVE_PATHS, decoder, options, complete)});
+  sections.push_back({BundleFormat::ShaderTable, buildShaderTable("../assets/shaders")});
+
+  if (!complete)
+  {
+    std::cerr << "[AssetBundler] Not writing a bundle with missing textures" << std::endl;
+    return 1;
+  }
+
+  Bytes bundle;
+  write(bundle, BundleFormat::Header{BundleFormat::MAGIC, BundleFormat::VERSION, static_cast<uint32_t>(sections.size()), 0});
+
+  // section table, offsets are known once the table size is
+  uint64_t offset = bundle.size() + sections.size() * sizeof(BundleFormat::Section);
+  for (const auto &section : sections)
+  {
+    offset = (offset + BundleFormat::SECTION_ALIGNMENT - 1) / BundleFormat::SECTION_ALIGNMENT * BundleFormat::SECTION_ALIGNMENT;
+    write(bundle, BundleFormat::Section{section.type, 0, offset, static_cast<uint64_t>(section.data.size())});
+    offset += section.data.size();
+  }
+
+  for (const auto &section : sections)
+  {
+    align(bundle);
+    bundle.insert(bundle.end(), section.data.begin(), section.data.end());
+  }
+
+  // write next to the target and swap, so a running renderer never maps a half written bundle
+  auto temporaryPath = output;
+  temporaryPath += ".tmp";
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(bundle.data()), bundle.size());
+    if (!file)
+    {
+      std::cerr << "[AssetBundler] Failed writing " << temporaryPath << std::endl;
+      return 1;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporaryPath, output, error);
+  if (error)
+  {
+    std::cerr << "[AssetBundler] Failed replacing " << output << ": " << error.message() << std::endl;
+    return 1;
+  }
+
+  std::cout << "[AssetBundler] wrote " << output << " (" << bundle.size() / 1024 << " KiB)" << std::endl;
+  return 0;
+}
\ No newline at end of file